@@ -0,0 +1,188 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Alert sound worker and its per-priority queues (see ADAS_Audio.h).
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Audio.c
+*/
+#include "ADAS_Audio.h"
+
+#include <string.h>
+
+#define QUEUE_MASK (ADAS_AUDIO_QUEUE - 1)
+
+// ---------------- PATTERNS ----------------
+// the bursts BeepThreadProc used to play, indexed by priority - 1
+static const AdasBeepPattern patterns[ADAS_PRIO_HIGH] = {
+    // Low: single low beep
+    { 1, { { 700, 200 } } },
+    // Medium: two medium beeps
+    { 3, { { 900, 200 }, { 0, 150 }, { 900, 200 } } },
+    // High: three short high beeps
+    { 5, { { 1200, 150 }, { 0, 100 }, { 1200, 150 }, { 0, 100 }, { 1200, 150 } } },
+};
+
+const AdasBeepPattern* AdasBeepPatternFor(int priority) {
+    if (priority < ADAS_PRIO_LOW) return NULL;
+    if (priority > ADAS_PRIO_HIGH) priority = ADAS_PRIO_HIGH;
+    return &patterns[priority - 1];
+}
+
+int AdasBeepPatternMs(const AdasBeepPattern* p) {
+    int ms = 0;
+    for (int i = 0; p && i < p->count; ++i) ms += p->steps[i].ms;
+    return ms;
+}
+
+// ---------------- QUEUES ----------------
+// bounded MPSC ring: a producer claims a cell by advancing tail, then publishes it through seq
+void AdasAudioQueueInit(AdasAudioQueue* q) {
+    q->head = 0;
+    q->tail = 0;
+    for (uint32_t i = 0; i < ADAS_AUDIO_QUEUE; ++i) q->cells[i].seq = i;
+}
+
+bool AdasAudioQueuePush(AdasAudioQueue* q, uint64_t enqueuedNs) {
+    uint32_t pos = AdasAtomicLoad32(&q->tail);
+    for (;;) {
+        AdasAudioCell* cell = &q->cells[pos & QUEUE_MASK];
+        int32_t diff = (int32_t)(AdasAtomicLoad32(&cell->seq) - pos);
+        if (diff == 0) {
+            if (AdasAtomicCas32(&q->tail, pos, pos + 1)) {
+                cell->enqueuedNs = enqueuedNs;
+                AdasAtomicStore32(&cell->seq, pos + 1);
+                return true;
+            }
+            pos = AdasAtomicLoad32(&q->tail);
+        } else if (diff < 0) {
+            return false;   // full: the worker has not freed this cell yet
+        } else {
+            pos = AdasAtomicLoad32(&q->tail);
+        }
+    }
+}
+
+// worker only
+static bool QueueReady(AdasAudioQueue* q) {
+    uint32_t pos = q->head;
+    return AdasAtomicLoad32(&q->cells[pos & QUEUE_MASK].seq) == pos + 1;
+}
+
+bool AdasAudioQueuePop(AdasAudioQueue* q, uint64_t* enqueuedNs) {
+    uint32_t pos = q->head;
+    AdasAudioCell* cell = &q->cells[pos & QUEUE_MASK];
+    if (AdasAtomicLoad32(&cell->seq) != pos + 1) return false;
+    *enqueuedNs = cell->enqueuedNs;
+    AdasAtomicStore32(&cell->seq, pos + ADAS_AUDIO_QUEUE);
+    AdasAtomicStore32(&q->head, pos + 1);
+    return true;
+}
+
+// ---------------- WORKER ----------------
+static bool HigherQueued(AdasAudio* a, int priority) {
+    for (int p = ADAS_PRIO_HIGH; p > priority; --p)
+        if (QueueReady(&a->queues[p - 1])) return true;
+    return false;
+}
+
+static bool Interrupted(AdasAudio* a, int priority) {
+    return AdasAtomicLoad32(&a->stop) || HigherQueued(a, priority);
+}
+
+// waits out a gap, returning early when a higher priority arrives
+static void WaitGap(AdasAudio* a, int priority, int ms) {
+    uint64_t end = AdasNowNs() + (uint64_t)ms * 1000000ull;
+    for (;;) {
+        uint64_t now = AdasNowNs();
+        if (now >= end || Interrupted(a, priority)) return;
+        AdasEventWait(&a->wake, (unsigned)((end - now + 999999) / 1000000));
+    }
+}
+
+static void PlayPattern(AdasAudio* a, int priority, uint64_t enqueuedNs) {
+    const AdasBeepPattern* p = AdasBeepPatternFor(priority);
+    bool first = true;
+    a->stats.played++;
+    for (int i = 0; i < p->count; ++i) {
+        if (Interrupted(a, priority)) {
+            if (!AdasAtomicLoad32(&a->stop)) a->stats.preempted++;
+            return;
+        }
+        const AdasBeepStep* s = &p->steps[i];
+        if (!s->freq) {
+            WaitGap(a, priority, a->sink.speedup > 1 ? s->ms / (int)a->sink.speedup : s->ms);
+            continue;
+        }
+        if (first) {
+            uint64_t latency = AdasNowNs() - enqueuedNs;
+            a->stats.latencyCount++;
+            a->stats.latencyTotalNs += latency;
+            if (latency > a->stats.latencyMaxNs) a->stats.latencyMaxNs = latency;
+            first = false;
+        }
+        a->sink.tone(a->sink.ctx, s->freq, s->ms);
+    }
+    if (a->sink.done) a->sink.done(a->sink.ctx, priority);
+    a->stats.completed++;
+}
+
+static void AudioWorker(void* arg) {
+    AdasAudio* a = (AdasAudio*)arg;
+    while (!AdasAtomicLoad32(&a->stop)) {
+        int priority = ADAS_PRIO_NONE;
+        for (int p = ADAS_PRIO_HIGH; p >= ADAS_PRIO_LOW && !priority; --p)
+            if (QueueReady(&a->queues[p - 1])) priority = p;
+        if (!priority) {
+            // a push after the scan leaves the event set, so this cannot miss it
+            AdasEventWait(&a->wake, ADAS_WAIT_FOREVER);
+            continue;
+        }
+        // busy before the pop, so AdasAudioIdle never sees an empty queue and nothing playing
+        AdasAtomicStore32(&a->playing, (uint32_t)priority);
+        uint64_t enqueuedNs;
+        if (AdasAudioQueuePop(&a->queues[priority - 1], &enqueuedNs)) PlayPattern(a, priority, enqueuedNs);
+        AdasAtomicStore32(&a->playing, 0);
+    }
+}
+
+// ---------------- API ----------------
+int AdasAudioStart(AdasAudio* a, const AdasAudioSink* sink) {
+    memset(a, 0, sizeof(*a));
+    a->sink = *sink;
+    for (int p = 0; p < ADAS_PRIO_HIGH; ++p) AdasAudioQueueInit(&a->queues[p]);
+    if (AdasEventInit(&a->wake) != 0) return -1;
+    if (AdasThreadStart(&a->thread, AudioWorker, a) != 0) {
+        AdasEventFree(&a->wake);
+        return -1;
+    }
+    a->stats.threadsStarted = 1;
+    return 0;
+}
+
+void AdasAudioStop(AdasAudio* a) {
+    if (!a->thread.handle) return;
+    AdasAtomicStore32(&a->stop, 1);
+    AdasEventSignal(&a->wake);
+    AdasThreadJoin(&a->thread);
+    AdasEventFree(&a->wake);
+}
+
+bool AdasAudioEnqueue(AdasAudio* a, int priority) {
+    if (priority < ADAS_PRIO_LOW) return false;
+    if (priority > ADAS_PRIO_HIGH) priority = ADAS_PRIO_HIGH;
+    if (!AdasAudioQueuePush(&a->queues[priority - 1], AdasNowNs())) {
+        AdasAtomicAdd64(&a->stats.dropped, 1);
+        return false;
+    }
+    AdasAtomicAdd64(&a->stats.enqueued, 1);
+    AdasEventSignal(&a->wake);
+    return true;
+}
+
+bool AdasAudioIdle(AdasAudio* a) {
+    // queues first: the worker sets playing before it pops
+    for (int p = 0; p < ADAS_PRIO_HIGH; ++p) {
+        AdasAudioQueue* q = &a->queues[p];
+        if (AdasAtomicLoad32(&q->head) != AdasAtomicLoad32(&q->tail)) return false;
+    }
+    return !AdasAtomicLoad32(&a->playing);
+}
@@ -0,0 +1,98 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Alert sound worker: one long-lived thread plays the beep pattern of each alert.
+   - AdasAudioEnqueue never blocks: one bounded lock-free queue per priority (a full queue drops
+     the alert and counts it), so the UI thread only pays for a few atomics per alert.
+   - The worker always plays the highest queued priority. A newer alert of a higher priority
+     pre-empts the pattern that is playing at the next step: gaps are waited on the worker's
+     event, so a pre-empting alert starts within one tone (150-200 ms), not after the burst.
+   - Measures enqueue-to-first-tone latency.
+   - Sound output goes through a sink (Beep/MessageBeep in the window when it has no sound device
+     for the mixer, a recorder in the CLI).
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Audio.h
+*/
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ADAS_Platform.h"
+#include "ADAS_Rules.h"
+
+#define ADAS_AUDIO_QUEUE 8          // alerts per priority (power of two)
+#define ADAS_AUDIO_MAX_STEPS 5
+
+// one step of a pattern: a tone, or a gap when freq is 0
+typedef struct AdasBeepStep {
+    uint16_t freq;  // Hz
+    uint16_t ms;
+} AdasBeepStep;
+
+typedef struct AdasBeepPattern {
+    int count;
+    AdasBeepStep steps[ADAS_AUDIO_MAX_STEPS];
+} AdasBeepPattern;
+
+// where the worker sends sound; both calls run on the worker thread
+typedef struct AdasAudioSink {
+    void (*tone)(void* ctx, int freq, int ms);  // blocks for the tone
+    void (*done)(void* ctx, int priority);      // pattern finished (system alert sound fallback)
+    void* ctx;
+    uint32_t speedup;                           // gaps last ms / speedup (0 or 1 = real time; benches)
+} AdasAudioSink;
+
+// bounded multi-producer queue cell: seq tells producers and the worker whose turn it is
+typedef struct AdasAudioCell {
+    volatile uint32_t seq;
+    uint64_t enqueuedNs;
+} AdasAudioCell;
+
+typedef struct AdasAudioQueue {
+    volatile uint32_t head;         // next cell to pop (worker only)
+    volatile uint32_t tail;         // next cell to fill (producers)
+    AdasAudioCell cells[ADAS_AUDIO_QUEUE];
+} AdasAudioQueue;
+
+typedef struct AdasAudioStats {
+    uint64_t enqueued;
+    uint64_t dropped;               // queue full
+    uint64_t played;                // patterns started
+    uint64_t completed;
+    uint64_t preempted;             // cut short by a higher priority
+    uint64_t latencyCount;
+    uint64_t latencyTotalNs;        // enqueue to first tone
+    uint64_t latencyMaxNs;
+    uint32_t threadsStarted;        // 1 for the life of the worker
+} AdasAudioStats;
+
+typedef struct AdasAudio {
+    AdasAudioSink sink;
+    AdasAudioQueue queues[ADAS_PRIO_HIGH];  // index = priority - 1
+    AdasEvent wake;
+    AdasThread thread;
+    volatile uint32_t stop;
+    volatile uint32_t playing;      // priority of the pattern in progress, 0 when idle
+    AdasAudioStats stats;           // written by the worker (enqueued/dropped: atomically by producers)
+} AdasAudio;
+
+// ---------------- FUNCTION DECLARATIONS ----------------
+const AdasBeepPattern* AdasBeepPatternFor(int priority);
+// total pattern length (ms)
+int AdasBeepPatternMs(const AdasBeepPattern* p);
+
+// one alert queue on its own, for a consumer other than the worker (the window's mixer feeder)
+void AdasAudioQueueInit(AdasAudioQueue* q);
+// any thread, never blocks; false when full
+bool AdasAudioQueuePush(AdasAudioQueue* q, uint64_t enqueuedNs);
+// the single consumer only; false when empty
+bool AdasAudioQueuePop(AdasAudioQueue* q, uint64_t* enqueuedNs);
+
+// starts the worker; returns 0 on success
+int AdasAudioStart(AdasAudio* a, const AdasAudioSink* sink);
+// drops queued alerts, lets the current step finish and joins the worker
+void AdasAudioStop(AdasAudio* a);
+// queues one alert of ADAS_PRIO_LOW..HIGH from any thread; false when dropped
+bool AdasAudioEnqueue(AdasAudio* a, int priority);
+// true when nothing is queued or playing
+bool AdasAudioIdle(AdasAudio* a);
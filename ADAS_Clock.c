@@ -0,0 +1,41 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Fixed-tick simulation clock (see ADAS_Clock.h).
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Clock.c
+*/
+
+#include "ADAS_Clock.h"
+
+#include <string.h>
+
+#define TICK_NS ((uint64_t)ADAS_TICK_MS * 1000000u)
+
+// ---------------- CLOCK ----------------
+void AdasClockInit(AdasClock* c) {
+    memset(c, 0, sizeof(*c));
+}
+
+void AdasClockStep(AdasClock* c) {
+    c->tick++;
+}
+
+uint32_t AdasClockDue(AdasClock* c, uint64_t nowNs) {
+    if (!c->synced) {
+        c->lastNs = nowNs;
+        c->synced = true;
+        return 0;
+    }
+    c->backlogNs += nowNs - c->lastNs;
+    c->lastNs = nowNs;
+
+    uint64_t due = c->backlogNs / TICK_NS;
+    c->backlogNs -= due * TICK_NS;
+    if (due > ADAS_CLOCK_MAX_CATCHUP) due = ADAS_CLOCK_MAX_CATCHUP;
+    c->tick += due;
+    return (uint32_t)due;
+}
+
+uint64_t AdasClockMs(const AdasClock* c) {
+    return c->tick * ADAS_TICK_MS;
+}
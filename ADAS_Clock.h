@@ -0,0 +1,40 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Deterministic simulation clock with a fixed tick.
+   - Every timed behaviour (door-block warning, lane message, beep spacing, indicator blink) counts
+     simulation ticks, never wall-clock time, so a run replays identically.
+   - The UI turns elapsed real time into whole ticks with AdasClockDue; headless tools just step
+     as fast as the CPU allows.
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Clock.h
+*/
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// one simulation step (ms)
+#define ADAS_TICK_MS 10
+
+// durations in whole ticks, rounded up so nothing expires early
+#define ADAS_MS_TO_TICKS(ms) (((ms) + ADAS_TICK_MS - 1) / ADAS_TICK_MS)
+
+// most ticks AdasClockDue hands out at once, so a stalled UI (window drag, debugger) catches up
+// by at most this much instead of replaying the whole stall
+#define ADAS_CLOCK_MAX_CATCHUP 50
+
+typedef struct AdasClock {
+    uint64_t tick;          // ticks stepped since AdasClockInit
+    uint64_t lastNs;        // real time of the last AdasClockDue (AdasNowNs)
+    uint64_t backlogNs;     // real time not yet turned into ticks
+    bool synced;            // lastNs is valid
+} AdasClock;
+
+// ---------------- FUNCTION DECLARATIONS ----------------
+void AdasClockInit(AdasClock* c);
+// advances the clock by one tick (headless runs)
+void AdasClockStep(AdasClock* c);
+// real-time pacing: returns the whole ticks that elapsed since the last call (capped) and
+// advances the clock by that many; the caller steps the simulation the same number of times
+uint32_t AdasClockDue(AdasClock* c, uint64_t nowNs);
+uint64_t AdasClockMs(const AdasClock* c);
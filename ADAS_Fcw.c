@@ -0,0 +1,335 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Column-oriented FCW kernels (scalar / SSE2 / AVX2) with runtime dispatch.
+   Every path evaluates StoppingDistance_m with the same double operations in the same order,
+   then scales to centimetres, adds the margin, clamps to MAX_COLLISION_THRESHOLD_CM and rounds up,
+   so all paths agree bit for bit. That needs the scalar formula compiled without FMA
+   contraction: the build passes -ffp-contract=off (MSVC: /fp:precise) and this file, ADAS_Ttc.c
+   and ADAS_Rules.c also turn it off in source.
+   Also holds the per-speed threshold tables used by the rule engine hot path.
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Fcw.c
+*/
+
+// no FMA contraction (see above); GCC only honours -ffp-contract=off
+#if defined(_MSC_VER) && !defined(__clang__)
+#pragma fp_contract(off)
+#elif defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#endif
+
+#include "ADAS_Fcw.h"
+#include "ADAS_Platform.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define ADAS_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// gcc/clang only emit AVX2 code for functions that ask for it
+#if defined(ADAS_X86) && (defined(__GNUC__) || defined(__clang__))
+#define ADAS_TARGET_SSE2 __attribute__((target("sse2")))
+#define ADAS_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define ADAS_TARGET_SSE2
+#define ADAS_TARGET_AVX2
+#endif
+
+// same constants and operation order as StoppingDistance_m
+#define KMH_TO_MS_MUL 1000.0
+#define KMH_TO_MS_DIV 3600.0
+#define BRAKE_DENOM   (2.0 * ADAS_FRICTION_MU * ADAS_GRAVITY)
+#define CM_PER_M      ((double)ADAS_CM_PER_M)
+#define MARGIN_CM     ((double)ADAS_FCW_MARGIN_CM)
+#define CAP_CM        ((double)MAX_COLLISION_THRESHOLD_CM)
+
+typedef void (*FcwKernelFn)(const int32_t*, const int32_t*, size_t, int32_t*, uint8_t*);
+
+// ---------------- SCALAR ----------------
+static void FcwScalar(const int32_t* speed, const int32_t* frontDistCm, size_t count,
+    int32_t* threshold, uint8_t* collision) {
+    for (size_t i = 0; i < count; i++) {
+        int32_t t = AdasFcwThresholdCm(speed[i]);
+        threshold[i] = t;
+        collision[i] = frontDistCm[i] < t;
+    }
+}
+
+#ifdef ADAS_X86
+// ---------------- SSE2 ----------------
+// x = capped threshold in cm for two speeds; returns ceil(x) in the two low int32 lanes
+ADAS_TARGET_SSE2
+static __m128i CeilThresholdSse2(__m128i speedLo) {
+    __m128d v = _mm_div_pd(_mm_mul_pd(_mm_cvtepi32_pd(speedLo), _mm_set1_pd(KMH_TO_MS_MUL)),
+        _mm_set1_pd(KMH_TO_MS_DIV));
+    __m128d reaction = _mm_mul_pd(v, _mm_set1_pd(ADAS_REACTION_TIME_S));
+    __m128d braking = _mm_div_pd(_mm_mul_pd(v, v), _mm_set1_pd(BRAKE_DENOM));
+    __m128d m = _mm_add_pd(_mm_add_pd(reaction, braking), _mm_set1_pd(VEHICLE_LENGTH_M));
+    __m128d x = _mm_min_pd(_mm_add_pd(_mm_mul_pd(m, _mm_set1_pd(CM_PER_M)), _mm_set1_pd(MARGIN_CM)),
+        _mm_set1_pd(CAP_CM));
+    // SSE2 has no ceil: truncate, then add one where truncation fell below x
+    __m128i t = _mm_cvttpd_epi32(x);
+    __m128d below = _mm_cmplt_pd(_mm_cvtepi32_pd(t), x);
+    __m128i belowLanes = _mm_shuffle_epi32(_mm_castpd_si128(below), _MM_SHUFFLE(3, 1, 2, 0));
+    return _mm_sub_epi32(t, belowLanes);
+}
+
+ADAS_TARGET_SSE2
+static void FcwSse2(const int32_t* speed, const int32_t* frontDistCm, size_t count,
+    int32_t* threshold, uint8_t* collision) {
+    const __m128i one = _mm_set1_epi8(1);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i s = _mm_loadu_si128((const __m128i*)(speed + i));
+        __m128i lo = CeilThresholdSse2(s);
+        __m128i hi = CeilThresholdSse2(_mm_srli_si128(s, 8));
+        __m128i t = _mm_unpacklo_epi64(lo, hi);
+        _mm_storeu_si128((__m128i*)(threshold + i), t);
+
+        __m128i hit = _mm_cmplt_epi32(_mm_loadu_si128((const __m128i*)(frontDistCm + i)), t);
+        __m128i bytes = _mm_and_si128(_mm_packs_epi16(_mm_packs_epi32(hit, hit), hit), one);
+        int32_t packed = _mm_cvtsi128_si32(bytes);
+        collision[i + 0] = (uint8_t)(packed);
+        collision[i + 1] = (uint8_t)(packed >> 8);
+        collision[i + 2] = (uint8_t)(packed >> 16);
+        collision[i + 3] = (uint8_t)(packed >> 24);
+    }
+    FcwScalar(speed + i, frontDistCm + i, count - i, threshold + i, collision + i);
+}
+
+// ---------------- AVX2 ----------------
+ADAS_TARGET_AVX2
+static __m128i CeilThresholdAvx(__m128i speed4) {
+    __m256d v = _mm256_div_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(speed4), _mm256_set1_pd(KMH_TO_MS_MUL)),
+        _mm256_set1_pd(KMH_TO_MS_DIV));
+    __m256d reaction = _mm256_mul_pd(v, _mm256_set1_pd(ADAS_REACTION_TIME_S));
+    __m256d braking = _mm256_div_pd(_mm256_mul_pd(v, v), _mm256_set1_pd(BRAKE_DENOM));
+    __m256d m = _mm256_add_pd(_mm256_add_pd(reaction, braking), _mm256_set1_pd(VEHICLE_LENGTH_M));
+    __m256d x = _mm256_min_pd(_mm256_add_pd(_mm256_mul_pd(m, _mm256_set1_pd(CM_PER_M)), _mm256_set1_pd(MARGIN_CM)),
+        _mm256_set1_pd(CAP_CM));
+    return _mm256_cvttpd_epi32(_mm256_round_pd(x, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC));
+}
+
+ADAS_TARGET_AVX2
+static void FcwAvx2(const int32_t* speed, const int32_t* frontDistCm, size_t count,
+    int32_t* threshold, uint8_t* collision) {
+    const __m128i one = _mm_set1_epi8(1);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i lo = CeilThresholdAvx(_mm_loadu_si128((const __m128i*)(speed + i)));
+        __m128i hi = CeilThresholdAvx(_mm_loadu_si128((const __m128i*)(speed + i + 4)));
+        __m256i t = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        _mm256_storeu_si256((__m256i*)(threshold + i), t);
+
+        __m256i hit = _mm256_cmpgt_epi32(t, _mm256_loadu_si256((const __m256i*)(frontDistCm + i)));
+        __m128i words = _mm_packs_epi32(_mm256_castsi256_si128(hit), _mm256_extracti128_si256(hit, 1));
+        __m128i bytes = _mm_and_si128(_mm_packs_epi16(words, words), one);
+        _mm_storel_epi64((__m128i*)(collision + i), bytes);
+    }
+    FcwScalar(speed + i, frontDistCm + i, count - i, threshold + i, collision + i);
+}
+#endif
+
+// ---------------- DISPATCH ----------------
+// the level and its kernel are published together as one pointer, so a reader never pairs
+// a new kernel with an old level
+typedef struct FcwDispatch {
+    AdasSimdLevel level;
+    FcwKernelFn fn;
+} FcwDispatch;
+
+static const FcwDispatch fcwDispatch[] = {
+    { ADAS_SIMD_SCALAR, FcwScalar },
+#ifdef ADAS_X86
+    { ADAS_SIMD_SSE2, FcwSse2 },
+    { ADAS_SIMD_AVX2, FcwAvx2 },
+#endif
+};
+
+static volatile uint32_t detectState;
+static AdasSimdLevel detectedLevel;
+static void* volatile activeDispatch;
+
+AdasSimdLevel AdasFcwDetectSimd(void) {
+    if (!AdasOnceBegin(&detectState)) return detectedLevel;
+    AdasSimdLevel level = ADAS_SIMD_SCALAR;
+#if defined(ADAS_X86) && defined(_MSC_VER)
+    int regs[4];
+    __cpuid(regs, 1);
+    if (regs[3] & (1 << 26)) level = ADAS_SIMD_SSE2;
+    // AVX2 needs the CPU bit plus OS support for saving YMM state
+    int osxsave = (regs[2] & (1 << 27)) != 0;
+    int avx = (regs[2] & (1 << 28)) != 0;
+    if (osxsave && avx && (_xgetbv(0) & 6) == 6) {
+        __cpuidex(regs, 7, 0);
+        if (regs[1] & (1 << 5)) level = ADAS_SIMD_AVX2;
+    }
+#elif defined(ADAS_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2")) level = ADAS_SIMD_SSE2;
+    if (__builtin_cpu_supports("avx2")) level = ADAS_SIMD_AVX2;
+#endif
+    detectedLevel = level;
+    AdasOnceDone(&detectState);
+    return level;
+}
+
+AdasSimdLevel AdasFcwSetSimd(AdasSimdLevel level) {
+    AdasSimdLevel best = AdasFcwDetectSimd();
+    if (level > best) level = best;
+    const FcwDispatch* d = &fcwDispatch[level];
+    AdasAtomicStorePtr(&activeDispatch, (void*)d);
+    return level;
+}
+
+static const FcwDispatch* FcwActive(void) {
+    const FcwDispatch* d = (const FcwDispatch*)AdasAtomicLoadPtr(&activeDispatch);
+    if (d) return d;
+    // first use: publish the best kernel unless another thread has already chosen one
+    d = &fcwDispatch[AdasFcwDetectSimd()];
+    if (!AdasAtomicCasPtr(&activeDispatch, NULL, (void*)d))
+        d = (const FcwDispatch*)AdasAtomicLoadPtr(&activeDispatch);
+    return d;
+}
+
+AdasSimdLevel AdasFcwGetSimd(void) {
+    return FcwActive()->level;
+}
+
+const char* AdasSimdName(AdasSimdLevel level) {
+    switch (level) {
+    case ADAS_SIMD_SSE2: return "sse2";
+    case ADAS_SIMD_AVX2: return "avx2";
+    default: return "scalar";
+    }
+}
+
+void AdasFcwColumns(const int32_t* speed, const int32_t* frontDistCm, size_t count,
+    int32_t* threshold, uint8_t* collision) {
+    FcwActive()->fn(speed, frontDistCm, count, threshold, collision);
+}
+
+// ---------------- THRESHOLD TABLES ----------------
+// AdasFcwThresholdCm(speed) for speed = 0..180 with reaction 1.8 s, mu 0.7.
+// Generated by ./adas_headless gen-fcw-table; AdasFcwTableVerify catches a stale table.
+const int32_t adasFcwThresholdTable[ADAS_SPEED_MAX + 1] = {
+    /*   0 */ 550, 601, 653, 706, 759, 815, 871, 928, 986, 1046,
+    /*  10 */ 1107, 1168, 1231, 1295, 1361, 1427, 1494, 1563, 1633, 1703,
+    /*  20 */ 1775, 1848, 1922, 1998, 2074, 2152, 2230, 2310, 2391, 2473,
+    /*  30 */ 2556, 2640, 2726, 2812, 2900, 2989, 3079, 3170, 3262, 3355,
+    /*  40 */ 3449, 3545, 3642, 3739, 3838, 3938, 4039, 4142, 4245, 4349,
+    /*  50 */ 4455, 4562, 4670, 4779, 4889, 5000, 5112, 5226, 5340, 5456,
+    /*  60 */ 5573, 5691, 5810, 5930, 6052, 6174, 6298, 6423, 6548, 6675,
+    /*  70 */ 6803, 6933, 7063, 7194, 7327, 7461, 7596, 7732, 7869, 8007,
+    /*  80 */ 8146, 8287, 8428, 8571, 8715, 8860, 9006, 9153, 9301, 9451,
+    /*  90 */ 9601, 9753, 9906, 10060, 10215, 10371, 10528, 10687, 10846, 11007,
+    /* 100 */ 11169, 11332, 11496, 11661, 11827, 11995, 12163, 12333, 12504, 12675,
+    /* 110 */ 12849, 13023, 13198, 13374, 13552, 13731, 13910, 14091, 14273, 14456,
+    /* 120 */ 14641, 14826, 15013, 15200, 15389, 15579, 15770, 15962, 16155, 16350,
+    /* 130 */ 16545, 16742, 16940, 17139, 17339, 17540, 17742, 17945, 18150, 18355,
+    /* 140 */ 18562, 18770, 18979, 19189, 19400, 19613, 19826, 20041, 20257, 20473,
+    /* 150 */ 20691, 20911, 21131, 21352, 21575, 21798, 22023, 22249, 22476, 22704,
+    /* 160 */ 22933, 23163, 23395, 23628, 23861, 24096, 24332, 24569, 24807, 25047,
+    /* 170 */ 25287, 25529, 25771, 26015, 26260, 26506, 26753, 27002, 27251, 27502,
+    /* 180 */ 27753,
+};
+
+void AdasFcwTableBuild(AdasFcwTable* table, double reaction, double mu) {
+    table->reaction = reaction;
+    table->mu = mu;
+    for (int s = 0; s <= ADAS_SPEED_MAX; s++)
+        table->threshold[s] = AdasFcwThresholdParamsCm(s, reaction, mu);
+}
+
+int32_t AdasFcwTableLookup(const AdasFcwTable* table, int speed_kmh) {
+    if ((unsigned)speed_kmh <= ADAS_SPEED_MAX) return table->threshold[speed_kmh];
+    return AdasFcwThresholdParamsCm(speed_kmh, table->reaction, table->mu);
+}
+
+int AdasFcwTableVerify(const int32_t* threshold, double reaction, double mu) {
+    int mismatches = 0;
+    for (int s = 0; s <= ADAS_SPEED_MAX; s++) {
+        if (threshold[s] != AdasFcwThresholdParamsCm(s, reaction, mu)) mismatches++;
+    }
+    return mismatches;
+}
+
+// ---------------- SURFACE PROFILES ----------------
+static const double surfaceMu[ADAS_SURFACE_COUNT] = { ADAS_FRICTION_MU, 0.4, 0.2, 0.1 };
+static const char* const surfaceNames[ADAS_SURFACE_COUNT] = { "DRY", "WET", "SNOW", "ICE" };
+
+// built on first use (AdasOnceBegin)
+static AdasFcwTable profileTables[ADAS_FCW_PROFILE_COUNT];
+static volatile uint32_t profileState[ADAS_FCW_PROFILE_COUNT];
+// every profile's threshold for one speed side by side, so the sweep loads them together
+static int32_t sweepTable[ADAS_SPEED_MAX + 1][ADAS_FCW_PROFILE_COUNT];
+static volatile uint32_t sweepState;
+
+double AdasSurfaceMu(AdasSurface surface) {
+    return (unsigned)surface < ADAS_SURFACE_COUNT ? surfaceMu[surface] : ADAS_FRICTION_MU;
+}
+
+const char* AdasSurfaceName(AdasSurface surface) {
+    return (unsigned)surface < ADAS_SURFACE_COUNT ? surfaceNames[surface] : "?";
+}
+
+const AdasFcwTable* AdasFcwProfileTable(AdasSurface surface, bool night) {
+    if ((unsigned)surface >= ADAS_SURFACE_COUNT) surface = ADAS_SURFACE_DRY;
+    int p = ADAS_FCW_PROFILE(surface, night);
+    if (AdasOnceBegin(&profileState[p])) {
+        double reaction = ADAS_REACTION_TIME_S + (night ? ADAS_NIGHT_REACTION_EXTRA_S : 0.0);
+        AdasFcwTableBuild(&profileTables[p], reaction, surfaceMu[surface]);
+        AdasOnceDone(&profileState[p]);
+    }
+    return &profileTables[p];
+}
+
+static void BuildSweepTable(void) {
+    if (!AdasOnceBegin(&sweepState)) return;
+    for (int p = 0; p < ADAS_FCW_PROFILE_COUNT; ++p) {
+        const AdasFcwTable* t = AdasFcwProfileTable((AdasSurface)(p / 2), (p & 1) != 0);
+        for (int s = 0; s <= ADAS_SPEED_MAX; ++s) sweepTable[s][p] = t->threshold[s];
+    }
+    AdasOnceDone(&sweepState);
+}
+
+static uint8_t SweepScalar(int speed, int frontDistCm) {
+    uint8_t hits = 0;
+    for (int p = 0; p < ADAS_FCW_PROFILE_COUNT; ++p) {
+        int32_t t = (unsigned)speed <= ADAS_SPEED_MAX ? sweepTable[speed][p] : AdasFcwTableLookup(&profileTables[p], speed);
+        hits |= (uint8_t)((frontDistCm < t) << p);
+    }
+    return hits;
+}
+
+#ifdef ADAS_X86
+// the eight (ADAS_FCW_PROFILE_COUNT) thresholds of a speed are two vectors: compare, narrow to bytes, take the sign bits
+ADAS_TARGET_SSE2
+static void SweepSse2(const int32_t* speed, const int32_t* frontDistCm, size_t count, uint8_t* hits) {
+    for (size_t i = 0; i < count; ++i) {
+        if ((unsigned)speed[i] > ADAS_SPEED_MAX) {
+            hits[i] = SweepScalar(speed[i], frontDistCm[i]);
+            continue;
+        }
+        __m128i f = _mm_set1_epi32(frontDistCm[i]);
+        __m128i lo = _mm_cmpgt_epi32(_mm_loadu_si128((const __m128i*)sweepTable[speed[i]]), f);
+        __m128i hi = _mm_cmpgt_epi32(_mm_loadu_si128((const __m128i*)(sweepTable[speed[i]] + 4)), f);
+        __m128i words = _mm_packs_epi32(lo, hi);
+        hits[i] = (uint8_t)_mm_movemask_epi8(_mm_packs_epi16(words, words));
+    }
+}
+#endif
+
+void AdasFcwProfileSweep(const int32_t* speed, const int32_t* frontDistCm, size_t count, uint8_t* hits) {
+    BuildSweepTable();
+#ifdef ADAS_X86
+    if (AdasFcwGetSimd() >= ADAS_SIMD_SSE2) {
+        SweepSse2(speed, frontDistCm, count, hits);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < count; ++i) hits[i] = SweepScalar(speed[i], frontDistCm[i]);
+}
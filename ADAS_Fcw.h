@@ -0,0 +1,81 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Column-oriented Forward Collision Warning kernels.
+   - Computes the adaptive FCW threshold and collision flag for whole arrays of speeds/distances.
+   - SSE2 / AVX2 paths chosen at runtime from the CPU; scalar fallback everywhere else.
+   - Distances and thresholds are int32 centimetres, up to ADAS_DIST_MAX_CM.
+   - Results are bit-identical to AdasFcwThresholdCm (same double math, same ceil rounding).
+   - Threshold tables over the speed slider domain (0..ADAS_SPEED_MAX km/h): one built into
+     the binary for the default model, and runtime-built ones for other reaction/mu sets.
+   - Road surface profiles (dry, wet, snow, ice), each by day and by night (longer reaction):
+     a profile's table is built the first time it is selected and kept, so changing conditions
+     is a pointer swap. A sweep evaluates every profile for whole arrays of states at once.
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Fcw.h
+*/
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ADAS_Rules.h"
+
+typedef enum AdasSimdLevel {
+    ADAS_SIMD_SCALAR = 0,
+    ADAS_SIMD_SSE2,
+    ADAS_SIMD_AVX2
+} AdasSimdLevel;
+
+// threshold per integer speed for one reaction/mu parameter set
+typedef struct AdasFcwTable {
+    double reaction;    // s
+    double mu;          // tyre-road friction
+    int32_t threshold[ADAS_SPEED_MAX + 1];  // cm
+} AdasFcwTable;
+
+// road surface: sets the tyre-road friction of the stopping distance model
+typedef enum AdasSurface {
+    ADAS_SURFACE_DRY = 0,   // ADAS_FRICTION_MU
+    ADAS_SURFACE_WET,
+    ADAS_SURFACE_SNOW,
+    ADAS_SURFACE_ICE,
+    ADAS_SURFACE_COUNT
+} AdasSurface;
+
+#define ADAS_NIGHT_REACTION_EXTRA_S 0.5     // added to ADAS_REACTION_TIME_S at night
+
+// profile index (bit of an AdasFcwProfileSweep result): surface by day, then by night
+#define ADAS_FCW_PROFILE(surface, night) ((int)(surface) * 2 + ((night) ? 1 : 0))
+#define ADAS_FCW_PROFILE_COUNT (ADAS_SURFACE_COUNT * 2)
+
+// read-only table for the default model, printed by adas_headless gen-fcw-table
+extern const int32_t adasFcwThresholdTable[ADAS_SPEED_MAX + 1];
+
+// ---------------- FUNCTION DECLARATIONS ----------------
+AdasSimdLevel AdasFcwDetectSimd(void);
+AdasSimdLevel AdasFcwGetSimd(void);
+// force a level (clamped to what the CPU supports); returns the level in use
+AdasSimdLevel AdasFcwSetSimd(AdasSimdLevel level);
+const char* AdasSimdName(AdasSimdLevel level);
+
+// threshold[i] = capped adaptive threshold (cm) for speed[i] (km/h)
+// collision[i] = 1 when frontDistCm[i] < threshold[i], else 0
+void AdasFcwColumns(const int32_t* speed, const int32_t* frontDistCm, size_t count,
+    int32_t* threshold, uint8_t* collision);
+
+// ---------------- THRESHOLD TABLES ----------------
+void AdasFcwTableBuild(AdasFcwTable* table, double reaction, double mu);
+int32_t AdasFcwTableLookup(const AdasFcwTable* table, int speed_kmh);
+// compares a table with the formula for every slider speed; returns the mismatch count
+int AdasFcwTableVerify(const int32_t* threshold, double reaction, double mu);
+
+// ---------------- SURFACE PROFILES ----------------
+double AdasSurfaceMu(AdasSurface surface);
+// "DRY", "WET", "SNOW", "ICE"
+const char* AdasSurfaceName(AdasSurface surface);
+// table of one profile; built on the first call from any thread, then the same pointer
+const AdasFcwTable* AdasFcwProfileTable(AdasSurface surface, bool night);
+// hits[i] has bit ADAS_FCW_PROFILE(surface, night) set when frontDistCm[i] (cm) is under that profile's
+// threshold for speed[i]
+void AdasFcwProfileSweep(const int32_t* speed, const int32_t* frontDistCm, size_t count, uint8_t* hits);
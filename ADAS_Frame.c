@@ -0,0 +1,81 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Frame scheduler (see ADAS_Frame.h).
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Frame.c
+*/
+
+#include "ADAS_Frame.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ---------------- SCHEDULER ----------------
+void AdasFrameInit(AdasFrameScheduler* s, uint32_t hz) {
+    memset(s, 0, sizeof(*s));
+    AdasFrameSetRate(s, hz);
+}
+
+void AdasFrameSetRate(AdasFrameScheduler* s, uint32_t hz) {
+    if (hz < 1) hz = 1;
+    if (hz > 1000) hz = 1000;
+    s->hz = hz;
+    s->intervalNs = 1000000000ull / hz;
+}
+
+void AdasFrameRequest(AdasFrameScheduler* s, bool input) {
+    s->pending = true;
+    if (input) {
+        s->frameInputs++;
+        s->inputs++;
+    }
+}
+
+bool AdasFrameDue(const AdasFrameScheduler* s, uint64_t nowNs, uint64_t* waitNs) {
+    if (!s->pending) {
+        if (waitNs) *waitNs = UINT64_MAX;
+        return false;
+    }
+    if (!s->haveFrame || nowNs - s->lastFrameNs >= s->intervalNs) {
+        if (waitNs) *waitNs = 0;
+        return true;
+    }
+    if (waitNs) *waitNs = s->intervalNs - (nowNs - s->lastFrameNs);
+    return false;
+}
+
+void AdasFrameDone(AdasFrameScheduler* s, uint64_t startNs, uint64_t endNs) {
+    uint64_t dt = endNs - startNs;
+    s->frameNs[s->frames % ADAS_FRAME_HISTORY] = dt > UINT32_MAX ? UINT32_MAX : (uint32_t)dt;
+    s->frames++;
+    if (s->frameInputs > s->maxInputsPerFrame) s->maxInputsPerFrame = s->frameInputs;
+    s->frameInputs = 0;
+    s->pending = false;
+    // pace from the frame start so frame cost does not stretch the interval
+    s->lastFrameNs = startNs;
+    s->haveFrame = true;
+}
+
+// ---------------- STATISTICS ----------------
+static int CompareU32(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+uint64_t AdasFramePercentile(const AdasFrameScheduler* s, double pct) {
+    size_t n = s->frames < ADAS_FRAME_HISTORY ? (size_t)s->frames : ADAS_FRAME_HISTORY;
+    if (n == 0) return 0;
+    uint32_t sorted[ADAS_FRAME_HISTORY];
+    memcpy(sorted, s->frameNs, n * sizeof(uint32_t));
+    qsort(sorted, n, sizeof(uint32_t), CompareU32);
+    // nearest rank
+    double rank = ceil(pct / 100.0 * (double)n);
+    size_t idx = rank < 1.0 ? 0 : (size_t)rank - 1;
+    if (idx >= n) idx = n - 1;
+    return sorted[idx];
+}
+
+double AdasFrameInputsPerFrame(const AdasFrameScheduler* s) {
+    return s->frames ? (double)s->inputs / (double)s->frames : 0.0;
+}
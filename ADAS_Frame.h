@@ -0,0 +1,49 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Frame scheduler: inputs mark the MID dirty, frames are produced at most once per
+   refresh interval (30/60/120 Hz).
+   - An input after a quiet period gets a frame immediately; inputs inside the interval are
+     coalesced into one trailing frame.
+   - Records input events per frame and frame times (percentiles over the recent frames).
+   - No Win32 dependency: time comes from the caller (AdasNowNs in the UI, simulated in the bench).
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Frame.h
+*/
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ADAS_FRAME_HZ_DEFAULT 60
+#define ADAS_FRAME_HISTORY 512      // frame times kept for percentiles
+
+typedef struct AdasFrameScheduler {
+    uint32_t hz;
+    uint64_t intervalNs;
+    uint64_t lastFrameNs;
+    bool haveFrame;                 // lastFrameNs is valid
+    bool pending;                   // dirty since the last frame
+    uint32_t frameInputs;           // inputs coalesced into the pending frame
+
+    // statistics
+    uint64_t frames;
+    uint64_t inputs;
+    uint32_t maxInputsPerFrame;
+    uint32_t frameNs[ADAS_FRAME_HISTORY];   // ring of recent frame times
+} AdasFrameScheduler;
+
+// ---------------- FUNCTION DECLARATIONS ----------------
+void AdasFrameInit(AdasFrameScheduler* s, uint32_t hz);
+// 30, 60 or 120 (other values are clamped to 1..1000)
+void AdasFrameSetRate(AdasFrameScheduler* s, uint32_t hz);
+
+// state changed; input = true for user events (counted per frame), false for timer-driven changes
+void AdasFrameRequest(AdasFrameScheduler* s, bool input);
+// true when a frame should be produced now; otherwise *waitNs (optional) is the time until it is due
+bool AdasFrameDue(const AdasFrameScheduler* s, uint64_t nowNs, uint64_t* waitNs);
+// a frame ran from startNs to endNs: clears the dirty state and records its cost
+void AdasFrameDone(AdasFrameScheduler* s, uint64_t startNs, uint64_t endNs);
+
+// frame-time percentile (0..100) over the recent frames, in ns
+uint64_t AdasFramePercentile(const AdasFrameScheduler* s, double pct);
+double AdasFrameInputsPerFrame(const AdasFrameScheduler* s);
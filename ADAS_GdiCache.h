@@ -0,0 +1,58 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Persistent GDI resources for the MID paint path (Win32 only).
+   - Fonts and brushes are created on first use and kept until DPI or theme changes.
+   - Counts GDI object creations per frame, so steady-state painting can be checked to allocate nothing.
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_GdiCache.h
+*/
+#pragma once
+
+#ifdef _WIN32
+
+#include <windows.h>
+#include <stdint.h>
+
+#include "ADAS_Mid.h"
+
+// MID colours (ADAS_MID_RGB_*) as COLORREF
+#define ADAS_COLORREF(rgb)  RGB(((rgb) >> 16) & 0xFF, ((rgb) >> 8) & 0xFF, (rgb) & 0xFF)
+#define ADAS_COLOR_MID_BG   ADAS_COLORREF(ADAS_MID_RGB_BG)
+#define ADAS_COLOR_HEADER   ADAS_COLORREF(ADAS_MID_RGB_HEADER)
+#define ADAS_COLOR_WARNING  ADAS_COLORREF(ADAS_MID_RGB_WARNING)
+
+typedef enum AdasGdiFontId {
+    ADAS_FONT_MID = 0,      // Consolas 20 bold
+    ADAS_FONT_COUNT
+} AdasGdiFontId;
+
+typedef enum AdasGdiBrushId {
+    ADAS_BRUSH_MID_BG = 0,
+    ADAS_BRUSH_COUNT
+} AdasGdiBrushId;
+
+typedef struct AdasGdiCache {
+    HFONT fonts[ADAS_FONT_COUNT];
+    HBRUSH brushes[ADAS_BRUSH_COUNT];
+    int dpi;                    // fonts are scaled from 96 dpi sizes
+    uint32_t generation;        // bumped on every invalidation; dependent caches compare it
+
+    // GDI objects created in the current frame, and totals
+    uint32_t frameCreations;
+    uint64_t totalCreations;
+    uint64_t frames;
+    uint64_t framesWithCreations;
+} AdasGdiCache;
+
+// ---------------- FUNCTION DECLARATIONS ----------------
+void AdasGdiCacheInit(AdasGdiCache* c, int dpi);
+// drops every object; they are recreated lazily (WM_DPICHANGED, WM_THEMECHANGED, WM_SYSCOLORCHANGE)
+void AdasGdiCacheInvalidate(AdasGdiCache* c, int dpi);
+void AdasGdiCacheRelease(AdasGdiCache* c);
+
+void AdasGdiBeginFrame(AdasGdiCache* c);
+void AdasGdiEndFrame(AdasGdiCache* c);
+HFONT AdasGdiFont(AdasGdiCache* c, AdasGdiFontId id);
+HBRUSH AdasGdiBrush(AdasGdiCache* c, AdasGdiBrushId id);
+
+#endif
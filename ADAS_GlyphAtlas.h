@@ -0,0 +1,56 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Glyph atlas for MID text (Win32 only).
+   - Every MID character (printable ASCII and the warning sign) is drawn once per colour with
+     the MID font into a 32-bit DIB, one layout cell (charWidth x lineHeight) per glyph. The
+     warning sign comes from a fallback font and is usually wider: its cell is its measured
+     advance, so it is not clipped.
+   - Rows are then drawn by copying cells into the MID back buffer, each glyph after the
+     previous one's cell (as ExtTextOut advances), with no shaping, measuring or GDI calls per frame.
+   - Rebuilt only when the font or cell size changes (AdasGdiCache generation).
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_GlyphAtlas.h
+*/
+#pragma once
+
+#ifdef _WIN32
+
+#include <windows.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ADAS_Mid.h"
+
+#define ADAS_ATLAS_FIRST 0x20
+#define ADAS_ATLAS_LAST 0x7E
+#define ADAS_ATLAS_WARNING_SIGN 0x26A0   // the only non-ASCII character on the MID
+#define ADAS_ATLAS_GLYPHS (ADAS_ATLAS_LAST - ADAS_ATLAS_FIRST + 2)
+
+typedef struct AdasGlyphAtlas {
+    HDC dc;
+    HBITMAP bitmap;
+    HGDIOBJ oldBitmap;
+    uint32_t* bits;             // top-down 0x00RRGGBB; glyph g, colour c at (g * cellW, c * cellH)
+    int width;                  // pixels per atlas row
+    int cellW, cellH;
+    int signW;                  // the warning sign's cell (last in the row): its advance, at least cellW
+    uint32_t generation;        // AdasGdiCache generation of the font it was drawn with
+    bool valid;
+
+    uint64_t builds;
+    uint64_t glyphs;            // glyphs copied
+    uint64_t fallbackRows;      // rows with a character outside the atlas (drawn by GDI instead)
+} AdasGlyphAtlas;
+
+// ---------------- FUNCTION DECLARATIONS ----------------
+// (re)draws the atlas with font; ref is any DC on the target display
+bool AdasGlyphAtlasBuild(AdasGlyphAtlas* a, HDC ref, HFONT font, int cellW, int cellH, uint32_t generation);
+void AdasGlyphAtlasRelease(AdasGlyphAtlas* a);
+bool AdasGlyphAtlasCovers(const wchar_t* text, int len);
+// copies the glyphs of text in colour into a top-down 32-bit buffer (pitch in pixels) with the
+// first cell at (x, y); spaces are skipped (the background is already there) and pixels outside
+// clip are left alone
+void AdasGlyphAtlasDraw(AdasGlyphAtlas* a, uint32_t* dst, int pitch, int x, int y,
+    const wchar_t* text, int len, AdasMidColor color, AdasMidRect clip);
+
+#endif
@@ -0,0 +1,2353 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Headless command-line driver for the ADAS engine (no window, builds on Linux).
+   Commands:
+   - bench [states] [rounds] : batch rule evaluation throughput in states per second.
+   - bench-fcw [count] [rounds] : SIMD FCW column kernel vs the scalar StoppingDistance_m loop,
+     and the all-profile sweep vs one table lookup per profile.
+   - bench-ttc [vehicles] [seconds] : TTC model at 1 kHz, structure-of-arrays vs one vehicle at a time.
+   - bench-tpms [vehicles] [seconds] : 4 tyre sensors per vehicle at 10 Hz through the leak detector.
+   - gen-fcw-table [reaction] [mu] : prints the built-in threshold table initializer for ADAS_Fcw.c.
+   - check : self-checks (threshold tables vs the StoppingDistance_m formula, warning text).
+   - soak [vehicles] [threads] [seconds] : many independent vehicles driven in parallel.
+   - bench-incr [frames] : incremental (dirty-flag) vs full rule evaluation during a slider drag.
+   - tui [scenario] [--hz N] [--mono] : the MID in a terminal, driven from the keyboard or a script.
+   - bench-tui [frames] : bytes written per terminal frame vs redrawing every line.
+   - bench-audio [alerts] : persistent audio worker vs a thread per beep burst.
+   - render-audio <out.wav> [ms:priority ...] : PCM alert timeline to a WAV file, with tone timings.
+   --probe before any command prints the per-phase frame timing histograms at exit.
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Headless.c
+   Build (Linux): cc -O2 -ffp-contract=off -pthread -o adas_headless ADAS_*.c -lm
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <signal.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/select.h>
+#endif
+
+#include "ADAS_Platform.h"
+#include "ADAS_Clock.h"
+#include "ADAS_Rules.h"
+#include "ADAS_Fcw.h"
+#include "ADAS_Vehicle.h"
+#include "ADAS_Warnings.h"
+#include "ADAS_Scenario.h"
+#include "ADAS_Mid.h"
+#include "ADAS_Frame.h"
+#include "ADAS_Render.h"
+#include "ADAS_Raster.h"
+#include "ADAS_Tui.h"
+#include "ADAS_Audio.h"
+#include "ADAS_Synth.h"
+#include "ADAS_Limiter.h"
+#include "ADAS_Probe.h"
+#include "ADAS_Ttc.h"
+#include "ADAS_Tpms.h"
+
+#define NowSeconds AdasNowSeconds
+
+// MID geometry of the window (midRect in FOP_Mini_Prj_ADAS.c) and Consolas 20 bold metrics
+#define MID_W 580
+#define MID_H 620
+#define MID_LINE_H 20
+#define MID_CHAR_W 11
+#define WINDOW_W 1150
+#define WINDOW_H 760
+#define MID_X 560
+#define MID_Y 60
+
+// ---------------- RANDOM STATES ----------------
+// deterministic xorshift so every run benchmarks the same data
+static uint32_t rngState = 0x2545F491u;
+
+static uint32_t XorShift(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static uint32_t NextRandom(void) {
+    return XorShift(&rngState);
+}
+
+// random state inside the UI slider ranges
+static void RandomInputs(AdasInputs* in) {
+    in->speed = (int)(NextRandom() % 181);
+    in->frontDistCm = (int32_t)(NextRandom() % (ADAS_DIST_MAX_CM + 1));
+    in->basePressure = 20 + (int)(NextRandom() % 21);
+    for (int i = 0; i < 4; ++i) {
+        in->tp[i] = 20 + (int)(NextRandom() % 21);
+        in->doorOpen[i] = (NextRandom() & 7) == 0;
+    }
+    uint32_t bits = NextRandom();
+    in->headlights = (bits & 1) != 0;
+    in->nightMode = (bits & 2) != 0;
+    in->handsOn = (bits & 12) != 0;
+    in->leftInd = (bits & 16) != 0;
+    in->rightInd = !in->leftInd && (bits & 32) != 0;
+    in->doorObstacle = (bits & 64) != 0;
+    in->laneChangeReq = (bits & 128) != 0;
+    in->doorBlockActive = (bits & 0x300) == 0;
+    in->fcwTtc = false;
+    in->ttcWarning = false;
+    in->tyreLeak = (bits & 0xC000) == 0 ? (uint8_t)((bits >> 10) & 15) : 0;
+}
+
+// ---------------- BENCH ----------------
+static int CmdBench(int argc, char** argv) {
+    size_t count = argc > 0 ? (size_t)strtoul(argv[0], NULL, 10) : 1000000;
+    int rounds = argc > 1 ? atoi(argv[1]) : 20;
+    if (count == 0 || rounds <= 0) {
+        fprintf(stderr, "bench: states and rounds must be positive\n");
+        return 1;
+    }
+
+    AdasInputs* states = (AdasInputs*)malloc(count * sizeof(AdasInputs));
+    uint32_t* masks = (uint32_t*)malloc(count * sizeof(uint32_t));
+    uint8_t* priorities = (uint8_t*)malloc(count);
+    if (!states || !masks || !priorities) {
+        fprintf(stderr, "bench: out of memory\n");
+        free(states); free(masks); free(priorities);
+        return 1;
+    }
+    for (size_t i = 0; i < count; ++i) RandomInputs(&states[i]);
+
+    // warm-up pass, then timed rounds
+    AdasEvaluateBatch(states, count, masks, priorities);
+    double t0 = NowSeconds();
+    for (int r = 0; r < rounds; ++r)
+        AdasEvaluateBatch(states, count, masks, priorities);
+    double elapsed = NowSeconds() - t0;
+
+    // checksum keeps the work observable and makes runs comparable
+    uint64_t checksum = 0;
+    size_t warned = 0;
+    for (size_t i = 0; i < count; ++i) {
+        checksum = checksum * 31 + masks[i] * 4 + priorities[i];
+        if (masks[i]) warned++;
+    }
+
+    double total = (double)count * rounds;
+    printf("states: %zu x %d rounds\n", count, rounds);
+    printf("elapsed: %.3f s\n", elapsed);
+    printf("throughput: %.2f M states/s\n", total / elapsed / 1e6);
+    printf("states with warnings: %zu (checksum %016llx)\n", warned, (unsigned long long)checksum);
+
+    free(states); free(masks); free(priorities);
+    return 0;
+}
+
+// ---------------- BENCH FCW ----------------
+static int CmdBenchFcw(int argc, char** argv) {
+    size_t count = argc > 0 ? (size_t)strtoul(argv[0], NULL, 10) : 1 << 20;
+    int rounds = argc > 1 ? atoi(argv[1]) : 50;
+    if (count == 0 || rounds <= 0) {
+        fprintf(stderr, "bench-fcw: count and rounds must be positive\n");
+        return 1;
+    }
+
+    int32_t* speed = (int32_t*)malloc(count * sizeof(int32_t));
+    int32_t* front = (int32_t*)malloc(count * sizeof(int32_t));
+    int32_t* refThreshold = (int32_t*)malloc(count * sizeof(int32_t));
+    uint8_t* refCollision = (uint8_t*)malloc(count);
+    int32_t* threshold = (int32_t*)malloc(count * sizeof(int32_t));
+    uint8_t* collision = (uint8_t*)malloc(count);
+    int rc = 0;
+    if (!speed || !front || !refThreshold || !refCollision || !threshold || !collision) {
+        fprintf(stderr, "bench-fcw: out of memory\n");
+        rc = 1;
+        goto done;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        speed[i] = (int32_t)(NextRandom() % 181);
+        front[i] = (int32_t)(NextRandom() % (ADAS_DIST_MAX_CM + 1));
+    }
+
+    // reference: the DrawMID formula called once per element
+    double t0 = NowSeconds();
+    for (int r = 0; r < rounds; ++r) {
+        for (size_t i = 0; i < count; ++i) {
+            refThreshold[i] = AdasFcwThresholdCm(speed[i]);
+            refCollision[i] = front[i] < refThreshold[i];
+        }
+    }
+    double baseline = NowSeconds() - t0;
+    double total = (double)count * rounds;
+    printf("%-8s %8.2f M/s  (StoppingDistance_m loop)\n", "loop", total / baseline / 1e6);
+
+    AdasSimdLevel best = AdasFcwDetectSimd();
+    for (int level = ADAS_SIMD_SCALAR; level <= (int)best; ++level) {
+        AdasFcwSetSimd((AdasSimdLevel)level);
+        AdasFcwColumns(speed, front, count, threshold, collision);
+        t0 = NowSeconds();
+        for (int r = 0; r < rounds; ++r)
+            AdasFcwColumns(speed, front, count, threshold, collision);
+        double elapsed = NowSeconds() - t0;
+
+        int same = memcmp(threshold, refThreshold, count * sizeof(int32_t)) == 0 &&
+            memcmp(collision, refCollision, count) == 0;
+        printf("%-8s %8.2f M/s  speed-up x%.2f  %s\n", AdasSimdName((AdasSimdLevel)level),
+            total / elapsed / 1e6, baseline / elapsed, same ? "identical" : "MISMATCH");
+        if (!same) rc = 1;
+    }
+    AdasFcwSetSimd(best);
+
+    // every surface/night profile at once: one byte of hits per state
+    uint8_t* hits = (uint8_t*)malloc(count);
+    uint8_t* refHits = (uint8_t*)malloc(count);
+    if (!hits || !refHits) {
+        fprintf(stderr, "bench-fcw: out of memory\n");
+        free(hits); free(refHits);
+        rc = 1;
+        goto done;
+    }
+    const AdasFcwTable* profiles[ADAS_FCW_PROFILE_COUNT];
+    for (int p = 0; p < ADAS_FCW_PROFILE_COUNT; ++p) profiles[p] = AdasFcwProfileTable((AdasSurface)(p / 2), (p & 1) != 0);
+    t0 = NowSeconds();
+    for (int r = 0; r < rounds; ++r) {
+        for (size_t i = 0; i < count; ++i) {
+            uint8_t bits = 0;
+            for (int p = 0; p < ADAS_FCW_PROFILE_COUNT; ++p)
+                bits |= (uint8_t)((front[i] < AdasFcwTableLookup(profiles[p], speed[i])) << p);
+            refHits[i] = bits;
+        }
+    }
+    double lookups = NowSeconds() - t0;
+    AdasFcwProfileSweep(speed, front, count, hits);
+    t0 = NowSeconds();
+    for (int r = 0; r < rounds; ++r) AdasFcwProfileSweep(speed, front, count, hits);
+    double sweep = NowSeconds() - t0;
+    bool sameHits = memcmp(hits, refHits, count) == 0;
+    printf("%-8s %8.2f M/s  (%d profiles per state, one AdasFcwTableLookup each)\n", "lookups", total / lookups / 1e6, ADAS_FCW_PROFILE_COUNT);
+    printf("%-8s %8.2f M/s  speed-up x%.2f  %s\n", "sweep", total / sweep / 1e6, lookups / sweep,
+        sameHits ? "identical" : "MISMATCH");
+    if (!sameHits) rc = 1;
+    free(hits); free(refHits);
+
+done:
+    free(speed); free(front); free(refThreshold); free(refCollision);
+    free(threshold); free(collision);
+    return rc;
+}
+
+// ---------------- GEN FCW TABLE ----------------
+// prints the adasFcwThresholdTable initializer (ADAS_Fcw.c) for a reaction time and friction
+static int CmdGenFcwTable(int argc, char** argv) {
+    double reaction = argc > 0 ? atof(argv[0]) : ADAS_REACTION_TIME_S;
+    double mu = argc > 1 ? atof(argv[1]) : ADAS_FRICTION_MU;
+    if (reaction <= 0 || mu <= 0) {
+        fprintf(stderr, "gen-fcw-table: reaction and mu must be positive\n");
+        return 1;
+    }
+    printf("// AdasFcwThresholdCm(speed) for speed = 0..%d with reaction %g s, mu %g.\n", ADAS_SPEED_MAX, reaction, mu);
+    printf("// Generated by ./adas_headless gen-fcw-table; AdasFcwTableVerify catches a stale table.\n");
+    printf("const int32_t adasFcwThresholdTable[ADAS_SPEED_MAX + 1] = {\n");
+    for (int s = 0; s <= ADAS_SPEED_MAX; ++s) {
+        if (s % 10 == 0) printf("    /* %3d */ ", s);
+        printf("%d,%s", AdasFcwThresholdParamsCm(s, reaction, mu), s % 10 == 9 || s == ADAS_SPEED_MAX ? "\n" : " ");
+    }
+    printf("};\n");
+    return 0;
+}
+
+// ---------------- BENCH TTC ----------------
+// random ego/lead states: 0..180 km/h, braking or accelerating, 0..150 m apart
+static void RandomFollow(AdasFollow* f) {
+    f->egoV = (float)(NextRandom() % 50);
+    f->egoA = (float)(NextRandom() % 7) - 3.0f;
+    f->leadV = (float)(NextRandom() % 50);
+    f->leadA = (float)(NextRandom() % 13) - 9.0f;
+    f->gap = (float)(NextRandom() % 150);
+}
+
+static int CmdBenchTtc(int argc, char** argv) {
+    size_t count = argc > 0 ? (size_t)strtoul(argv[0], NULL, 10) : 4096;
+    int steps = argc > 1 ? (int)(atof(argv[1]) / ADAS_TTC_STEP_S + 0.5) : 1000;
+    if (count == 0 || steps <= 0) {
+        fprintf(stderr, "bench-ttc: vehicles and seconds must be positive\n");
+        return 1;
+    }
+    AdasFollowSoa soa;
+    AdasFollow* one = (AdasFollow*)malloc(count * sizeof(AdasFollow));
+    if (!AdasFollowAlloc(&soa, count) || !one) {
+        fprintf(stderr, "bench-ttc: out of memory\n");
+        AdasFollowFree(&soa);
+        free(one);
+        return 1;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        RandomFollow(&one[i]);
+        soa.egoV[i] = one[i].egoV; soa.egoA[i] = one[i].egoA;
+        soa.leadV[i] = one[i].leadV; soa.leadA[i] = one[i].leadA; soa.gap[i] = one[i].gap;
+    }
+
+    // one vehicle at a time, as AdasVehicleStep does it
+    double t0 = NowSeconds();
+    for (int s = 0; s < steps; ++s)
+        for (size_t i = 0; i < count; ++i) AdasFollowStepOne(&one[i], ADAS_TTC_STEP_S);
+    double single = NowSeconds() - t0;
+    t0 = NowSeconds();
+    for (int s = 0; s < steps; ++s) AdasFollowStep(&soa, ADAS_TTC_STEP_S);
+    double batch = NowSeconds() - t0;
+
+    size_t warned = 0, same = 0;
+    for (size_t i = 0; i < count; ++i) {
+        warned += soa.warn[i];
+        same += one[i].gap == soa.gap[i] && one[i].warn == soa.warn[i];
+    }
+    double total = (double)count * steps;
+    printf("vehicles: %zu x %d steps of %.0f ms (%zu warning at the end)\n", count, steps, ADAS_TTC_STEP_S * 1000.0, warned);
+    printf("%-8s %7.2f ns/vehicle-step  %6.1f us per 1 kHz tick (%5.1f%% of 1 ms)\n", "single",
+        single / total * 1e9, single / steps * 1e6, single / steps / ADAS_TTC_STEP_S * 100.0);
+    printf("%-8s %7.2f ns/vehicle-step  %6.1f us per 1 kHz tick (%5.1f%% of 1 ms)  speed-up x%.2f  %s\n", "soa",
+        batch / total * 1e9, batch / steps * 1e6, batch / steps / ADAS_TTC_STEP_S * 100.0, single / batch,
+        same == count ? "identical" : "MISMATCH");
+    printf("vehicles per core at 1 kHz: %.0f\n", ADAS_TTC_STEP_S / (batch / total));
+    AdasFollowFree(&soa);
+    free(one);
+    return same == count ? 0 : 1;
+}
+
+// ---------------- BENCH TPMS ----------------
+#define TPMS_NOISE_SAMPLES 4096     // power of two
+
+// synthetic fleet: 28..36 PSI, sensor noise 0.05..0.30 PSI, 1 tyre in 100 with a 0.5..3 PSI/min puncture
+typedef struct TpmsFleet {
+    float* base;
+    float* sigma;
+    float* rate;                    // PSI/min
+    float noise[TPMS_NOISE_SAMPLES];
+} TpmsFleet;
+
+// approximately normal, mean 0, std dev 1 (sum of four uniforms)
+static float NoiseSample(void) {
+    float sum = 0.0f;
+    for (int k = 0; k < 4; ++k) sum += (float)(NextRandom() & 0xFFFF) / 65535.0f;
+    return (sum - 2.0f) * 1.7320508f;
+}
+
+// sample s of every sensor
+static void TpmsFleetSample(const TpmsFleet* f, size_t count, int s, float* psi) {
+    float minutes = s * (ADAS_TPMS_SAMPLE_MS / 60000.0f);
+    for (size_t i = 0; i < count; ++i)
+        psi[i] = f->base[i] - f->rate[i] * minutes + f->sigma[i] * f->noise[(i * 131 + (size_t)s * 7919) & (TPMS_NOISE_SAMPLES - 1)];
+}
+
+static int CmdBenchTpms(int argc, char** argv) {
+    size_t vehicles = argc > 0 ? (size_t)strtoul(argv[0], NULL, 10) : 10000;
+    int steps = argc > 1 ? (int)(atof(argv[1]) * 1000.0 / ADAS_TPMS_SAMPLE_MS + 0.5) : 3000;
+    if (vehicles == 0 || steps <= 0) {
+        fprintf(stderr, "bench-tpms: vehicles and seconds must be positive\n");
+        return 1;
+    }
+    size_t count = vehicles * 4;
+    const float dt = ADAS_TPMS_SAMPLE_MS * 0.001f;
+    TpmsFleet fleet;
+    AdasTpmsSoa soa;
+    AdasTpms* one = (AdasTpms*)malloc(count * sizeof(AdasTpms));
+    float* psi = (float*)malloc(count * sizeof(float));
+    int* detectedAt = (int*)malloc(count * sizeof(int));
+    fleet.base = (float*)malloc(count * sizeof(float));
+    fleet.sigma = (float*)malloc(count * sizeof(float));
+    fleet.rate = (float*)malloc(count * sizeof(float));
+    int rc = 0;
+    if (!AdasTpmsAlloc(&soa, count) || !one || !psi || !detectedAt || !fleet.base || !fleet.sigma || !fleet.rate) {
+        fprintf(stderr, "bench-tpms: out of memory\n");
+        rc = 1;
+        goto done;
+    }
+    for (int k = 0; k < TPMS_NOISE_SAMPLES; ++k) fleet.noise[k] = NoiseSample();
+    for (size_t i = 0; i < count; ++i) {
+        fleet.base[i] = 28.0f + (float)(NextRandom() % 81) * 0.1f;
+        fleet.sigma[i] = 0.05f + (float)(NextRandom() % 26) * 0.01f;
+        fleet.rate[i] = NextRandom() % 100 == 0 ? 0.5f + (float)(NextRandom() % 26) * 0.1f : 0.0f;
+        detectedAt[i] = -1;
+    }
+    TpmsFleetSample(&fleet, count, 0, psi);
+    AdasTpmsResetAll(&soa, psi);
+    for (size_t i = 0; i < count; ++i) AdasTpmsReset(&one[i], psi[i]);
+
+    // the sensor streams are generated outside the timed sections
+    double single = 0.0, batch = 0.0;
+    for (int s = 1; s <= steps; ++s) {
+        TpmsFleetSample(&fleet, count, s, psi);
+        double t0 = NowSeconds();
+        for (size_t i = 0; i < count; ++i) AdasTpmsStepOne(&one[i], psi[i], dt);
+        double t1 = NowSeconds();
+        AdasTpmsStep(&soa, psi, dt);
+        double t2 = NowSeconds();
+        single += t1 - t0;
+        batch += t2 - t1;
+        for (size_t i = 0; i < count; ++i)
+            if (soa.leak[i] && detectedAt[i] < 0) detectedAt[i] = s;
+    }
+
+    size_t leaking = 0, found = 0, falseAlarms = 0, same = 0;
+    double delay = 0.0, lost = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        same += one[i].level == soa.level[i] && one[i].trend == soa.trend[i] && one[i].leak == soa.leak[i];
+        if (fleet.rate[i] > 0.0f) {
+            leaking++;
+            if (detectedAt[i] >= 0) {
+                found++;
+                delay += detectedAt[i] * dt;
+                lost += fleet.rate[i] * detectedAt[i] * dt / 60.0;
+            }
+        } else {
+            falseAlarms += detectedAt[i] >= 0;
+        }
+    }
+    double total = (double)count * steps;
+    double periodS = ADAS_TPMS_SAMPLE_MS * 0.001;
+    printf("sensors: %zu (%zu vehicles x 4) x %d samples at %.0f Hz\n", count, vehicles, steps, 1.0 / periodS);
+    printf("%-8s %7.2f ns/sample  %7.1f us per sample period (%6.3f%% of %d ms)\n", "single",
+        single / total * 1e9, single / steps * 1e6, single / steps / periodS * 100.0, ADAS_TPMS_SAMPLE_MS);
+    printf("%-8s %7.2f ns/sample  %7.1f us per sample period (%6.3f%% of %d ms)  %s\n", "soa",
+        batch / total * 1e9, batch / steps * 1e6, batch / steps / periodS * 100.0, ADAS_TPMS_SAMPLE_MS,
+        same == count ? "identical" : "MISMATCH");
+    printf("leaks: %zu/%zu found, mean %.1f s after the puncture with %.2f PSI lost (low rule: 4 PSI); false alarms: %zu\n",
+        found, leaking, found ? delay / found : 0.0, found ? lost / found : 0.0, falseAlarms);
+    printf("vehicles per core at %.0f Hz: %.0f\n", 1.0 / periodS, periodS / (batch / total) / 4.0);
+    rc = same == count ? 0 : 1;
+done:
+    AdasTpmsFree(&soa);
+    free(one); free(psi); free(detectedAt);
+    free(fleet.base); free(fleet.sigma); free(fleet.rate);
+    return rc;
+}
+
+// ---------------- SLIDER DRAG ----------------
+typedef struct DragResult {
+    uint64_t inputs;
+    uint64_t frames;
+} DragResult;
+
+// a slider drag: one WM_HSCROLL per inputUs of simulated time, frames through the scheduler and
+// the 10 ms sim tick flushing trailing frames, as in the window; frame work is real and timed
+static DragResult SimulateDrag(AdasFrameScheduler* fs, double seconds, int inputUs) {
+    AdasVehicle v;
+    AdasVehicleInit(&v);
+    AdasMidLayout mid;
+    AdasMidLayoutInit(&mid, MID_W, MID_H, MID_LINE_H, MID_CHAR_W);
+    AdasMidRect dirty[8];
+    uint64_t end = (uint64_t)(seconds * 1e9);
+    uint64_t tickNs = (uint64_t)ADAS_TICK_MS * 1000000u;
+    uint64_t nextTick = 0;
+    DragResult res = { 0, 0 };
+    int step = 0;
+
+    for (uint64_t now = 0; now <= end; now += (uint64_t)inputUs * 1000u) {
+        // speed sweeps back and forth across the slider
+        int phase = step++ % 360;
+        AdasVehicleSetSpeed(&v, phase <= 180 ? phase : 360 - phase);
+        AdasFrameRequest(fs, true);
+        res.inputs++;
+        bool due = AdasFrameDue(fs, now, NULL);
+        if (!due && now >= nextTick) {
+            nextTick += tickNs;
+            due = AdasFrameDue(fs, now, NULL);
+        }
+        if (!due) continue;
+
+        uint64_t t0 = AdasNowNs();
+        AdasResult r;
+        AdasVehicleEvaluateIncremental(&v, &r);
+        AdasMidLayoutUpdate(&mid, &v, &r, dirty, 8);
+        AdasFrameDone(fs, now, now + (AdasNowNs() - t0));
+        res.frames++;
+    }
+    // the drag stops: the trailing frame comes from the next tick
+    if (fs->pending) {
+        AdasFrameDone(fs, end + tickNs, end + tickNs);
+        res.frames++;
+    }
+    return res;
+}
+
+// ---------------- MID PRESETS ----------------
+// representative warning sets for rendering; false for an unknown name
+static bool MidPreset(AdasVehicle* v, const char* name) {
+    AdasVehicleInit(v);
+    if (strcmp(name, "idle") == 0) return true;
+    if (strcmp(name, "city") == 0) {
+        // night drive without headlights, closing on the car ahead
+        AdasVehicleToggleNightMode(v);
+        AdasVehicleSetSpeed(v, 50);
+        AdasVehicleSetFrontDistCm(v, 1200);
+        return true;
+    }
+    if (strcmp(name, "all") == 0) {
+        // every warning at once: FL opened at rest, FR blocked by the obstacle, then driving off
+        AdasVehicleToggleDoor(v, 0);
+        AdasVehicleToggleDoorObstacle(v);
+        AdasVehicleToggleDoor(v, 1);
+        AdasVehicleToggleNightMode(v);
+        AdasVehicleToggleHandsOn(v);
+        for (int t = 0; t < 4; ++t) AdasVehicleSetTyrePressure(v, t, 20 + t);
+        AdasVehicleSetSpeed(v, 120);
+        AdasVehicleSetFrontDistCm(v, 500);
+        AdasVehicleRequestLaneChange(v);
+        return true;
+    }
+    return false;
+}
+
+static const char* const midPresetNames[] = { "idle", "city", "all" };
+
+// lays out one preset and renders the whole MID into raster (sized MID_W x MID_H)
+static void RenderPreset(const char* name, AdasMidLayout* mid, AdasRaster* raster) {
+    AdasVehicle v;
+    MidPreset(&v, name);
+    AdasResult r;
+    AdasVehicleEvaluate(&v, &r);
+    AdasMidRect dirty[8];
+    AdasMidLayoutInit(mid, MID_W, MID_H, MID_LINE_H, MID_CHAR_W);
+    AdasMidLayoutUpdate(mid, &v, &r, dirty, 8);
+    AdasRenderer renderer = AdasRasterRenderer(raster);
+    AdasMidRect all = { 0, 0, MID_W, MID_H };
+    AdasMidRender(mid, &renderer, all);
+}
+
+static bool RasterHasColor(const AdasRaster* raster, AdasMidRect area, uint32_t rgb) {
+    for (int y = area.top; y < area.bottom; ++y)
+        for (int x = area.left; x < area.right; ++x)
+            if (AdasRasterPixelRgb(raster, x, y) == rgb) return true;
+    return false;
+}
+
+// ---------------- AUDIO ----------------
+// audio sink for the CLI: records tones instead of playing them; tone() blocks while hold is set
+typedef struct ToneLog {
+    volatile uint32_t hold;
+    volatile uint32_t count;        // tones started
+    int freqs[64];
+    int done[64];                   // priority of each finished pattern
+    int doneCount;
+} ToneLog;
+
+static void LogTone(void* ctx, int freq, int ms) {
+    ToneLog* log = (ToneLog*)ctx;
+    (void)ms;
+    uint32_t n = log->count;
+    if (n < 64) log->freqs[n] = freq;
+    AdasAtomicStore32(&log->count, n + 1);
+    while (AdasAtomicLoad32(&log->hold)) AdasSleepMs(1);
+}
+
+static void LogDone(void* ctx, int priority) {
+    ToneLog* log = (ToneLog*)ctx;
+    if (log->doneCount < 64) log->done[log->doneCount++] = priority;
+}
+
+static void NullTone(void* ctx, int freq, int ms) {
+    (void)ctx; (void)freq; (void)ms;
+}
+
+static bool WaitAudioIdle(AdasAudio* a, unsigned timeoutMs) {
+    for (unsigned ms = 0; ms < timeoutMs; ++ms) {
+        if (AdasAudioIdle(a)) return true;
+        AdasSleepMs(1);
+    }
+    return AdasAudioIdle(a);
+}
+
+static bool WaitTones(ToneLog* log, uint32_t count) {
+    for (int ms = 0; ms < 2000; ++ms) {
+        if (AdasAtomicLoad32(&log->count) >= count) return true;
+        AdasSleepMs(1);
+    }
+    return false;
+}
+
+// tones in synthesized PCM: runs of non-zero samples, split by at least 1 ms of silence
+// (tone samples are never 0) or by an alert starting (a queued alert follows on the next sample);
+// returns the count, fills [start, end) pairs up to max
+static size_t ToneSegments(const int16_t* pcm, size_t count, const AdasMixer* mixer, size_t* starts, size_t* ends,
+    size_t max) {
+    AdasMixStart log[ADAS_MIX_STARTS];
+    size_t logged = AdasMixerStarts(mixer, log, ADAS_MIX_STARTS), next = 0;
+    const size_t minGap = ADAS_SYNTH_SAMPLES(1);
+    size_t n = 0, zeros = minGap;
+    for (size_t i = 0; i < count; ++i) {
+        bool alertStarts = false;
+        while (next < logged && log[next].sample <= i) alertStarts |= log[next++].sample == i;
+        if (!pcm[i]) {
+            zeros++;
+            continue;
+        }
+        if (zeros >= minGap || alertStarts) {
+            if (n < max) starts[n] = i;
+            n++;
+        }
+        if (n <= max) ends[n - 1] = i + 1;
+        zeros = 0;
+    }
+    return n;
+}
+
+static bool SegmentsAre(const int16_t* pcm, size_t count, const AdasMixer* mixer, const size_t* expect, size_t pairs) {
+    size_t starts[16], ends[16];
+    if (ToneSegments(pcm, count, mixer, starts, ends, 16) != pairs) return false;
+    for (size_t i = 0; i < pairs; ++i)
+        if (starts[i] != expect[2 * i] || ends[i] != expect[2 * i + 1]) return false;
+    return true;
+}
+
+// ---------------- CHECK ----------------
+static void SoakEvent(AdasVehicle* v, uint32_t* rng);
+
+// limiter load for the check: every thread walks its own clock 0..n through all three priorities
+#define LIMITER_CHECK_CALLS 100000
+
+static void LimiterCheckThread(void* arg) {
+    AdasAlertLimiter* l = (AdasAlertLimiter*)arg;
+    for (uint64_t i = 0; i < LIMITER_CHECK_CALLS; ++i) AdasLimiterAllow(l, 1 + (int)(i % 3), i);
+}
+
+static int checkFailures = 0;
+
+static void Expect(bool ok, const char* what) {
+    printf("%s  %s\n", ok ? "ok  " : "FAIL", what);
+    if (!ok) checkFailures++;
+}
+
+// probe load for the check: samples 1..n ns into the blit phase (unused by the CLI), then hands the ring back
+#define PROBE_CHECK_SAMPLES 50000
+
+static void ProbeCheckThread(void* arg) {
+    (void)arg;
+    for (uint64_t ns = 1; ns <= PROBE_CHECK_SAMPLES; ++ns) AdasProbeRecord(ADAS_PROBE_BLIT, ns);
+    AdasProbeThreadExit();
+}
+
+static int CmdCheck(void) {
+    // built-in table must match the formula it was generated from
+    Expect(AdasFcwTableVerify(adasFcwThresholdTable, ADAS_REACTION_TIME_S, ADAS_FRICTION_MU) == 0,
+        "built-in FCW table == AdasFcwThresholdCm for 0..180 km/h");
+
+    AdasFcwTable table;
+    AdasFcwTableBuild(&table, ADAS_REACTION_TIME_S, ADAS_FRICTION_MU);
+    Expect(memcmp(table.threshold, adasFcwThresholdTable, sizeof(table.threshold)) == 0,
+        "runtime table with default parameters == built-in table");
+
+    AdasFcwTableBuild(&table, 2.5, 0.3);
+    Expect(AdasFcwTableVerify(table.threshold, 2.5, 0.3) == 0,
+        "runtime table (reaction 2.5 s, mu 0.3) == formula");
+    Expect(AdasFcwTableLookup(&table, 250) == AdasFcwThresholdParamsCm(250, 2.5, 0.3),
+        "table lookup outside the slider range falls back to the formula");
+    Expect(adasFcwThresholdTable[ADAS_SPEED_MAX] > 50 * ADAS_CM_PER_M && adasFcwThresholdTable[ADAS_SPEED_MAX] < MAX_COLLISION_THRESHOLD_CM
+        && AdasFcwThresholdCm(400) == MAX_COLLISION_THRESHOLD_CM,
+        "FCW threshold runs past 50 m up to the 300 m cap");
+
+    // column kernels: every SIMD level == the formula, up to and past the cap
+    int32_t colSpeed[400], colFront[400], colThreshold[400];
+    uint8_t colHit[400];
+    for (int i = 0; i < 400; ++i) {
+        colSpeed[i] = i;
+        colFront[i] = (int32_t)(NextRandom() % (ADAS_DIST_MAX_CM + 1));
+    }
+    int colMismatches = 0;
+    for (int level = ADAS_SIMD_SCALAR; level <= (int)AdasFcwDetectSimd(); ++level) {
+        AdasFcwSetSimd((AdasSimdLevel)level);
+        AdasFcwColumns(colSpeed, colFront, 400, colThreshold, colHit);
+        for (int i = 0; i < 400; ++i) {
+            int32_t t = AdasFcwThresholdCm(colSpeed[i]);
+            colMismatches += colThreshold[i] != t || colHit[i] != (colFront[i] < t);
+        }
+    }
+    AdasFcwSetSimd(AdasFcwDetectSimd());
+    Expect(colMismatches == 0, "FCW column kernels == formula in cm for 0..399 km/h (every SIMD level)");
+
+    // surface profiles: built once, dry by day is the built-in table, the sweep matches lookups
+    const AdasFcwTable* dryDay = AdasFcwProfileTable(ADAS_SURFACE_DRY, false);
+    Expect(dryDay == AdasFcwProfileTable(ADAS_SURFACE_DRY, false)
+        && memcmp(dryDay->threshold, adasFcwThresholdTable, sizeof(dryDay->threshold)) == 0,
+        "dry/day profile is built once and equals the built-in table");
+    int profileMismatches = 0;
+    for (int p = 0; p < ADAS_FCW_PROFILE_COUNT; ++p) {
+        AdasSurface surface = (AdasSurface)(p / 2);
+        double reaction = ADAS_REACTION_TIME_S + ((p & 1) ? ADAS_NIGHT_REACTION_EXTRA_S : 0.0);
+        const AdasFcwTable* pt = AdasFcwProfileTable(surface, (p & 1) != 0);
+        profileMismatches += AdasFcwTableVerify(pt->threshold, reaction, AdasSurfaceMu(surface));
+        profileMismatches += pt->mu != AdasSurfaceMu(surface) || pt->reaction != reaction;
+    }
+    Expect(profileMismatches == 0, "every surface/night profile table == formula with its mu and reaction time");
+    int32_t sweepSpeed[64], sweepFront[64];
+    uint8_t sweepHits[64];
+    for (int i = 0; i < 64; ++i) {
+        sweepSpeed[i] = i == 63 ? 250 : (int32_t)(NextRandom() % 181);
+        sweepFront[i] = (int32_t)(NextRandom() % (ADAS_DIST_MAX_CM + 1));
+    }
+    int sweepMismatches = 0;
+    AdasSimdLevel bestSimd = AdasFcwDetectSimd();
+    for (int level = ADAS_SIMD_SCALAR; level <= (int)bestSimd; ++level) {
+        AdasFcwSetSimd((AdasSimdLevel)level);
+        AdasFcwProfileSweep(sweepSpeed, sweepFront, 64, sweepHits);
+        for (int i = 0; i < 64; ++i) {
+            for (int p = 0; p < ADAS_FCW_PROFILE_COUNT; ++p) {
+                const AdasFcwTable* pt = AdasFcwProfileTable((AdasSurface)(p / 2), (p & 1) != 0);
+                sweepMismatches += ((sweepHits[i] >> p) & 1) != (sweepFront[i] < AdasFcwTableLookup(pt, sweepSpeed[i]));
+            }
+        }
+    }
+    AdasFcwSetSimd(bestSimd);
+    Expect(sweepMismatches == 0, "all-profile sweep == one lookup per profile (every SIMD level)");
+
+    // compiled rules: spot checks of the decision table against the written rules
+    AdasInputs in;
+    memset(&in, 0, sizeof(in));
+    in.basePressure = 32;
+    in.tp[0] = in.tp[1] = in.tp[2] = in.tp[3] = 32;
+    in.handsOn = true;
+    in.frontDistCm = ADAS_DIST_MAX_CM;
+    AdasResult r;
+    AdasEvaluate(&in, &r);
+    Expect(r.mask == 0 && r.priority == ADAS_PRIO_NONE, "parked, all normal: no warnings");
+    in.nightMode = true;
+    in.laneChangeReq = true;
+    in.tp[2] = 27;
+    AdasEvaluate(&in, &r);
+    Expect(r.mask == (ADAS_WARN_BIT(ADAS_WARN_HEADLIGHTS_OFF_NIGHT) | ADAS_WARN_BIT(ADAS_WARN_LOW_TYRE_3)
+        | ADAS_WARN_BIT(ADAS_WARN_LANE_NO_INDICATOR)) && r.priority == ADAS_PRIO_MEDIUM,
+        "night, low tyre 3, lane change without indicator");
+    in.doorOpen[1] = true;
+    in.speed = 10;
+    in.rightInd = true;
+    AdasEvaluate(&in, &r);
+    Expect((r.mask & ADAS_WARN_BIT(ADAS_WARN_DOOR_MOVING)) && !(r.mask & ADAS_WARN_BIT(ADAS_WARN_LANE_NO_INDICATOR))
+        && r.priority == ADAS_PRIO_HIGH, "door open while moving is high; indicator clears lane warning");
+    uint32_t allDeps = 0;
+    for (int rule = 0; rule < ADAS_RULE_COUNT; rule++) allDeps |= AdasRuleDeps(rule);
+    Expect(allDeps == ADAS_IN_ALL, "every input group feeds at least one rule");
+
+    // timers count simulation ticks, so durations are exact and replay identically
+    AdasVehicle veh;
+    AdasVehicleInit(&veh);
+    AdasVehicleSetSpeed(&veh, 30);
+    bool opened = AdasVehicleToggleDoor(&veh, ADAS_DOOR_FL);
+    AdasVehicleRequestLaneChange(&veh);
+    int laneTicks = 0, blockTicks = 0;
+    for (int t = 1; t <= 1000; ++t) {
+        AdasVehicleStep(&veh);
+        AdasVehicleInputs(&veh, &in);
+        if (in.laneChangeReq) laneTicks = t;
+        if (in.doorBlockActive) blockTicks = t;
+    }
+    Expect(!opened && blockTicks + 1 == ADAS_MS_TO_TICKS(ADAS_DOOR_BLOCK_WARN_MS),
+        "blocked door warning lasts 2 s of simulation time");
+    Expect(laneTicks + 1 == ADAS_MS_TO_TICKS(ADAS_LANE_MSG_MS), "lane message lasts 1 s of simulation time");
+    int beeps = 0;
+    for (int t = 0; t < 1000; ++t) {
+        beeps += AdasVehicleBeepDue(&veh, ADAS_PRIO_HIGH);
+        AdasVehicleStep(&veh);
+    }
+    Expect(beeps == (1000 + ADAS_MS_TO_TICKS(ADAS_BEEP_SPACING_MS) - 1) / ADAS_MS_TO_TICKS(ADAS_BEEP_SPACING_MS),
+        "beeps spaced by 800 ms of simulation time");
+    // the window's only gate is this per-priority one: a high alert goes to the audio queue at once
+    AdasVehicle bv;
+    AdasVehicleInit(&bv);
+    bool lowFirst = AdasVehicleBeepDue(&bv, ADAS_PRIO_LOW);
+    AdasVehicleStep(&bv);
+    Expect(lowFirst && AdasVehicleBeepDue(&bv, ADAS_PRIO_HIGH) && !AdasVehicleBeepDue(&bv, ADAS_PRIO_MEDIUM),
+        "a high alert beeps one tick after a low one; a medium waits out the high's cooldown");
+    AdasAlertLimiter limiter;
+    AdasLimiterInit(&limiter, 80, 1);
+    bool gated = AdasLimiterAllow(&limiter, ADAS_PRIO_LOW, 0) && !AdasLimiterAllow(&limiter, ADAS_PRIO_LOW, 10)
+        && AdasLimiterAllow(&limiter, ADAS_PRIO_HIGH, 10);
+    Expect(gated, "a high alert is not held back by a low alert's cooldown");
+    gated = !AdasLimiterAllow(&limiter, ADAS_PRIO_LOW, 85) && !AdasLimiterAllow(&limiter, ADAS_PRIO_MEDIUM, 89)
+        && AdasLimiterAllow(&limiter, ADAS_PRIO_MEDIUM, 90) && !AdasLimiterAllow(&limiter, ADAS_PRIO_HIGH, 85)
+        && AdasLimiterAllow(&limiter, ADAS_PRIO_HIGH, 90);
+    Expect(gated && AdasLimiterEmitted(&limiter, ADAS_PRIO_LOW) == 1 && AdasLimiterDropped(&limiter, ADAS_PRIO_LOW) == 2
+        && AdasLimiterEmitted(&limiter, ADAS_PRIO_HIGH) == 2 && AdasLimiterDropped(&limiter, ADAS_PRIO_HIGH) == 1,
+        "a high alert restarts the lower cooldowns; counters per priority");
+    AdasLimiterInit(&limiter, 80, 3);
+    int burst = 0;
+    for (int i = 0; i < 5; ++i) burst += AdasLimiterAllow(&limiter, ADAS_PRIO_MEDIUM, 0);
+    Expect(burst == 3 && AdasLimiterAllow(&limiter, ADAS_PRIO_MEDIUM, 80), "token bucket burst and refill");
+    AdasLimiterInit(&limiter, 1000, 1);
+    AdasThread limiterThreads[4];
+    memset(limiterThreads, 0, sizeof(limiterThreads));
+    int limiterStarted = 0;
+    for (int i = 0; i < 4; ++i) limiterStarted += AdasThreadStart(&limiterThreads[i], LimiterCheckThread, &limiter) == 0;
+    for (int i = 0; i < 4; ++i) AdasThreadJoin(&limiterThreads[i]);
+    bool bounded = limiterStarted == 4;
+    for (int p = ADAS_PRIO_LOW; p <= ADAS_PRIO_HIGH; ++p) {
+        uint64_t emitted = AdasLimiterEmitted(&limiter, p), calls = emitted + AdasLimiterDropped(&limiter, p);
+        bounded = bounded && emitted >= 1 && emitted <= LIMITER_CHECK_CALLS / 1000 + 1
+            && calls == 4 * (LIMITER_CHECK_CALLS / 3 + (p <= LIMITER_CHECK_CALLS % 3));
+    }
+    Expect(bounded, "4 threads sharing a limiter never exceed one alert per interval per priority");
+    AdasVehicleToggleIndicator(&veh, ADAS_SIDE_LEFT);
+    int flips = 0;
+    bool lit = veh.blinkOn;
+    for (int t = 0; t < 100; ++t) {
+        AdasVehicleStep(&veh);
+        if (veh.blinkOn != lit) { flips++; lit = veh.blinkOn; }
+    }
+    Expect(flips == 100 / ADAS_MS_TO_TICKS(ADAS_BLINK_MS), "indicator blinks every 500 ms");
+    AdasClock clock;
+    AdasClockInit(&clock);
+    uint32_t first = AdasClockDue(&clock, 1000000000ull);
+    uint32_t due = AdasClockDue(&clock, 1000000000ull + 25000000ull);
+    due += AdasClockDue(&clock, 1000000000ull + 30000000ull);
+    uint32_t stalled = AdasClockDue(&clock, 1000000000ull + 60000000000ull);
+    Expect(first == 0 && due == 3 && stalled == ADAS_CLOCK_MAX_CATCHUP,
+        "real-time pacing hands out whole ticks and caps catch-up");
+
+    // scenarios: same trace at full speed and paced to the wall clock
+    static const char* script =
+        "0 speed 40\n"
+        "30 front 10   # FCW\n"
+        "60 door FL    # blocked while moving\n"
+        "100 lane\n"
+        "250 front 50\n"
+        "300 end\n";
+    AdasScenario scn;
+    char err[128];
+    Expect(AdasScenarioParse(&scn, script, err, sizeof(err)) && scn.count == 5 && scn.endTick == 30,
+        "scenario script parses");
+    AdasScenarioStats fast, paced;
+    AdasVehicleInit(&veh);
+    AdasScenarioRun(&scn, &veh, false, NULL, NULL, &fast);
+    AdasVehicleInit(&veh);
+    AdasScenarioRun(&scn, &veh, true, NULL, NULL, &paced);
+    AdasScenarioFree(&scn);
+    // the real-time run takes its ticks from the wall clock, in uneven batches
+    Expect(fast.traceHash == paced.traceHash && fast.beeps == paced.beeps && fast.beeps > 0
+        && paced.wakeups > 0 && paced.wakeups <= paced.ticks + 1,
+        "fast and wall-clock-driven runs give the same warnings and beeps");
+    // a leaking tyre repaints the MID on every whole PSI; those clock-only repaints do not re-beep
+    bool leakParsed = AdasScenarioParse(&scn, "0 leak 2 1\n200000 end\n", err, sizeof(err));
+    AdasVehicleInit(&veh);
+    AdasScenarioRun(&scn, &veh, false, NULL, NULL, &fast);
+    AdasScenarioFree(&scn);
+    Expect(leakParsed && fast.frames > 3 && fast.beeps == 1, "a slow puncture beeps once, not on every pressure repaint");
+    Expect(!AdasScenarioParse(&scn, "0 speed 40\n10 speed 181\n", err, sizeof(err)) && strcmp(err, "line 2: speed must be 0..180") == 0
+        && !AdasScenarioParse(&scn, "0 lead -1\n", err, sizeof(err)) && !AdasScenarioParse(&scn, "0 base 41\n", err, sizeof(err))
+        && !AdasScenarioParse(&scn, "0 tyre 2 19\n", err, sizeof(err)) && strcmp(err, "line 1: psi must be 20..40") == 0,
+        "speed, lead and pressures outside the slider ranges are rejected with their line");
+    Expect(AdasScenarioParse(&scn, "0 front 37.25\n10 front 250.5\n20 front 300\n", err, sizeof(err)) && scn.count == 3
+        && scn.events[0].value == 3725 && scn.events[1].value == 25050 && scn.events[2].value == ADAS_DIST_MAX_CM,
+        "front distances parse to the centimetre");
+    AdasScenarioFree(&scn);
+    Expect(!AdasScenarioParse(&scn, "0 front 300.01\n", err, sizeof(err)) && !AdasScenarioParse(&scn, "0 front 1.234\n", err, sizeof(err))
+        && !AdasScenarioParse(&scn, "0 front -1\n", err, sizeof(err)),
+        "front past 300 m, finer than a cm or negative is rejected");
+    Expect(!AdasScenarioParse(&scn, "10 speed 5\n5 lane\n", err, sizeof(err)) && strncmp(err, "line 2", 6) == 0,
+        "out-of-order scenario is rejected with its line number");
+
+    // MID line model: a headlight toggle dirties its header row and the one new warning row
+    AdasMidLayout mid;
+    AdasMidRect dirty[8];
+    AdasMidLayoutInit(&mid, MID_W, MID_H, MID_LINE_H, MID_CHAR_W);
+    AdasVehicleInit(&veh);
+    AdasVehicleEvaluate(&veh, &r);
+    int initial = AdasMidLayoutUpdate(&mid, &veh, &r, dirty, 8);
+    Expect(initial == 1 && dirty[0].top == 0 && mid.stats.rowsChanged == (uint64_t)mid.rowCount,
+        "first MID update dirties every row");
+    AdasVehicleToggleHeadlights(&veh);
+    AdasVehicleEvaluate(&veh, &r);
+    uint64_t before = mid.stats.rowsChanged;
+    int rects = AdasMidLayoutUpdate(&mid, &veh, &r, dirty, 8);
+    Expect(mid.stats.rowsChanged - before == 2 && rects == 2 && dirty[0].bottom - dirty[0].top == MID_LINE_H,
+        "headlight toggle repaints one header row and one warning row");
+    AdasVehicleToggleHeadlights(&veh);
+    AdasVehicleEvaluate(&veh, &r);
+    rects = AdasMidLayoutUpdate(&mid, &veh, &r, dirty, 8);
+    AdasMidLayoutUpdate(&mid, &veh, &r, dirty, 8);
+    Expect(rects == 2 && AdasMidLayoutUpdate(&mid, &veh, &r, dirty, 8) == 0,
+        "removed warning row is cleared; unchanged state dirties nothing");
+
+    // frame scheduler: a 1 s drag at 1000 inputs/s gives at most one frame per 60 Hz interval
+    AdasFrameScheduler fs;
+    AdasFrameInit(&fs, 60);
+    DragResult drag = SimulateDrag(&fs, 1.0, 1000);
+    Expect(drag.inputs == 1001 && drag.frames >= 55 && drag.frames <= 62 && !fs.pending,
+        "60 Hz scheduler coalesces a 1000 inputs/s drag to ~60 frames and flushes the last one");
+
+    // warning wrap: break at the last space that fits, drop it, hard-break an over-long word
+    {
+        AdasMidLayout narrow;
+        AdasMidLayoutInit(&narrow, 2 * ADAS_MID_WARN_INSET + 20 * MID_CHAR_W, MID_H, MID_LINE_H, MID_CHAR_W);
+        const wchar_t* text = L"\u26A0 Door opening blocked: obstacle or vehicle moving";
+        int starts[8], lens[8];
+        int lines = AdasMidWrapLines(&narrow, text, (int)wcslen(text), starts, lens, 8);
+        Expect(lines == 3 && lens[0] == 14 && starts[1] == 15 && lens[1] == 20 && wcsncmp(text + starts[2], L"vehicle moving", 14) == 0
+            && lens[2] == 14, "warnings wrap at the last space that fits");
+        AdasMidLayoutInit(&narrow, 2 * ADAS_MID_WARN_INSET + 5 * MID_CHAR_W, MID_H, MID_LINE_H, MID_CHAR_W);
+        lines = AdasMidWrapLines(&narrow, L"Forward", 7, starts, lens, 8);
+        Expect(lines == 2 && lens[0] == 5 && starts[1] == 5 && lens[1] == 2, "a word longer than the row is broken");
+    }
+
+    // software renderer: deterministic frames, clipping, dirty-rect painting equals a full repaint
+    AdasRaster raster, fresh;
+    AdasRasterInit(&raster, MID_W, MID_H);
+    AdasRasterInit(&fresh, MID_W, MID_H);
+    AdasMidLayout rmid;
+    RenderPreset("all", &rmid, &raster);
+    uint64_t allHash = AdasRasterHash(&raster);
+    AdasMidRect headerArea = { 0, 0, MID_W, ADAS_MID_HEADER_ROWS * MID_LINE_H };
+    AdasMidRect warnArea = { 0, ADAS_MID_HEADER_ROWS * MID_LINE_H, MID_W, MID_H };
+    Expect(RasterHasColor(&raster, headerArea, ADAS_MID_RGB_HEADER) && RasterHasColor(&raster, warnArea, ADAS_MID_RGB_WARNING)
+        && AdasRasterPixelRgb(&raster, MID_W - 1, MID_H - 1) == ADAS_MID_RGB_BG,
+        "software frame has green header text, orange warnings and the MID background");
+    RenderPreset("all", &rmid, &raster);
+    Expect(AdasRasterHash(&raster) == allHash, "software frames are deterministic");
+
+    AdasRenderer freshRenderer = AdasRasterRenderer(&fresh);
+    AdasMidRect corner = { 0, 0, 100, 40 };
+    AdasMidRender(&rmid, &freshRenderer, corner);
+    Expect(AdasRasterPixelRgb(&fresh, 99, 39) == ADAS_MID_RGB_BG && AdasRasterPixelRgb(&fresh, 100, 10) == 0
+        && AdasRasterPixelRgb(&fresh, 10, 40) == 0, "software renderer stays inside the clip");
+
+    {
+        AdasVehicle rv;
+        AdasVehicleInit(&rv);
+        AdasResult rr;
+        AdasMidRect rdirty[8];
+        AdasRenderer rasterRenderer = AdasRasterRenderer(&raster);
+        AdasMidLayoutInit(&rmid, MID_W, MID_H, MID_LINE_H, MID_CHAR_W);
+        uint32_t rrng = 777;
+        AdasMidRect all = { 0, 0, MID_W, MID_H };
+        for (int u = 0; u < 300; ++u) {
+            if (u) SoakEvent(&rv, &rrng);
+            AdasVehicleStep(&rv);
+            AdasVehicleEvaluate(&rv, &rr);
+            int n = AdasMidLayoutUpdate(&rmid, &rv, &rr, rdirty, 8);
+            // a fresh layout repaints the whole MID, as the window does
+            if (!u) {
+                rdirty[0] = all;
+                n = 1;
+            }
+            for (int k = 0; k < n; ++k) AdasMidRender(&rmid, &rasterRenderer, rdirty[k]);
+        }
+        AdasMidRender(&rmid, &freshRenderer, all);
+        Expect(AdasRasterHash(&raster) == AdasRasterHash(&fresh),
+            "300 updates painted through dirty rows match a full repaint");
+    }
+
+    size_t pngSize = 0;
+    uint8_t* png = AdasRasterEncodePng(&fresh, &pngSize);
+    Expect(png && pngSize > 8 && memcmp(png, "\x89PNG", 4) == 0
+        && memcmp(png + pngSize - 4, "\xAE\x42\x60\x82", 4) == 0, "PNG has a signature and a valid IEND chunk");
+    free(png);
+    AdasRasterFree(&raster);
+    AdasRasterFree(&fresh);
+
+    // terminal frontend: first frame draws everything, then only changed lines go out
+    {
+        static AdasTui tui;
+        static char tbuf[ADAS_TUI_FRAME_MAX + 1];
+        AdasVehicle tv;
+        AdasVehicleInit(&tv);
+        AdasResult tr;
+        AdasTuiInit(&tui, true);
+        AdasVehicleEvaluate(&tv, &tr);
+        size_t firstBytes = AdasTuiFrame(&tui, &tv, &tr, tbuf, ADAS_TUI_FRAME_MAX);
+        uint64_t lines = tui.stats.linesWritten;
+        Expect(firstBytes > 0 && memcmp(tbuf, "\x1b[?25l", 6) == 0 && lines == (uint64_t)tui.mid.rowCount - 6,
+            "first terminal frame clears the screen and writes every non-blank row");
+        Expect(AdasTuiFrame(&tui, &tv, &tr, tbuf, ADAS_TUI_FRAME_MAX) == 0, "an unchanged terminal frame writes nothing");
+        AdasVehicleSetFrontDistCm(&tv, 4500);
+        AdasVehicleEvaluate(&tv, &tr);
+        size_t n = AdasTuiFrame(&tui, &tv, &tr, tbuf, ADAS_TUI_FRAME_MAX);
+        Expect(tui.stats.linesWritten == lines + 1 && n > 5 && memcmp(tbuf, "\x1b[5;1H", 6) == 0,
+            "front distance change rewrites only the Front line");
+        AdasVehicleToggleIndicator(&tv, ADAS_SIDE_RIGHT);
+        AdasVehicleEvaluate(&tv, &tr);
+        AdasTuiFrame(&tui, &tv, &tr, tbuf, ADAS_TUI_FRAME_MAX);
+        lines = tui.stats.linesWritten;
+        for (int i = 0; i < ADAS_MS_TO_TICKS(ADAS_BLINK_MS); ++i) AdasVehicleStep(&tv);
+        n = AdasTuiFrame(&tui, &tv, &tr, tbuf, ADAS_TUI_FRAME_MAX);
+        tbuf[n] = '\0';
+        Expect(tui.stats.linesWritten == lines + 1 && !tv.blinkOn && n > 0 && !memchr(tbuf, '\x07', n)
+            && strstr(tbuf, "\x1b[7m") == NULL, "indicator blink rewrites one line, unlit in the off phase");
+        // the stalk keeps the indicators exclusive, but the row can show both
+        tv.leftInd = tv.rightInd = true;
+        tv.dirty |= ADAS_IN_INDICATORS;
+        for (int i = 0; i < 2 * ADAS_MS_TO_TICKS(ADAS_BLINK_MS) && !tv.blinkOn; ++i) AdasVehicleStep(&tv);
+        AdasVehicleEvaluate(&tv, &tr);
+        n = AdasTuiFrame(&tui, &tv, &tr, tbuf, ADAS_TUI_FRAME_MAX);
+        tbuf[n] = '\0';
+        Expect(tv.blinkOn && strstr(tbuf, "\x1b[7mLEFT\x1b[27m") && strstr(tbuf, "\x1b[7mRIGHT\x1b[27m"),
+            "with both indicators on, LEFT and RIGHT are both lit");
+    }
+
+    // 28 m at 30 km/h: inside the wet (29.35 m) and the night (29.73 m) thresholds, outside dry by day (25.56 m)
+    AdasVehicle road;
+    AdasVehicleInit(&road);
+    AdasVehicleSetSpeed(&road, 30);
+    AdasVehicleSetFrontDistCm(&road, 2800);
+    AdasVehicleEvaluateIncremental(&road, &r);
+    bool dryWarns = (r.mask & ADAS_WARN_BIT(ADAS_WARN_FCW)) != 0;
+    AdasVehicleSetSurface(&road, ADAS_SURFACE_WET);
+    AdasVehicleEvaluateIncremental(&road, &r);
+    bool wetWarns = (r.mask & ADAS_WARN_BIT(ADAS_WARN_FCW)) != 0 && r.fcwThresholdCm == 2935;
+    AdasVehicleSetSurface(&road, ADAS_SURFACE_DRY);
+    AdasVehicleToggleNightMode(&road);
+    AdasVehicleEvaluateIncremental(&road, &r);
+    bool nightWarns = (r.mask & ADAS_WARN_BIT(ADAS_WARN_FCW)) != 0 && r.fcwThresholdCm == 2973;
+    Expect(!dryWarns && wetWarns && nightWarns && road.fcwTable == AdasFcwProfileTable(ADAS_SURFACE_DRY, true),
+        "wet road and night lengthen the FCW threshold through the incremental path");
+
+    // TTC model: warns on the closing speed, not the gap
+    AdasFollow follow = { 100 / 3.6f, 0, 100 / 3.6f, 0, 20, 0, 0, 0 };
+    int warnedSteps = 0;
+    for (int i = 0; i < 10000; ++i) {
+        AdasFollowStepOne(&follow, ADAS_TTC_STEP_S);
+        warnedSteps += follow.warn;
+    }
+    Expect(warnedSteps == 0 && follow.ttc == ADAS_TTC_NONE && follow.gap > 19.99f && follow.gap < 20.01f,
+        "following at a constant 20 m gap at 100 km/h never warns");
+    AdasFollow still = { 0, 0, 0, 0, 1, 0, 0, 0 };
+    AdasFollowMeasureOne(&still);
+    Expect(!still.warn && still.reqDecel == 0, "stopped 1 m behind a stopped car does not warn");
+    AdasFollow closing = { 100 / 3.6f, 0, 60 / 3.6f, 0, 50, 0, 0, 0 };
+    int firstWarn = -1;
+    for (int i = 1; i <= 5000 && firstWarn < 0; ++i) {
+        AdasFollowStepOne(&closing, ADAS_TTC_STEP_S);
+        if (closing.warn) firstWarn = i;
+    }
+    // closing at 40 km/h from 50 m: TTC 2.5 s at 27.8 m, after 2.0 s
+    Expect(firstWarn >= 1995 && firstWarn <= 2005 && closing.ttc < ADAS_TTC_WARN_S,
+        "ego 100 km/h, lead 60 km/h from 50 m warns at TTC 2.5 s");
+    AdasFollow braking = { 80 / 3.6f, 0, 80 / 3.6f, -6.0f, 40, 0, 0, 0 };
+    for (int i = 0; i < 5000 && !braking.warn; ++i) AdasFollowStepOne(&braking, ADAS_TTC_STEP_S);
+    Expect(braking.warn && braking.ttc > ADAS_TTC_WARN_S && braking.reqDecel > ADAS_TTC_DECEL_WARN,
+        "a hard-braking lead warns on the required deceleration before TTC is short");
+    AdasFollowSoa soa;
+    Expect(AdasFollowAlloc(&soa, 64), "follow arrays allocate");
+    AdasFollow ones[64];
+    for (size_t i = 0; i < soa.count; ++i) {
+        memset(&ones[i], 0, sizeof(ones[i]));
+        RandomFollow(&ones[i]);
+        soa.egoV[i] = ones[i].egoV; soa.egoA[i] = ones[i].egoA;
+        soa.leadV[i] = ones[i].leadV; soa.leadA[i] = ones[i].leadA; soa.gap[i] = ones[i].gap;
+    }
+    bool sameFollow = true;
+    for (int step = 0; step < 3000; ++step) {
+        AdasFollowStep(&soa, ADAS_TTC_STEP_S);
+        for (size_t i = 0; i < soa.count; ++i) {
+            AdasFollowStepOne(&ones[i], ADAS_TTC_STEP_S);
+            sameFollow &= ones[i].gap == soa.gap[i] && ones[i].ttc == soa.ttc[i]
+                && ones[i].reqDecel == soa.reqDecel[i] && ones[i].warn == soa.warn[i];
+        }
+    }
+    Expect(sameFollow, "structure-of-arrays step == one vehicle at a time");
+    AdasFollowFree(&soa);
+    AdasVehicle ttcVeh;
+    AdasVehicleInit(&ttcVeh);
+    AdasVehicleSetSpeed(&ttcVeh, 100);
+    AdasVehicleSetLeadSpeed(&ttcVeh, 100);
+    AdasVehicleSetFrontDistCm(&ttcVeh, 2000);
+    AdasVehicleEvaluateIncremental(&ttcVeh, &r);
+    bool thresholdWarns = (r.mask & ADAS_WARN_BIT(ADAS_WARN_FCW)) && !r.fcwTtc;
+    AdasVehicleSetFcwMode(&ttcVeh, ADAS_FCW_TTC);
+    bool ttcWarns = false;
+    for (int t = 0; t < 500; ++t) {
+        AdasVehicleStep(&ttcVeh);
+        AdasVehicleEvaluateIncremental(&ttcVeh, &r);
+        ttcWarns |= (r.mask & ADAS_WARN_BIT(ADAS_WARN_FCW)) != 0;
+    }
+    Expect(thresholdWarns && !ttcWarns && ttcVeh.frontDistCm == 2000,
+        "20 m at 100 km/h: the threshold fallback warns, steady following in TTC mode does not");
+    AdasVehicleSetLeadSpeed(&ttcVeh, 60);
+    int ttcTicks = 0;
+    for (int t = 1; t <= 500 && !ttcTicks; ++t) {
+        AdasVehicleStep(&ttcVeh);
+        AdasVehicleEvaluateIncremental(&ttcVeh, &r);
+        if (r.mask & ADAS_WARN_BIT(ADAS_WARN_FCW)) ttcTicks = t;
+    }
+    Expect(ttcTicks == 1 && r.fcwTtc, "lead braking to 60 km/h 20 m ahead: TTC mode warns on the next tick");
+    bool leadBraking = ttcVeh.follow.leadA == -ADAS_TTC_MAX_ACCEL && fabsf(ttcVeh.follow.leadV - (100 / 3.6f - 0.08f)) < 1e-3f;
+    for (int t = 0; t < 200; ++t) AdasVehicleStep(&ttcVeh);
+    Expect(leadBraking && fabsf(ttcVeh.follow.leadV - 60 / 3.6f) < 1e-3f && fabsf(ttcVeh.follow.leadA) < 1e-2f,
+        "a new lead speed is reached by braking at 8 m/s^2, not in one step");
+
+    // warning text: FCW carries its parameter, everything fits the documented buffer
+    AdasWarningSet set = { ADAS_WARN_BIT(ADAS_WARN_FCW), 3705, false, 0 };
+    wchar_t line[128];
+    AdasWarningLine(&set, ADAS_WARN_FCW, line, 128);
+    Expect(wcscmp(line, L"\u26A0 Forward Collision Warning (threshold 37.05 m)") == 0,
+        "FCW warning line carries the threshold to the cm");
+    wchar_t text[ADAS_WARNINGS_TEXT_MAX];
+    set.mask = ADAS_WARN_BIT(ADAS_WARN_COUNT) - 1;
+    size_t len = AdasWarningsFormat(&set, text, ADAS_WARNINGS_TEXT_MAX);
+    Expect(len + 1 < ADAS_WARNINGS_TEXT_MAX && text[len - 1] == L'\n',
+        "all warnings fit in ADAS_WARNINGS_TEXT_MAX");
+    size_t small = AdasWarningsFormat(&set, text, 16);
+    Expect(small == 15 && text[15] == L'\0', "formatting truncates safely");
+    AdasWarningSet other = set;
+    other.fcwThresholdCm = 3706;
+    Expect(!AdasWarningSetEqual(&set, &other) && AdasWarningSetCount(&set) == ADAS_WARN_COUNT,
+        "warning sets compare by mask and parameter");
+    AdasResult ttcRes = { ADAS_WARN_BIT(ADAS_WARN_FCW), 3705, true, ADAS_PRIO_HIGH, 0 };
+    AdasWarningSetFromResult(&other, &ttcRes);
+    AdasWarningLine(&other, ADAS_WARN_FCW, line, 128);
+    Expect(other.fcwTtc && other.fcwThresholdCm == 0 && wcscmp(line, L"\u26A0 Forward Collision Warning (closing too fast)") == 0,
+        "FCW from the TTC model has its own line and no threshold");
+
+    // TPMS: a noisy quiet tyre never leaks, a 1 PSI/min puncture is found long before 4 PSI are gone
+    AdasTpms quiet, punctured;
+    AdasTpmsReset(&quiet, 32.0f);
+    AdasTpmsReset(&punctured, 32.0f);
+    const float tpmsDt = ADAS_TPMS_SAMPLE_MS * 0.001f;
+    int quietLeaks = 0, foundAt = 0;
+    for (int s = 1; s <= 36000; ++s) {
+        float noise = 0.3f * NoiseSample();
+        AdasTpmsStepOne(&quiet, 32.0f + noise, tpmsDt);
+        AdasTpmsStepOne(&punctured, 32.0f - s * tpmsDt / 60.0f + noise, tpmsDt);
+        quietLeaks += quiet.leak;
+        if (punctured.leak && !foundAt) foundAt = s;
+        if (foundAt && s > 600) break;
+    }
+    Expect(quietLeaks == 0 && foundAt > 0 && foundAt * tpmsDt <= 30.0f,
+        "leak detector: no alarm on a noisy (0.3 PSI) tyre in 1 h, 1 PSI/min found within 30 s");
+    Expect(fabsf(AdasTpmsLossPerMin(&punctured) - 1.0f) < 0.25f && AdasTpmsNoise(&quiet) > 0.2f && AdasTpmsNoise(&quiet) < 0.45f,
+        "leak detector tracks the loss rate and the sensor noise");
+    AdasTpmsSoa tpmsSoa;
+    AdasTpms tpmsOne[6];
+    float tpmsPsi[6];
+    bool sameTpms = AdasTpmsAlloc(&tpmsSoa, 6);
+    for (int i = 0; i < 6 && sameTpms; ++i) tpmsPsi[i] = 30.0f + i;
+    if (sameTpms) AdasTpmsResetAll(&tpmsSoa, tpmsPsi);
+    for (int i = 0; i < 6; ++i) AdasTpmsReset(&tpmsOne[i], 30.0f + i);
+    for (int s = 1; s <= 500 && sameTpms; ++s) {
+        for (int i = 0; i < 6; ++i) {
+            tpmsPsi[i] = 30.0f + i - i * 0.5f * s * tpmsDt + 0.1f * NoiseSample();
+            AdasTpmsStepOne(&tpmsOne[i], tpmsPsi[i], tpmsDt);
+        }
+        AdasTpmsStep(&tpmsSoa, tpmsPsi, tpmsDt);
+    }
+    for (int i = 0; i < 6 && sameTpms; ++i)
+        sameTpms = tpmsOne[i].level == tpmsSoa.level[i] && tpmsOne[i].trend == tpmsSoa.trend[i] && tpmsOne[i].leak == tpmsSoa.leak[i];
+    AdasTpmsFree(&tpmsSoa);
+    Expect(sameTpms, "structure-of-arrays TPMS step == one sensor at a time");
+
+    // vehicle: the leak warning names the tyre minutes before the low-pressure rule
+    AdasVehicle tyreVeh;
+    AdasVehicleInit(&tyreVeh);
+    AdasVehicleSetTyreLeak(&tyreVeh, 1, 1.0f);
+    int leakTick = 0, lowTick = 0;
+    for (int t = 1; t <= ADAS_MS_TO_TICKS(6 * 60000) && !lowTick; ++t) {
+        AdasVehicleStep(&tyreVeh);
+        AdasVehicleEvaluateIncremental(&tyreVeh, &r);
+        if ((r.mask & ADAS_WARN_BIT(ADAS_WARN_TYRE_LEAK)) && r.leakTyres == 2 && !leakTick) leakTick = t;
+        if (r.mask & ADAS_WARN_BIT(ADAS_WARN_LOW_TYRE_2)) lowTick = t;
+    }
+    Expect(leakTick > 0 && lowTick > 0 && ADAS_MS_TO_TICKS(60000) * 3 < lowTick - leakTick,
+        "1 PSI/min on T2: leak warning names T2 more than 3 min before Low Tyre Pressure");
+    AdasVehicleSetTyrePressure(&tyreVeh, 1, 32);
+    AdasVehicleEvaluateIncremental(&tyreVeh, &r);
+    Expect(!(r.mask & ADAS_WARN_BIT(ADAS_WARN_TYRE_LEAK)) && tyreVeh.tyrePsi[1] == 32.0f,
+        "re-inflating a tyre restarts its leak detector");
+    AdasVehicleInit(&tyreVeh);
+    AdasVehicleSetTyreLeak(&tyreVeh, 1, 1.0f);
+    for (int t = 0; t < ADAS_MS_TO_TICKS(20000); ++t) AdasVehicleStep(&tyreVeh);
+    bool leakingAtShown = tyreVeh.tyreLeak == 2 && tyreVeh.tp[1] == tyreVeh.basePressure;
+    AdasVehicleSetTyrePressure(&tyreVeh, 1, tyreVeh.basePressure);
+    Expect(leakingAtShown && tyreVeh.tyreLeak == 0 && tyreVeh.tyrePsi[1] == (float)tyreVeh.basePressure,
+        "setting the pressure the MID already shows still restarts the sensor");
+    AdasWarningSet tyreSet = { ADAS_WARN_BIT(ADAS_WARN_TYRE_LEAK) | ADAS_WARN_BIT(ADAS_WARN_LOW_TYRE_3), 0, false, 0xA };
+    AdasWarningLine(&tyreSet, ADAS_WARN_TYRE_LEAK, line, 128);
+    bool leakLine = wcscmp(line, L"\u26A0 Tyre Losing Pressure: T2 T4") == 0;
+    AdasWarningLine(&tyreSet, ADAS_WARN_LOW_TYRE_3, line, 128);
+    Expect(leakLine && wcscmp(line, L"\u26A0 Low Tyre Pressure (T3)") == 0, "tyre warnings name their tyres");
+    Expect(AdasScenarioParse(&scn, "0 leak 2 0.75\n", err, sizeof(err)) && scn.count == 1
+        && scn.events[0].index == 1 && scn.events[0].value == 75, "scenario puncture rate parses to 0.01 PSI/min");
+    AdasScenarioFree(&scn);
+
+    AdasProbeReset();
+    for (uint64_t ns = 1; ns <= 1000; ++ns) AdasProbeRecord(ADAS_PROBE_BLIT, ns);
+    AdasProbeHistogram hist;
+    AdasProbeCollect();
+    AdasProbeHistogramOf(ADAS_PROBE_BLIT, &hist);
+    uint64_t p50 = AdasProbePercentile(&hist, 50);
+    Expect(hist.count == 1000 && p50 >= 500 && p50 <= 500 + 500 / 16 && hist.maxNs == 1000
+        && AdasProbePercentile(&hist, 100) == 1000, "probe percentiles are within 1/16 of the true value");
+    AdasProbeReset();
+    uint64_t probeDropped = AdasProbeDropped();
+    AdasThread probeThreads[4];
+    memset(probeThreads, 0, sizeof(probeThreads));
+    int started = 0;
+    for (int i = 0; i < 4; ++i) started += AdasThreadStart(&probeThreads[i], ProbeCheckThread, NULL) == 0;
+    // the recording threads never drain; this thread collects while they run, as a reporter would
+    for (int i = 0; i < 100; ++i) AdasProbeCollect();
+    for (int i = 0; i < 4; ++i) AdasThreadJoin(&probeThreads[i]);
+    AdasProbeCollect();
+    AdasProbeHistogramOf(ADAS_PROBE_BLIT, &hist);
+    Expect(started == 4 && hist.count > 0 && hist.count + (AdasProbeDropped() - probeDropped) == 4 * PROBE_CHECK_SAMPLES
+        && hist.maxNs <= PROBE_CHECK_SAMPLES, "probes from 4 threads are all collected or counted as dropped");
+    AdasProbeReset();
+
+    // audio worker: a high alert pre-empts a medium burst after its first tone; queues are bounded
+    static ToneLog toneLog;
+    static AdasAudio audio;
+    AdasAudioSink sink = { LogTone, LogDone, &toneLog, 1 };
+    memset(&toneLog, 0, sizeof(toneLog));
+    toneLog.hold = 1;
+    Expect(AdasAudioStart(&audio, &sink) == 0, "audio worker starts");
+    AdasAudioEnqueue(&audio, ADAS_PRIO_MEDIUM);
+    bool toneStarted = WaitTones(&toneLog, 1);
+    AdasAudioEnqueue(&audio, ADAS_PRIO_HIGH);
+    AdasAtomicStore32(&toneLog.hold, 0);
+    Expect(toneStarted && WaitAudioIdle(&audio, 3000) && toneLog.count == 4 && toneLog.freqs[0] == 900
+        && toneLog.freqs[1] == 1200 && toneLog.freqs[3] == 1200 && toneLog.doneCount == 1
+        && toneLog.done[0] == ADAS_PRIO_HIGH && audio.stats.preempted == 1 && audio.stats.completed == 1,
+        "a high-priority alert pre-empts a medium burst");
+    toneLog.hold = 1;
+    AdasAudioEnqueue(&audio, ADAS_PRIO_LOW);
+    toneStarted = WaitTones(&toneLog, 5);
+    int accepted = 0;
+    for (int i = 0; i <= ADAS_AUDIO_QUEUE; ++i) accepted += AdasAudioEnqueue(&audio, ADAS_PRIO_LOW);
+    AdasAtomicStore32(&toneLog.hold, 0);
+    Expect(toneStarted && accepted == ADAS_AUDIO_QUEUE && audio.stats.dropped == 1 && WaitAudioIdle(&audio, 3000)
+        && audio.stats.completed == 2 + ADAS_AUDIO_QUEUE && audio.stats.latencyCount == audio.stats.played,
+        "a full alert queue drops instead of blocking");
+    AdasAudioStop(&audio);
+    Expect(audio.stats.threadsStarted == 1, "every alert played on one audio thread");
+
+    // PCM timelines, to the sample (44.1 kHz: 100 ms = 4410 samples)
+    AdasSynth synth;
+    Expect(AdasSynthInit(&synth) && AdasSynthPattern(&synth, ADAS_PRIO_HIGH)->count == ADAS_SYNTH_SAMPLES(650)
+        && AdasSynthPattern(&synth, ADAS_PRIO_LOW)->count == ADAS_SYNTH_SAMPLES(200),
+        "PCM patterns are as long as their beep patterns");
+    int16_t* pcm = NULL;
+    static AdasMixer mixed;
+    AdasAlertEvent medium[] = { { 0, ADAS_PRIO_MEDIUM } };
+    size_t samples = AdasSynthRenderTimeline(&synth, medium, 1, &pcm, &mixed);
+    static const size_t mediumTones[] = { 0, 8820, 15435, 24255 };
+    Expect(samples == 24255 && SegmentsAre(pcm, samples, &mixed, mediumTones, 2), "medium alert: 200 ms tone, 150 ms gap, 200 ms tone");
+    free(pcm);
+    AdasAlertEvent preempt[] = { { 0, ADAS_PRIO_MEDIUM }, { 100, ADAS_PRIO_HIGH } };
+    samples = AdasSynthRenderTimeline(&synth, preempt, 2, &pcm, &mixed);
+    static const size_t preemptTones[] = { 0, 4410, 4410, 11025, 15435, 22050, 26460, 33075 };
+    Expect(samples == 33075 && SegmentsAre(pcm, samples, &mixed, preemptTones, 4), "PCM high alert pre-empts medium at its start sample");
+    free(pcm);
+    AdasAlertEvent queued[] = { { 0, ADAS_PRIO_HIGH }, { 10, ADAS_PRIO_LOW } };
+    samples = AdasSynthRenderTimeline(&synth, queued, 2, &pcm, &mixed);
+    static const size_t queuedTones[] = { 0, 6615, 11025, 17640, 22050, 28665, 28665, 37485 };
+    AdasMixStart queuedStarts[2];
+    Expect(samples == 37485 && SegmentsAre(pcm, samples, &mixed, queuedTones, 4)
+        && AdasMixerStarts(&mixed, queuedStarts, 2) == 2 && queuedStarts[1].sample == 28665
+        && queuedStarts[1].priority == ADAS_PRIO_LOW, "PCM low alert waits for the high pattern to end");
+    size_t wavSize = 0;
+    uint8_t* wav = AdasWavEncode(pcm, samples, &wavSize);
+    Expect(wav && wavSize == 44 + 2 * samples && memcmp(wav, "RIFF", 4) == 0 && memcmp(wav + 8, "WAVEfmt ", 8) == 0
+        && wav[24] == (ADAS_SYNTH_RATE & 0xFF) && wav[25] == (ADAS_SYNTH_RATE >> 8) && memcmp(wav + 36, "data", 4) == 0
+        && (uint8_t)pcm[0] == wav[44], "WAV header and little-endian samples");
+    free(wav);
+    free(pcm);
+    AdasSynthFree(&synth);
+
+    printf("%d failure(s)\n", checkFailures);
+    return checkFailures ? 1 : 0;
+}
+
+// ---------------- SOAK ----------------
+typedef struct SoakWorker {
+    AdasVehicle* vehicles;
+    size_t count;
+    double seconds;
+    uint32_t seed;
+    uint64_t evaluations;
+    uint64_t warned;
+    AdasAlertLimiter* speaker;      // shared by every worker
+    AdasThread thread;
+} SoakWorker;
+
+// one UI-style event on a random vehicle of the slice
+static void SoakEvent(AdasVehicle* v, uint32_t* rng) {
+    switch (XorShift(rng) % 10) {
+    case 0: AdasVehicleSetSpeed(v, (int)(XorShift(rng) % 181)); break;
+    case 1: AdasVehicleSetFrontDistCm(v, (int32_t)(XorShift(rng) % (ADAS_DIST_MAX_CM + 1))); break;
+    case 2: AdasVehicleSetBasePressure(v, 20 + (int)(XorShift(rng) % 21)); break;
+    case 3: AdasVehicleSetTyrePressure(v, (int)(XorShift(rng) % 4), 20 + (int)(XorShift(rng) % 21)); break;
+    case 4: AdasVehicleToggleHeadlights(v); break;
+    case 5: AdasVehicleToggleNightMode(v); break;
+    case 6: AdasVehicleToggleIndicator(v, (XorShift(rng) & 1) ? ADAS_SIDE_LEFT : ADAS_SIDE_RIGHT); break;
+    case 7: AdasVehicleToggleDoor(v, (int)(XorShift(rng) % 4)); break;
+    case 8: AdasVehicleRequestLaneChange(v); break;
+    default: AdasVehicleToggleHandsOn(v); break;
+    }
+}
+
+static void SoakThread(void* arg) {
+    SoakWorker* w = (SoakWorker*)arg;
+    uint32_t* masks = (uint32_t*)malloc(w->count * sizeof(uint32_t));
+    uint8_t* priorities = (uint8_t*)malloc(w->count);
+    if (!masks || !priorities) {
+        free(masks); free(priorities);
+        return;
+    }
+    // counters stay local so neighbouring workers do not share cache lines
+    uint64_t evaluations = 0, warned = 0;
+    uint32_t rng = w->seed;
+    double end = NowSeconds() + w->seconds;
+    while (NowSeconds() < end) {
+        // a burst of input events, then one frame for every vehicle in the slice
+        for (size_t e = 0; e < w->count / 8 + 1; ++e)
+            SoakEvent(&w->vehicles[XorShift(&rng) % w->count], &rng);
+        AdasFleetStep(w->vehicles, w->count);
+        AdasFleetEvaluate(w->vehicles, w->count, masks, priorities);
+        for (size_t i = 0; i < w->count; ++i) {
+            if (priorities[i] > ADAS_PRIO_NONE && AdasVehicleBeepDue(&w->vehicles[i], priorities[i])) {
+                warned++;
+                // the bursts all vehicles would play on one speaker
+                AdasLimiterAllow(w->speaker, priorities[i], AdasNowNs());
+            }
+        }
+        evaluations += w->count;
+    }
+    w->evaluations = evaluations;
+    w->warned = warned;
+    free(masks); free(priorities);
+}
+
+static int CmdSoak(int argc, char** argv) {
+    size_t vehicles = argc > 0 ? (size_t)strtoul(argv[0], NULL, 10) : 10000;
+    int threads = argc > 1 ? atoi(argv[1]) : AdasCpuCount();
+    double seconds = argc > 2 ? atof(argv[2]) : 3.0;
+    if (vehicles == 0 || threads <= 0 || seconds <= 0) {
+        fprintf(stderr, "soak: vehicles, threads and seconds must be positive\n");
+        return 1;
+    }
+    if ((size_t)threads > vehicles) threads = (int)vehicles;
+
+    AdasVehicle* fleet = (AdasVehicle*)malloc(vehicles * sizeof(AdasVehicle));
+    SoakWorker* workers = (SoakWorker*)calloc((size_t)threads, sizeof(SoakWorker));
+    if (!fleet || !workers) {
+        fprintf(stderr, "soak: out of memory\n");
+        free(fleet); free(workers);
+        return 1;
+    }
+    for (size_t i = 0; i < vehicles; ++i) AdasVehicleInit(&fleet[i]);
+    static AdasAlertLimiter speaker;
+    AdasLimiterInit(&speaker, (uint64_t)ADAS_BEEP_SPACING_MS * 1000000ull, 1);
+
+    // contiguous slice per thread: vehicles never cross threads
+    size_t per = vehicles / (size_t)threads;
+    double t0 = NowSeconds();
+    for (int t = 0; t < threads; ++t) {
+        SoakWorker* w = &workers[t];
+        w->vehicles = fleet + per * (size_t)t;
+        w->count = (t == threads - 1) ? vehicles - per * (size_t)t : per;
+        w->seconds = seconds;
+        w->seed = 0x9E3779B9u * (uint32_t)(t + 1);
+        w->speaker = &speaker;
+        if (AdasThreadStart(&w->thread, SoakThread, w) != 0) {
+            fprintf(stderr, "soak: thread start failed, running inline\n");
+            SoakThread(w);
+        }
+    }
+    uint64_t evaluations = 0, beeps = 0;
+    for (int t = 0; t < threads; ++t) {
+        AdasThreadJoin(&workers[t].thread);
+        evaluations += workers[t].evaluations;
+        beeps += workers[t].warned;
+    }
+    double elapsed = NowSeconds() - t0;
+
+    printf("vehicles: %zu on %d thread(s)\n", vehicles, threads);
+    printf("vehicle evaluations: %llu in %.2f s (%.2f M/s)\n",
+        (unsigned long long)evaluations, elapsed, evaluations / elapsed / 1e6);
+    printf("beep bursts due: %llu\n", (unsigned long long)beeps);
+    // one 800 ms bucket per priority, shared by all threads: at most elapsed / 0.8 s + 1 each
+    unsigned long long bound = (unsigned long long)(elapsed * 1000 / ADAS_BEEP_SPACING_MS) + 1;
+    bool limited = true;
+    for (int p = ADAS_PRIO_HIGH; p >= ADAS_PRIO_LOW; --p) {
+        unsigned long long emitted = AdasLimiterEmitted(&speaker, p);
+        printf("shared speaker, priority %d: %llu emitted, %llu dropped (bound %llu)\n",
+            p, emitted, (unsigned long long)AdasLimiterDropped(&speaker, p), bound);
+        if (emitted > bound) limited = false;
+    }
+    if (!limited) fprintf(stderr, "soak: shared limiter exceeded its rate\n");
+
+    free(fleet); free(workers);
+    return limited ? 0 : 1;
+}
+
+// ---------------- BENCH INCREMENTAL ----------------
+// one frame of a UI session: mostly speed-slider drag steps, with an occasional toggle
+static void DragFrame(AdasVehicle* v, int frame) {
+    AdasVehicleSetSpeed(v, frame % 181);
+    if (frame % 97 == 0) AdasVehicleToggleHeadlights(v);
+    if (frame % 211 == 0) AdasVehicleRequestLaneChange(v);
+    AdasVehicleStep(v);
+}
+
+static int CmdBenchIncr(int argc, char** argv) {
+    int frames = argc > 0 ? atoi(argv[0]) : 2000000;
+    if (frames <= 0) {
+        fprintf(stderr, "bench-incr: frames must be positive\n");
+        return 1;
+    }
+
+    AdasVehicle full, incr;
+    AdasVehicleInit(&full);
+    AdasVehicleInit(&incr);
+    uint64_t mismatches = 0;
+    volatile uint64_t sink = 0; // keeps the timed loops from being optimised away
+
+    // the drag itself (slider + clock step), subtracted to leave the rule evaluation per paint
+    AdasVehicle drive;
+    AdasVehicleInit(&drive);
+    double t0 = NowSeconds();
+    for (int f = 0; f < frames; ++f) {
+        DragFrame(&drive, f);
+        sink += drive.dirty;
+        drive.dirty = 0;
+    }
+    double driveTime = NowSeconds() - t0;
+
+    t0 = NowSeconds();
+    for (int f = 0; f < frames; ++f) {
+        AdasResult r;
+        DragFrame(&full, f);
+        AdasVehicleEvaluate(&full, &r);
+        sink += r.mask + r.priority;
+    }
+    double fullTime = NowSeconds() - t0;
+
+    t0 = NowSeconds();
+    for (int f = 0; f < frames; ++f) {
+        AdasResult r;
+        DragFrame(&incr, f);
+        AdasVehicleEvaluateIncremental(&incr, &r);
+        sink -= r.mask + r.priority;
+    }
+    double incrTime = NowSeconds() - t0;
+
+    // replay once more comparing frame by frame
+    AdasVehicleInit(&full);
+    AdasVehicleInit(&incr);
+    for (int f = 0; f < frames && f < 100000; ++f) {
+        AdasResult a, b;
+        DragFrame(&full, f);
+        DragFrame(&incr, f);
+        AdasVehicleEvaluate(&full, &a);
+        AdasVehicleEvaluateIncremental(&incr, &b);
+        if (a.mask != b.mask || a.priority != b.priority || a.fcwThresholdCm != b.fcwThresholdCm) mismatches++;
+    }
+
+    const AdasEvalCache* c = &incr.eval;
+    printf("frames: %d (speed slider drag)\n", frames);
+    printf("rules per frame: %.2f evaluated, %.2f reused (of %d)\n",
+        (double)c->totalEvaluated / c->frames, (double)c->totalSkipped / c->frames, ADAS_RULE_COUNT);
+    printf("drag only:   %.1f ns/frame\n", driveTime / frames * 1e9);
+    printf("full:        %.1f ns/frame (%.1f ns evaluating)\n", fullTime / frames * 1e9, (fullTime - driveTime) / frames * 1e9);
+    printf("incremental: %.1f ns/frame (%.1f ns evaluating)\n", incrTime / frames * 1e9, (incrTime - driveTime) / frames * 1e9);
+    printf("results %s (%llu mismatches)\n", mismatches ? "DIFFER" : "identical",
+        (unsigned long long)mismatches);
+    return mismatches ? 1 : 0;
+}
+
+// ---------------- BENCH MID ----------------
+// random UI events on one vehicle; every event or timer change is one MID update, as in the window
+static int CmdBenchMid(int argc, char** argv) {
+    int updates = argc > 0 ? atoi(argv[0]) : 100000;
+    if (updates <= 0) {
+        fprintf(stderr, "bench-mid: updates must be positive\n");
+        return 1;
+    }
+    AdasVehicle v;
+    AdasVehicleInit(&v);
+    AdasMidLayout mid;
+    AdasMidLayoutInit(&mid, MID_W, MID_H, MID_LINE_H, MID_CHAR_W);
+    AdasMidRect dirty[8];
+    uint32_t rng = 12345;
+    uint64_t rects = 0;
+
+    double t0 = NowSeconds();
+    for (int u = 0; u < updates; ++u) {
+        // mostly slider moves, like a drag
+        if (XorShift(&rng) % 4) AdasVehicleSetSpeed(&v, (int)(XorShift(&rng) % 181));
+        else SoakEvent(&v, &rng);
+        AdasVehicleStep(&v);
+        AdasResult r;
+        AdasVehicleEvaluateIncremental(&v, &r);
+        rects += (uint64_t)AdasMidLayoutUpdate(&mid, &v, &r, dirty, 8);
+    }
+    double elapsed = NowSeconds() - t0;
+
+    const AdasMidStats* st = &mid.stats;
+    double window = (double)WINDOW_W * WINDOW_H * (double)st->updates;
+    printf("updates: %llu (%.0f ns each)\n", (unsigned long long)st->updates, elapsed / updates * 1e9);
+    printf("rows changed per update: %.2f, dirty rects: %.2f\n",
+        (double)st->rowsChanged / st->updates, (double)rects / st->updates);
+    printf("header segments reformatted per update: %.2f of %d\n",
+        (double)st->segmentsFormatted / st->updates, ADAS_MID_SEG_COUNT);
+    printf("invalidated area: %.1f%% of the MID, %.1f%% of the window (was 100%% of the window)\n",
+        100.0 * st->dirtyPixels / st->fullPixels, 100.0 * st->dirtyPixels / window);
+    return 0;
+}
+
+// ---------------- BENCH FRAMES ----------------
+static int CmdBenchFrames(int argc, char** argv) {
+    double seconds = argc > 0 ? atof(argv[0]) : 10.0;
+    int inputUs = argc > 1 ? atoi(argv[1]) : 1000;
+    if (seconds <= 0 || inputUs <= 0) {
+        fprintf(stderr, "bench-frames: seconds and input interval must be positive\n");
+        return 1;
+    }
+    static const uint32_t rates[] = { 30, 60, 120 };
+    printf("slider drag: %.1f s, one input every %d us\n", seconds, inputUs);
+    for (size_t i = 0; i < sizeof(rates) / sizeof(rates[0]); ++i) {
+        AdasFrameScheduler fs;
+        AdasFrameInit(&fs, rates[i]);
+        DragResult d = SimulateDrag(&fs, seconds, inputUs);
+        printf("%3u Hz: %llu inputs -> %llu frames (%.1f inputs/frame, max %u); frame time p50 %.2f us, p95 %.2f us, p99 %.2f us, max %.2f us\n",
+            rates[i], (unsigned long long)d.inputs, (unsigned long long)d.frames,
+            AdasFrameInputsPerFrame(&fs), fs.maxInputsPerFrame,
+            AdasFramePercentile(&fs, 50) / 1e3, AdasFramePercentile(&fs, 95) / 1e3,
+            AdasFramePercentile(&fs, 99) / 1e3, AdasFramePercentile(&fs, 100) / 1e3);
+    }
+    return 0;
+}
+
+// ---------------- RENDER ----------------
+static bool EndsWith(const char* s, const char* suffix) {
+    size_t n = strlen(s), k = strlen(suffix);
+    return n >= k && strcmp(s + n - k, suffix) == 0;
+}
+
+static int CmdRender(int argc, char** argv) {
+    if (argc < 1) {
+        fprintf(stderr, "render: missing output file (.ppm or .png)\n");
+        return 1;
+    }
+    const char* preset = argc > 1 ? argv[1] : "all";
+    AdasVehicle probe;
+    if (!MidPreset(&probe, preset)) {
+        fprintf(stderr, "render: unknown preset %s (idle, city, all)\n", preset);
+        return 1;
+    }
+    AdasRaster raster;
+    AdasMidLayout mid;
+    if (!AdasRasterInit(&raster, MID_W, MID_H)) return 1;
+    RenderPreset(preset, &mid, &raster);
+
+    size_t size = 0;
+    uint8_t* data = EndsWith(argv[0], ".png") ? AdasRasterEncodePng(&raster, &size) : AdasRasterEncodePpm(&raster, &size);
+    FILE* f = data ? fopen(argv[0], "wb") : NULL;
+    bool ok = f && fwrite(data, 1, size, f) == size;
+    if (f && fclose(f) != 0) ok = false;
+    free(data);
+    printf("%s: %dx%d, %s, frame %016llx\n", argv[0], raster.width, raster.height, preset,
+        (unsigned long long)AdasRasterHash(&raster));
+    AdasRasterFree(&raster);
+    if (!ok) {
+        fprintf(stderr, "render: cannot write %s\n", argv[0]);
+        return 1;
+    }
+    return 0;
+}
+
+// the window's two paint paths on the software renderer: erase the whole client area with the
+// class brush then draw the MID, vs draw the MID off-screen and copy it in one blit (user-010)
+static void BenchPaintPaths(int frames, AdasMidLayout* mid, AdasRaster* raster, AdasRenderer* renderer) {
+    AdasRaster window;
+    if (!AdasRasterInit(&window, WINDOW_W, WINDOW_H)) return;
+    AdasMidRect all = { 0, 0, MID_W, MID_H };
+    const size_t windowPixels = (size_t)WINDOW_W * WINDOW_H;
+    volatile uint32_t sink = 0;
+
+    double t0 = NowSeconds();
+    for (int f = 0; f < frames; ++f) {
+        for (size_t i = 0; i < windowPixels; ++i) window.pixels[i] = 0xFFF0F0F0u;
+        AdasMidRender(mid, renderer, all);
+        sink += raster->pixels[f % (MID_W * MID_H)];
+    }
+    double erase = NowSeconds() - t0;
+
+    t0 = NowSeconds();
+    for (int f = 0; f < frames; ++f) {
+        AdasMidRender(mid, renderer, all);
+        for (int y = 0; y < MID_H; ++y)
+            memcpy(window.pixels + (size_t)(MID_Y + y) * WINDOW_W + MID_X, raster->pixels + (size_t)y * MID_W, MID_W * sizeof(uint32_t));
+        sink += window.pixels[f % windowPixels];
+    }
+    double buffered = NowSeconds() - t0;
+    (void)sink;
+    printf("window paint, erase %dx%d + draw: %7.1f us\n", WINDOW_W, WINDOW_H, erase / frames * 1e6);
+    printf("window paint, off-screen MID + blit: %7.1f us (%.0f%%)\n", buffered / frames * 1e6, 100.0 * buffered / erase);
+    AdasRasterFree(&window);
+}
+
+// GUI proxy for the window's glyph atlas (ADAS_GlyphAtlas.c, Windows only): every glyph is drawn
+// once per colour with the software font into a cell atlas, and rows are copied cell by cell with
+// the same loop. Compared with drawing each glyph's pixels, and checked against it pixel for pixel.
+typedef struct AtlasProxy {
+    AdasRaster* dst;
+    AdasRaster cells;       // glyph g, colour c at (g * charWidth, c * lineHeight)
+} AtlasProxy;
+
+static int AtlasProxyGlyph(wchar_t ch) {
+    if (ch >= 0x20 && ch <= 0x7E) return ch - 0x20;
+    return ch == 0x26A0 ? 0x7F - 0x20 : -1;
+}
+
+static void AtlasProxyBegin(void* target, const AdasMidLayout* m, AdasMidRect clip) {
+    (void)target; (void)m; (void)clip;
+}
+
+static void AtlasProxyClear(void* target, AdasMidRect rect) {
+    AtlasProxy* a = (AtlasProxy*)target;
+    // the space cell is all background, in the raster's pixel format
+    uint32_t bg = a->cells.pixels[0];
+    for (int y = rect.top; y < rect.bottom; ++y) {
+        uint32_t* p = a->dst->pixels + (size_t)y * a->dst->width;
+        for (int x = rect.left; x < rect.right; ++x) p[x] = bg;
+    }
+}
+
+static void AtlasProxyText(void* target, const AdasMidLayout* m, int index, AdasMidRect part) {
+    AtlasProxy* a = (AtlasProxy*)target;
+    const AdasMidRow* row = &m->rows[index];
+    const uint32_t* colorRow = a->cells.pixels + (size_t)((int)row->color * m->lineHeight) * a->cells.width;
+    for (int i = 0; i < row->len; ++i) {
+        int gx = row->x + i * m->charWidth;
+        if (gx >= part.right) break;
+        int left = gx > part.left ? gx : part.left;
+        int right = gx + m->charWidth < part.right ? gx + m->charWidth : part.right;
+        int g = AtlasProxyGlyph(row->text[i]);
+        if (left >= right || g <= 0) continue;      // spaces (g == 0) are already background
+        const uint32_t* src = colorRow + (size_t)(part.top - row->y) * a->cells.width + (size_t)(g * m->charWidth + left - gx);
+        uint32_t* out = a->dst->pixels + (size_t)part.top * a->dst->width + left;
+        for (int y = part.top; y < part.bottom; ++y, src += a->cells.width, out += a->dst->width)
+            memcpy(out, src, (size_t)(right - left) * sizeof(uint32_t));
+    }
+}
+
+static void AtlasProxyEnd(void* target) {
+    (void)target;
+}
+
+static const AdasRenderOps atlasProxyOps = { "atlas", AtlasProxyBegin, AtlasProxyClear, AtlasProxyText, AtlasProxyEnd };
+
+static void BenchAtlasProxy(int frames, AdasMidLayout* mid, AdasRaster* raster, AdasRenderer* renderer) {
+    const int glyphs = 0x7F - 0x20 + 1;
+    AtlasProxy proxy;
+    if (!AdasRasterInit(&proxy.cells, glyphs * MID_CHAR_W, ADAS_MID_COLOR_COUNT * MID_LINE_H)) return;
+    static AdasMidLayout sheet;
+    AdasMidLayoutInit(&sheet, proxy.cells.width, proxy.cells.height, MID_LINE_H, MID_CHAR_W);
+    for (int c = 0; c < ADAS_MID_COLOR_COUNT; ++c) {
+        AdasMidRow* row = &sheet.rows[c];
+        for (int g = 0; g < glyphs; ++g) row->text[g] = g == glyphs - 1 ? 0x26A0 : (wchar_t)(0x20 + g);
+        row->len = glyphs;
+        row->x = 0;
+        row->y = c * MID_LINE_H;
+        row->color = (AdasMidColor)c;
+    }
+    sheet.rowCount = ADAS_MID_COLOR_COUNT;
+    AdasRenderer sheetRenderer = AdasRasterRenderer(&proxy.cells);
+    AdasMidRect sheetAll = { 0, 0, proxy.cells.width, proxy.cells.height };
+    AdasMidRender(&sheet, &sheetRenderer, sheetAll);
+
+    AdasRaster copied;
+    if (!AdasRasterInit(&copied, MID_W, MID_H)) {
+        AdasRasterFree(&proxy.cells);
+        return;
+    }
+    proxy.dst = &copied;
+    AdasRenderer atlas = { &atlasProxyOps, &proxy };
+    AdasMidRect all = { 0, 0, MID_W, MID_H };
+
+    AdasMidRender(mid, renderer, all);
+    AdasMidRender(mid, &atlas, all);
+    bool same = AdasRasterHash(raster) == AdasRasterHash(&copied);
+
+    // text only: the background clear is the same fill on both paths
+    const AdasRenderer* paths[2] = { renderer, &atlas };
+    double elapsed[2];
+    for (int p = 0; p < 2; ++p) {
+        double t0 = NowSeconds();
+        for (int f = 0; f < frames; ++f) {
+            for (int i = 0; i < mid->rowCount; ++i) {
+                AdasMidRect part;
+                if (mid->rows[i].len && AdasMidRectIntersect(&part, AdasMidRowRect(mid, i), all))
+                    paths[p]->ops->text(paths[p]->target, mid, i, part);
+            }
+        }
+        elapsed[p] = NowSeconds() - t0;
+    }
+    printf("MID text, full frame: %6.1f us per-pixel glyphs, %6.1f us atlas cell copies (%.0f%%), same pixels: %s\n",
+        elapsed[0] / frames * 1e6, elapsed[1] / frames * 1e6, 100.0 * elapsed[1] / elapsed[0],
+        same ? "yes" : "no");
+    AdasRasterFree(&copied);
+    AdasRasterFree(&proxy.cells);
+}
+
+// full frames per preset, then a slider drag painting only the dirty rows
+static int CmdBenchRender(int argc, char** argv) {
+    int frames = argc > 0 ? atoi(argv[0]) : 2000;
+    if (frames <= 0) {
+        fprintf(stderr, "bench-render: frames must be positive\n");
+        return 1;
+    }
+    AdasRaster raster;
+    if (!AdasRasterInit(&raster, MID_W, MID_H)) return 1;
+    AdasRenderer renderer = AdasRasterRenderer(&raster);
+    AdasMidLayout mid;
+    AdasMidRect all = { 0, 0, MID_W, MID_H };
+    double megapixels = (double)MID_W * MID_H / 1e6;
+    printf("renderer: %s, %dx%d MID\n", renderer.ops->name, MID_W, MID_H);
+
+    for (size_t p = 0; p < sizeof(midPresetNames) / sizeof(midPresetNames[0]); ++p) {
+        RenderPreset(midPresetNames[p], &mid, &raster);
+        int rows = 0;
+        double t0 = NowSeconds();
+        for (int f = 0; f < frames; ++f) rows = AdasMidRender(&mid, &renderer, all);
+        double elapsed = NowSeconds() - t0;
+        printf("full frame, %-4s (%2d rows): %8.0f fps, %7.1f Mpixel/s\n", midPresetNames[p], rows,
+            frames / elapsed, frames * megapixels / elapsed);
+    }
+    BenchPaintPaths(frames, &mid, &raster, &renderer);
+    BenchAtlasProxy(frames, &mid, &raster, &renderer);
+
+    AdasVehicle v;
+    MidPreset(&v, "city");
+    AdasMidRect dirty[8];
+    AdasResult r;
+    AdasMidLayoutInit(&mid, MID_W, MID_H, MID_LINE_H, MID_CHAR_W);
+    uint64_t painted = 0;
+    double t0 = NowSeconds();
+    for (int f = 0; f < frames; ++f) {
+        uint64_t frameStart = AdasProbeStart();
+        DragFrame(&v, f);
+        uint64_t probe = AdasProbeStart();
+        AdasVehicleEvaluateIncremental(&v, &r);
+        AdasProbeStop(ADAS_PROBE_RULES, probe);
+        int n = AdasMidLayoutUpdate(&mid, &v, &r, dirty, 8);
+        for (int k = 0; k < n; ++k) {
+            AdasMidRender(&mid, &renderer, dirty[k]);
+            painted += (uint64_t)(dirty[k].right - dirty[k].left) * (uint64_t)(dirty[k].bottom - dirty[k].top);
+        }
+        AdasProbeStop(ADAS_PROBE_FRAME, frameStart);
+    }
+    double elapsed = NowSeconds() - t0;
+    printf("slider drag, dirty rows only: %8.0f fps (layout + render), %.1f%% of the MID painted per frame\n",
+        frames / elapsed, 100.0 * painted / ((double)frames * MID_W * MID_H));
+    AdasRasterFree(&raster);
+    return 0;
+}
+
+// ---------------- SCENARIO ----------------
+static char* ReadFile(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char* text = size >= 0 ? (char*)malloc((size_t)size + 1) : NULL;
+    if (text) {
+        size_t got = fread(text, 1, (size_t)size, f);
+        text[got] = '\0';
+    }
+    fclose(f);
+    return text;
+}
+
+static void PrintTrace(void* user, const AdasScenarioTrace* t) {
+    (void)user;
+    printf("%10.2f s  prio %d%s ", (double)t->tick * ADAS_TICK_MS / 1000.0, t->priority, t->beep ? " BEEP" : "     ");
+    if (!t->mask) printf(" -");
+    for (int id = 0; id < ADAS_WARN_COUNT; ++id) {
+        if (!(t->mask & ADAS_WARN_BIT(id))) continue;
+        printf(" %s", AdasWarningName((AdasWarningId)id));
+        if (id == ADAS_WARN_FCW && t->fcwTtc) printf("(TTC)");
+        else if (id == ADAS_WARN_FCW)
+            printf("(%d.%02d m)", (int)(t->fcwThresholdCm / ADAS_CM_PER_M), (int)(t->fcwThresholdCm % ADAS_CM_PER_M));
+    }
+    printf("\n");
+}
+
+// replays the script once, recording speed, gap and day/night per tick, then evaluates the FCW
+// threshold of every surface profile over the whole drive in one AdasFcwProfileSweep
+static int SweepProfiles(const AdasScenario* scenario) {
+    size_t ticks = (size_t)scenario->endTick + 1;
+    int32_t* speed = (int32_t*)malloc(ticks * sizeof(int32_t));
+    int32_t* front = (int32_t*)malloc(ticks * sizeof(int32_t));
+    uint8_t* night = (uint8_t*)malloc(ticks);
+    uint8_t* hits = (uint8_t*)malloc(ticks);
+    if (!speed || !front || !night || !hits) {
+        fprintf(stderr, "run: out of memory\n");
+        free(speed); free(front); free(night); free(hits);
+        return 1;
+    }
+    AdasVehicle v;
+    AdasVehicleInit(&v);
+    size_t next = 0;
+    for (size_t tick = 0; tick < ticks; ++tick) {
+        AdasVehicleStep(&v);
+        while (next < scenario->count && scenario->events[next].tick == tick)
+            AdasScenarioApply(&v, &scenario->events[next++]);
+        speed[tick] = v.speed;
+        front[tick] = v.frontDistCm;
+        night[tick] = v.nightMode;
+    }
+    double t0 = NowSeconds();
+    AdasFcwProfileSweep(speed, front, ticks, hits);
+    double elapsed = NowSeconds() - t0;
+
+    // per surface: the script's own day/night, then all day and all night
+    printf("%-6s %18s %18s %18s\n", "road", "FCW as scripted", "all day", "all night");
+    for (int surface = 0; surface < ADAS_SURFACE_COUNT; ++surface) {
+        uint64_t onTicks[3] = { 0, 0, 0 }, onsets[3] = { 0, 0, 0 };
+        bool prev[3] = { false, false, false };
+        for (size_t tick = 0; tick < ticks; ++tick) {
+            bool on[3];
+            on[0] = (hits[tick] >> ADAS_FCW_PROFILE(surface, night[tick])) & 1;
+            on[1] = (hits[tick] >> ADAS_FCW_PROFILE(surface, false)) & 1;
+            on[2] = (hits[tick] >> ADAS_FCW_PROFILE(surface, true)) & 1;
+            for (int k = 0; k < 3; ++k) {
+                onTicks[k] += on[k];
+                onsets[k] += on[k] && !prev[k];
+                prev[k] = on[k];
+            }
+        }
+        printf("%-6s", AdasSurfaceName((AdasSurface)surface));
+        for (int k = 0; k < 3; ++k)
+            printf(" %9.1f s %3llux", (double)onTicks[k] * ADAS_TICK_MS / 1000.0, (unsigned long long)onsets[k]);
+        printf("\n");
+    }
+    printf("%zu ticks x %d profiles in %.3f ms\n", ticks, ADAS_FCW_PROFILE_COUNT, elapsed * 1e3);
+    free(speed); free(front); free(night); free(hits);
+    return 0;
+}
+
+static int CmdRun(int argc, char** argv) {
+    if (argc < 1) {
+        fprintf(stderr, "run: missing scenario file\n");
+        return 1;
+    }
+    bool realtime = false, quiet = false, sweep = false;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--realtime") == 0) realtime = true;
+        else if (strcmp(argv[i], "--quiet") == 0) quiet = true;
+        else if (strcmp(argv[i], "--sweep") == 0) sweep = true;
+    }
+    char* text = ReadFile(argv[0]);
+    if (!text) {
+        fprintf(stderr, "run: cannot read %s\n", argv[0]);
+        return 1;
+    }
+    AdasScenario scenario;
+    char err[128];
+    bool ok = AdasScenarioParse(&scenario, text, err, sizeof(err));
+    free(text);
+    if (!ok) {
+        fprintf(stderr, "run: %s: %s\n", argv[0], err);
+        return 1;
+    }
+
+    if (sweep) {
+        int rc = SweepProfiles(&scenario);
+        AdasScenarioFree(&scenario);
+        return rc;
+    }
+
+    AdasVehicle v;
+    AdasVehicleInit(&v);
+    AdasScenarioStats st;
+    AdasScenarioRun(&scenario, &v, realtime, quiet ? NULL : PrintTrace, NULL, &st);
+    AdasScenarioFree(&scenario);
+
+    double simSeconds = (double)st.ticks * ADAS_TICK_MS / 1000.0;
+    printf("simulated: %.1f s (%llu ticks, %llu events, %llu frames)\n", simSeconds,
+        (unsigned long long)st.ticks, (unsigned long long)st.events, (unsigned long long)st.frames);
+    printf("warning changes: %llu, beep bursts: %llu, trace %016llx\n",
+        (unsigned long long)st.warningChanges, (unsigned long long)st.beeps, (unsigned long long)st.traceHash);
+    printf("wall: %.3f s, %.0fx real time\n", st.wallSeconds,
+        st.wallSeconds > 0 ? simSeconds / st.wallSeconds : 0.0);
+    if (realtime) {
+        printf("clock reads: %llu, %llu of them late (several ticks at once)\n",
+            (unsigned long long)st.wakeups, (unsigned long long)st.bursts);
+    }
+    return 0;
+}
+
+// ---------------- TUI ----------------
+#define TUI_KEY_UP    0x101
+#define TUI_KEY_DOWN  0x102
+#define TUI_KEY_RIGHT 0x103
+#define TUI_KEY_LEFT  0x104
+
+static const char tuiHelp[] =
+    "w/s speed  e/d front  t/g lead  m fcw mode  c road  r/f base  1-4 tyre -2  5 tyres=base  x puncture  h lights  n night  o hands  "
+    "[ ] indicators  b obstacle  l lane  u/i/j/k doors  p timings  q quit";
+
+static int Clamp(int v, int lo, int hi) {
+    return v < lo ? lo : v > hi ? hi : v;
+}
+
+// the window's buttons and sliders as keys; returns true when the key was one of them
+static bool TuiKey(AdasVehicle* v, int key) {
+    switch (key) {
+    case 'w': case TUI_KEY_UP: AdasVehicleSetSpeed(v, Clamp(v->speed + 5, 0, ADAS_SPEED_MAX)); return true;
+    case 's': case TUI_KEY_DOWN: AdasVehicleSetSpeed(v, Clamp(v->speed - 5, 0, ADAS_SPEED_MAX)); return true;
+    case 'e': case TUI_KEY_RIGHT: AdasVehicleSetFrontDistCm(v, Clamp(v->frontDistCm + 500, 0, ADAS_DIST_MAX_CM)); return true;
+    case 'd': case TUI_KEY_LEFT: AdasVehicleSetFrontDistCm(v, Clamp(v->frontDistCm - 500, 0, ADAS_DIST_MAX_CM)); return true;
+    case 't': AdasVehicleSetLeadSpeed(v, Clamp(v->leadSpeed + 5, 0, ADAS_LEAD_SPEED_MAX)); return true;
+    case 'g': AdasVehicleSetLeadSpeed(v, Clamp(v->leadSpeed - 5, 0, ADAS_LEAD_SPEED_MAX)); return true;
+    case 'c': AdasVehicleSetSurface(v, (AdasSurface)((v->surface + 1) % ADAS_SURFACE_COUNT)); return true;
+    case 'm': AdasVehicleSetFcwMode(v, v->fcwMode == ADAS_FCW_TTC ? ADAS_FCW_THRESHOLD : ADAS_FCW_TTC); return true;
+    case 'r': AdasVehicleSetBasePressure(v, Clamp(v->basePressure + 1, ADAS_PSI_MIN, ADAS_PSI_MAX)); return true;
+    case 'f': AdasVehicleSetBasePressure(v, Clamp(v->basePressure - 1, ADAS_PSI_MIN, ADAS_PSI_MAX)); return true;
+    case '1': case '2': case '3': case '4': {
+        int tyre = key - '1';
+        AdasVehicleSetTyrePressure(v, tyre, Clamp(v->tp[tyre] - 2, ADAS_PSI_MIN, ADAS_PSI_MAX));
+        return true;
+    }
+    case '5': AdasVehicleSetBasePressure(v, v->basePressure); return true;
+    case 'x': AdasVehicleNextPuncture(v); return true;
+    case 'h': AdasVehicleToggleHeadlights(v); return true;
+    case 'n': AdasVehicleToggleNightMode(v); return true;
+    case 'o': AdasVehicleToggleHandsOn(v); return true;
+    case '[': AdasVehicleToggleIndicator(v, ADAS_SIDE_LEFT); return true;
+    case ']': AdasVehicleToggleIndicator(v, ADAS_SIDE_RIGHT); return true;
+    case 'b': AdasVehicleToggleDoorObstacle(v); return true;
+    case 'l': AdasVehicleRequestLaneChange(v); return true;
+    case 'u': AdasVehicleToggleDoor(v, 0); return true;
+    case 'i': AdasVehicleToggleDoor(v, 1); return true;
+    case 'j': AdasVehicleToggleDoor(v, 2); return true;
+    case 'k': AdasVehicleToggleDoor(v, 3); return true;
+    }
+    return false;
+}
+
+// one frame: the window's UpdateMID with the terminal as the display; the bell stands in for the beep
+// (input: the frame follows a key, else it only rings for a new warning set)
+static size_t TuiFrame(AdasTui* tui, AdasVehicle* v, char* buf, bool input) {
+    AdasResult r;
+    uint64_t probe = AdasProbeStart();
+    AdasVehicleEvaluateIncremental(v, &r);
+    AdasProbeStop(ADAS_PROBE_RULES, probe);
+    size_t n = 0;
+    if (r.priority > 0 && (input || AdasMidWarningsChanged(&tui->mid, &r)) && AdasVehicleBeepDue(v, r.priority))
+        buf[n++] = '\a';
+    return n + AdasTuiFrame(tui, v, &r, buf + n, ADAS_TUI_FRAME_MAX);
+}
+
+#ifdef _WIN32
+static int CmdTui(int argc, char** argv) {
+    (void)argc; (void)argv;
+    fprintf(stderr, "tui: needs a POSIX terminal; on Windows use the window\n");
+    return 1;
+}
+#else
+static volatile sig_atomic_t tuiQuit = 0, tuiResized = 0;
+
+static void TuiSignal(int sig) {
+    if (sig == SIGWINCH) tuiResized = 1;
+    else tuiQuit = 1;
+}
+
+static void WriteAll(const char* p, size_t n) {
+    while (n > 0) {
+        ssize_t w = write(STDOUT_FILENO, p, n);
+        if (w <= 0) return;
+        p += w;
+        n -= (size_t)w;
+    }
+}
+
+// reads pending keys; arrow keys arrive as ESC [ A..D
+static int TuiReadKeys(int* keys, int max) {
+    unsigned char b[64];
+    ssize_t n = read(STDIN_FILENO, b, sizeof(b));
+    int count = 0;
+    for (ssize_t i = 0; i < n && count < max; ++i) {
+        if (b[i] == 0x1b && i + 2 < n && b[i + 1] == '[' && b[i + 2] >= 'A' && b[i + 2] <= 'D') {
+            static const int arrows[] = { TUI_KEY_UP, TUI_KEY_DOWN, TUI_KEY_RIGHT, TUI_KEY_LEFT };
+            keys[count++] = arrows[b[i + 2] - 'A'];
+            i += 2;
+        } else {
+            keys[count++] = b[i];
+        }
+    }
+    return count;
+}
+
+// 'p': frame and text percentiles so far, in place of the key help
+static void TuiProbeFooter(AdasTui* tui) {
+    AdasProbeHistogram frame, text;
+    char line[ADAS_TUI_FOOTER_CHARS];
+    AdasProbeCollect();
+    AdasProbeHistogramOf(ADAS_PROBE_FRAME, &frame);
+    AdasProbeHistogramOf(ADAS_PROBE_TEXT, &text);
+    snprintf(line, sizeof(line), "frame p50 %.1f us p99 %.1f us max %.1f us | text p99 %.1f us | %llu frames",
+        AdasProbePercentile(&frame, 50) / 1e3, AdasProbePercentile(&frame, 99) / 1e3, frame.maxNs / 1e3,
+        AdasProbePercentile(&text, 99) / 1e3, (unsigned long long)frame.count);
+    AdasTuiSetFooter(tui, line);
+}
+
+static int CmdTui(int argc, char** argv) {
+    const char* script = NULL;
+    uint32_t hz = 30;
+    bool color = getenv("NO_COLOR") == NULL;
+    for (int i = 0; i < argc; ++i) {
+        if (strcmp(argv[i], "--hz") == 0 && i + 1 < argc) hz = (uint32_t)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--mono") == 0) color = false;
+        else script = argv[i];
+    }
+
+    AdasScenario scenario;
+    AdasScenarioInit(&scenario);
+    if (script) {
+        char* text = ReadFile(script);
+        char err[128];
+        if (!text) {
+            fprintf(stderr, "tui: cannot read %s\n", script);
+            return 1;
+        }
+        bool ok = AdasScenarioParse(&scenario, text, err, sizeof(err));
+        free(text);
+        if (!ok) {
+            fprintf(stderr, "tui: %s: %s\n", script, err);
+            return 1;
+        }
+    }
+
+    // keys only when stdin is a terminal; a script also runs with stdin redirected
+    bool keys = isatty(STDIN_FILENO) != 0;
+    struct termios saved;
+    if (keys) {
+        struct termios raw;
+        tcgetattr(STDIN_FILENO, &saved);
+        raw = saved;
+        raw.c_lflag &= ~(tcflag_t)(ICANON | ECHO);
+        raw.c_cc[VMIN] = 0;
+        raw.c_cc[VTIME] = 0;
+        tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+    }
+    signal(SIGINT, TuiSignal);
+    signal(SIGTERM, TuiSignal);
+    signal(SIGWINCH, TuiSignal);
+
+    AdasVehicle v;
+    AdasVehicleInit(&v);
+    AdasClock clock;
+    AdasClockInit(&clock);
+    AdasFrameScheduler frames;
+    AdasFrameInit(&frames, hz);
+    static AdasTui tui;
+    AdasTuiInit(&tui, color);
+    AdasTuiSetFooter(&tui, keys ? tuiHelp : "q or Ctrl-C quits");
+    static char buf[ADAS_TUI_FRAME_MAX + 1];
+
+    uint64_t tick = 0;
+    size_t next = 0;
+    AdasFrameRequest(&frames, false);
+    while (!tuiQuit) {
+        // sleep until a key arrives, the next tick is due or a pending frame's interval ends
+        // (at 120 Hz the interval is shorter than a tick)
+        fd_set fds;
+        FD_ZERO(&fds);
+        if (keys) FD_SET(STDIN_FILENO, &fds);
+        uint64_t frameWaitNs;
+        AdasFrameDue(&frames, AdasNowNs(), &frameWaitNs);
+        long waitUs = ADAS_TICK_MS * 1000;
+        if (frameWaitNs / 1000 < (uint64_t)waitUs) waitUs = (long)(frameWaitNs / 1000);
+        struct timeval tv = { 0, waitUs };
+        int ready = select(keys ? STDIN_FILENO + 1 : 0, keys ? &fds : NULL, NULL, NULL, &tv);
+        if (ready > 0 && FD_ISSET(STDIN_FILENO, &fds)) {
+            int pressed[64];
+            int count = TuiReadKeys(pressed, 64);
+            for (int k = 0; k < count; ++k) {
+                if (pressed[k] == 'q' || pressed[k] == 'Q') tuiQuit = 1;
+                else if (pressed[k] == 'p') TuiProbeFooter(&tui);
+                else if (TuiKey(&v, pressed[k])) AdasFrameRequest(&frames, true);
+            }
+        }
+
+        // timers, then the script events of each tick, as in AdasScenarioRun
+        uint32_t due = AdasClockDue(&clock, AdasNowNs());
+        for (uint32_t i = 0; i < due; ++i) {
+            bool changed = AdasVehicleStep(&v);
+            tick++;
+            // probe rings fold into the histograms here, between frames, as on the window's timer
+            if (tick % 25 == 0) AdasProbeCollect();
+            while (next < scenario.count && scenario.events[next].tick <= tick) {
+                AdasScenarioApply(&v, &scenario.events[next++]);
+                changed = true;
+            }
+            if (changed) AdasFrameRequest(&frames, false);
+        }
+        if (script && next == scenario.count && tick > scenario.endTick) {
+            AdasTuiSetFooter(&tui, "scenario finished; q quits");
+            AdasFrameRequest(&frames, false);
+            script = NULL;
+        }
+        if (tuiResized) {
+            tuiResized = 0;
+            AdasTuiInvalidate(&tui);
+            AdasFrameRequest(&frames, false);
+        }
+
+        uint64_t now = AdasNowNs();
+        if (AdasFrameDue(&frames, now, NULL)) {
+            WriteAll(buf, TuiFrame(&tui, &v, buf, frames.frameInputs > 0));
+            uint64_t end = AdasNowNs();
+            AdasProbeRecord(ADAS_PROBE_FRAME, end - now);
+            AdasFrameDone(&frames, now, end);
+        }
+    }
+
+    WriteAll(buf, AdasTuiRestore(&tui, buf, sizeof(buf)));
+    if (keys) tcsetattr(STDIN_FILENO, TCSANOW, &saved);
+    AdasScenarioFree(&scenario);
+
+    const AdasTuiStats* st = &tui.stats;
+    if (st->frames) {
+        printf("frames: %llu, lines written per frame: %.2f, bytes per frame: %.0f (full redraw: %.0f)\n",
+            (unsigned long long)st->frames, (double)st->linesWritten / st->frames,
+            (double)st->bytes / st->frames, (double)st->fullBytes / st->frames);
+    }
+    return 0;
+}
+#endif
+
+// a slider drag with indicator blink, frames into a buffer: bytes a terminal would receive
+static int CmdBenchTui(int argc, char** argv) {
+    int count = argc > 0 ? atoi(argv[0]) : 100000;
+    if (count <= 0) {
+        fprintf(stderr, "bench-tui: frames must be positive\n");
+        return 1;
+    }
+    static AdasTui tui;
+    static char buf[ADAS_TUI_FRAME_MAX + 1];
+    AdasTuiInit(&tui, true);
+    AdasTuiSetFooter(&tui, tuiHelp);
+    AdasVehicle v;
+    MidPreset(&v, "city");
+    AdasVehicleToggleIndicator(&v, ADAS_SIDE_LEFT);
+    TuiFrame(&tui, &v, buf, true);
+    tui.stats = (AdasTuiStats){ 0, 0, 0, 0 };
+
+    double t0 = NowSeconds();
+    for (int f = 0; f < count; ++f) {
+        // one 30 Hz frame: three 10 ms ticks, then the slider position of this frame
+        for (int i = 0; i < 3; ++i) AdasVehicleStep(&v);
+        DragFrame(&v, f);
+        TuiFrame(&tui, &v, buf, true);
+    }
+    double elapsed = NowSeconds() - t0;
+
+    const AdasTuiStats* st = &tui.stats;
+    printf("frames: %llu (%.0f ns each)\n", (unsigned long long)st->frames, elapsed / count * 1e9);
+    printf("lines written per frame: %.2f of %d\n", (double)st->linesWritten / st->frames, tui.lineCount);
+    printf("bytes per frame: %.1f, full redraw %.1f (%.1f%%); at 30 Hz %.1f kbit/s\n",
+        (double)st->bytes / st->frames, (double)st->fullBytes / st->frames,
+        100.0 * st->bytes / st->fullBytes, (double)st->bytes / st->frames * 30 * 8 / 1000);
+    return 0;
+}
+
+// ---------------- BENCH AUDIO ----------------
+// the old way: a new thread per beep burst, playing the pattern itself
+typedef struct BurstThread {
+    int priority;
+    uint64_t startNs;
+    uint64_t latencyNs;
+} BurstThread;
+
+static void BurstThreadFn(void* arg) {
+    BurstThread* b = (BurstThread*)arg;
+    b->latencyNs = AdasNowNs() - b->startNs;
+    const AdasBeepPattern* p = AdasBeepPatternFor(b->priority);
+    for (int i = 0; i < p->count; ++i) NullTone(NULL, p->steps[i].freq, p->steps[i].ms);
+}
+
+static int CmdBenchAudio(int argc, char** argv) {
+    int count = argc > 0 ? atoi(argv[0]) : 20000;
+    if (count <= 0) {
+        fprintf(stderr, "bench-audio: alerts must be positive\n");
+        return 1;
+    }
+    // silent sink and no gaps: only the cost of getting an alert to the audio thread is left
+    uint64_t threadNs = 0, threadLatency = 0, threadMax = 0;
+    for (int i = 0; i < count; ++i) {
+        BurstThread b = { 1 + i % 3, AdasNowNs(), 0 };
+        AdasThread t;
+        if (AdasThreadStart(&t, BurstThreadFn, &b) != 0) {
+            fprintf(stderr, "bench-audio: thread start failed\n");
+            return 1;
+        }
+        threadNs += AdasNowNs() - b.startNs;
+        AdasThreadJoin(&t);
+        threadLatency += b.latencyNs;
+        if (b.latencyNs > threadMax) threadMax = b.latencyNs;
+    }
+
+    static AdasAudio audio;
+    AdasAudioSink sink = { NullTone, NULL, NULL, 1000000 };
+    if (AdasAudioStart(&audio, &sink) != 0) {
+        fprintf(stderr, "bench-audio: audio worker failed to start\n");
+        return 1;
+    }
+    uint64_t enqueueNs = 0;
+    for (int i = 0; i < count; ++i) {
+        uint64_t t0 = AdasNowNs();
+        AdasAudioEnqueue(&audio, 1 + i % 3);
+        enqueueNs += AdasNowNs() - t0;
+        // one burst at a time, like the 800 ms beep spacing
+        while (!AdasAudioIdle(&audio)) AdasSleepMs(0);
+    }
+    AdasAudioStop(&audio);
+    const AdasAudioStats* st = &audio.stats;
+
+    printf("alerts: %d\n", count);
+    printf("thread per burst: %d threads, %.1f us to start each, %.1f us avg / %.1f us max to first tone\n",
+        count, threadNs / 1e3 / count, threadLatency / 1e3 / count, threadMax / 1e3);
+    printf("audio worker:     %u thread, %.2f us to enqueue, %.1f us avg / %.1f us max to first tone\n",
+        st->threadsStarted, enqueueNs / 1e3 / count,
+        st->latencyCount ? st->latencyTotalNs / 1e3 / st->latencyCount : 0.0, st->latencyMaxNs / 1e3);
+    printf("played %llu, dropped %llu\n", (unsigned long long)st->played, (unsigned long long)st->dropped);
+    return 0;
+}
+
+// ---------------- RENDER AUDIO ----------------
+static int CmdRenderAudio(int argc, char** argv) {
+    if (argc < 1) {
+        fprintf(stderr, "render-audio: missing output file (.wav)\n");
+        return 1;
+    }
+    // default: low, then medium with a high alert in its gap
+    static const AdasAlertEvent demo[] = { { 0, ADAS_PRIO_LOW }, { 1000, ADAS_PRIO_MEDIUM }, { 1300, ADAS_PRIO_HIGH } };
+    AdasAlertEvent events[64];
+    size_t count = 0;
+    for (int i = 1; i < argc && count < 64; ++i) {
+        unsigned ms;
+        int prio;
+        if (sscanf(argv[i], "%u:%d", &ms, &prio) != 2 || prio < ADAS_PRIO_LOW || prio > ADAS_PRIO_HIGH
+            || (count && ms < events[count - 1].ms)) {
+            fprintf(stderr, "render-audio: bad event %s (ms:priority, priority 1..3, ms ascending)\n", argv[i]);
+            return 1;
+        }
+        events[count].ms = ms;
+        events[count].priority = prio;
+        count++;
+    }
+    if (!count) {
+        memcpy(events, demo, sizeof(demo));
+        count = sizeof(demo) / sizeof(demo[0]);
+    }
+
+    AdasSynth synth;
+    if (!AdasSynthInit(&synth)) return 1;
+    int16_t* pcm = NULL;
+    static AdasMixer mixed;
+    size_t samples = AdasSynthRenderTimeline(&synth, events, count, &pcm, &mixed);
+    size_t size = 0;
+    uint8_t* data = pcm ? AdasWavEncode(pcm, samples, &size) : NULL;
+    FILE* f = data ? fopen(argv[0], "wb") : NULL;
+    bool ok = f && fwrite(data, 1, size, f) == size;
+    if (f && fclose(f) != 0) ok = false;
+    free(data);
+
+    printf("%s: %zu samples at %d Hz (%.3f s)\n", argv[0], samples, ADAS_SYNTH_RATE, (double)samples / ADAS_SYNTH_RATE);
+    size_t starts[64], ends[64];
+    size_t tones = ToneSegments(pcm, samples, &mixed, starts, ends, 64);
+    for (size_t i = 0; i < tones && i < 64; ++i)
+        printf("  tone %2zu: samples %7zu..%7zu  (%8.3f ms, %7.3f ms long)\n", i, starts[i], ends[i],
+            starts[i] * 1000.0 / ADAS_SYNTH_RATE, (ends[i] - starts[i]) * 1000.0 / ADAS_SYNTH_RATE);
+    free(pcm);
+    AdasSynthFree(&synth);
+    if (!ok) {
+        fprintf(stderr, "render-audio: cannot write %s\n", argv[0]);
+        return 1;
+    }
+    return 0;
+}
+
+// ---------------- ENTRY POINT ----------------
+static void Usage(void) {
+    fprintf(stderr,
+        "usage: adas_headless [--probe] <command> [args]\n"
+        "  bench [states] [rounds]   batch rule evaluation throughput\n"
+        "  bench-fcw [count] [rounds] SIMD FCW kernel vs scalar loop\n"
+        "  bench-ttc [vehicles] [seconds]  TTC model steps at 1 kHz, batched vs per vehicle\n"
+        "  bench-tpms [vehicles] [seconds] tyre sensors at 10 Hz: leak detector cost and hit rate\n"
+        "  gen-fcw-table [reaction] [mu]  threshold table initializer for ADAS_Fcw.c\n"
+        "  check                     self-checks\n"
+        "  soak [vehicles] [threads] [seconds]  parallel multi-vehicle soak\n"
+        "  bench-incr [frames]       incremental vs full evaluation per frame\n"
+        "  bench-mid [updates]       MID rows and area invalidated per update\n"
+        "  bench-frames [seconds] [input us]  frame scheduler at 30/60/120 Hz during a slider drag\n"
+        "  render <out.ppm|out.png> [idle|city|all]  software-render the MID to an image\n"
+        "  bench-render [frames]     software MID renderer frames per second\n"
+        "  tui [scenario] [--hz N] [--mono]  the MID in a terminal (keys or a scenario script)\n"
+        "  bench-tui [frames]        terminal bytes per frame vs full redraw\n"
+        "  bench-audio [alerts]      audio worker vs a thread per beep burst\n"
+        "  render-audio <out.wav> [ms:priority ...]  PCM alert timeline to a WAV file\n"
+        "  run <scenario> [--realtime] [--quiet] [--sweep]  replay a scripted scenario on the simulation clock\n"
+        "                            (--sweep: FCW time on every road surface, day and night)\n");
+}
+
+// --probe: recording threads never drain their rings, so this thread collects every millisecond
+static AdasThread probeCollector;
+static AdasEvent probeCollectorStop;
+
+static void ProbeCollectorThread(void* arg) {
+    (void)arg;
+    while (!AdasEventWait(&probeCollectorStop, 1)) AdasProbeCollect();
+}
+
+static void PrintProbeReport(void) {
+    static char report[2048];
+    fflush(stdout);
+    if (probeCollector.handle) {
+        AdasEventSignal(&probeCollectorStop);
+        AdasThreadJoin(&probeCollector);
+    }
+    AdasProbeReport(report, sizeof(report));
+    fprintf(stderr, "\n%s", report);
+}
+
+int main(int argc, char** argv) {
+    AdasRulesInit();
+    if (argc >= 2 && strcmp(argv[1], "--probe") == 0) {
+        if (AdasEventInit(&probeCollectorStop) == 0)
+            AdasThreadStart(&probeCollector, ProbeCollectorThread, NULL);
+        atexit(PrintProbeReport);
+        argv[1] = argv[0];
+        argc--;
+        argv++;
+    }
+    if (argc < 2) {
+        Usage();
+        return 1;
+    }
+    if (strcmp(argv[1], "bench") == 0) return CmdBench(argc - 2, argv + 2);
+    if (strcmp(argv[1], "bench-fcw") == 0) return CmdBenchFcw(argc - 2, argv + 2);
+    if (strcmp(argv[1], "bench-ttc") == 0) return CmdBenchTtc(argc - 2, argv + 2);
+    if (strcmp(argv[1], "bench-tpms") == 0) return CmdBenchTpms(argc - 2, argv + 2);
+    if (strcmp(argv[1], "gen-fcw-table") == 0) return CmdGenFcwTable(argc - 2, argv + 2);
+    if (strcmp(argv[1], "check") == 0) return CmdCheck();
+    if (strcmp(argv[1], "soak") == 0) return CmdSoak(argc - 2, argv + 2);
+    if (strcmp(argv[1], "bench-incr") == 0) return CmdBenchIncr(argc - 2, argv + 2);
+    if (strcmp(argv[1], "bench-mid") == 0) return CmdBenchMid(argc - 2, argv + 2);
+    if (strcmp(argv[1], "bench-frames") == 0) return CmdBenchFrames(argc - 2, argv + 2);
+    if (strcmp(argv[1], "render") == 0) return CmdRender(argc - 2, argv + 2);
+    if (strcmp(argv[1], "bench-render") == 0) return CmdBenchRender(argc - 2, argv + 2);
+    if (strcmp(argv[1], "tui") == 0) return CmdTui(argc - 2, argv + 2);
+    if (strcmp(argv[1], "bench-tui") == 0) return CmdBenchTui(argc - 2, argv + 2);
+    if (strcmp(argv[1], "bench-audio") == 0) return CmdBenchAudio(argc - 2, argv + 2);
+    if (strcmp(argv[1], "render-audio") == 0) return CmdRenderAudio(argc - 2, argv + 2);
+    if (strcmp(argv[1], "run") == 0) return CmdRun(argc - 2, argv + 2);
+
+    Usage();
+    return 1;
+}
@@ -0,0 +1,54 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Per-priority token bucket alert limiter (see ADAS_Limiter.h).
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Limiter.c
+*/
+#include "ADAS_Limiter.h"
+
+#include <string.h>
+
+#include "ADAS_Platform.h"
+
+void AdasLimiterInit(AdasAlertLimiter* l, uint64_t interval, uint32_t burst) {
+    memset(l, 0, sizeof(*l));
+    l->interval = interval;
+    l->slack = (burst > 1 ? burst - 1 : 0) * interval;
+}
+
+// raises *p to at least v
+static void AtomicMax64(volatile uint64_t* p, uint64_t v) {
+    for (;;) {
+        uint64_t cur = AdasAtomicLoad64(p);
+        if (cur >= v || AdasAtomicCas64(p, cur, v)) return;
+    }
+}
+
+bool AdasLimiterAllow(AdasAlertLimiter* l, int priority, uint64_t now) {
+    if (priority < ADAS_PRIO_LOW) return false;
+    if (priority > ADAS_PRIO_HIGH) priority = ADAS_PRIO_HIGH;
+    volatile uint64_t* next = &l->next[priority - 1];
+    for (;;) {
+        uint64_t at = AdasAtomicLoad64(next);
+        if (at > now + l->slack) {
+            AdasAtomicAdd64(&l->dropped[priority - 1], 1);
+            return false;
+        }
+        // the bucket refills from now if it has been full for a while
+        if (AdasAtomicCas64(next, at, (at > now ? at : now) + l->interval)) break;
+    }
+    // lower priorities wait a full interval from this alert, as after one of their own
+    for (int p = ADAS_PRIO_LOW; p < priority; ++p) AtomicMax64(&l->next[p - 1], now + l->interval);
+    AdasAtomicAdd64(&l->emitted[priority - 1], 1);
+    return true;
+}
+
+uint64_t AdasLimiterEmitted(const AdasAlertLimiter* l, int priority) {
+    if (priority < ADAS_PRIO_LOW || priority > ADAS_PRIO_HIGH) return 0;
+    return AdasAtomicLoad64(&l->emitted[priority - 1]);
+}
+
+uint64_t AdasLimiterDropped(const AdasAlertLimiter* l, int priority) {
+    if (priority < ADAS_PRIO_LOW || priority > ADAS_PRIO_HIGH) return 0;
+    return AdasAtomicLoad64(&l->dropped[priority - 1]);
+}
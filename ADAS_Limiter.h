@@ -0,0 +1,35 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Lock-free alert rate limiter: one token bucket per warning priority.
+   - Each bucket is a single 64-bit "next allowed time" (GCRA form of a token bucket), updated
+     with compare-and-swap, so any number of threads can share one limiter without a lock.
+   - Priorities have separate buckets: a higher priority is never held back by a lower
+     priority's cooldown. An emitted alert also restarts the cooldown of every lower priority,
+     so a low beep cannot follow straight after a high one.
+   - Emitted and dropped counters per priority.
+   - Time comes from the caller in any unit (simulation ticks in the vehicle, ns in the soak).
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Limiter.h
+*/
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ADAS_Rules.h"
+
+typedef struct AdasAlertLimiter {
+    uint64_t interval;                      // time per token
+    uint64_t slack;                         // (burst - 1) * interval
+    volatile uint64_t next[ADAS_PRIO_HIGH]; // earliest time each priority's bucket has a token
+    volatile uint64_t emitted[ADAS_PRIO_HIGH];
+    volatile uint64_t dropped[ADAS_PRIO_HIGH];
+} AdasAlertLimiter;
+
+// ---------------- FUNCTION DECLARATIONS ----------------
+// burst = alerts a priority may emit back to back after a quiet period (at least 1)
+void AdasLimiterInit(AdasAlertLimiter* l, uint64_t interval, uint32_t burst);
+// takes a token for priority at time now; false (and counted as dropped) when the bucket is empty
+bool AdasLimiterAllow(AdasAlertLimiter* l, int priority, uint64_t now);
+uint64_t AdasLimiterEmitted(const AdasAlertLimiter* l, int priority);
+uint64_t AdasLimiterDropped(const AdasAlertLimiter* l, int priority);
@@ -0,0 +1,284 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: MID line model (see ADAS_Mid.h). Row layout matches what DrawMID used to draw
+   with DrawText: header rows from the top-left, warnings block inset below it.
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Mid.c
+*/
+
+#include "ADAS_Mid.h"
+#include "ADAS_Probe.h"
+
+#include <string.h>
+
+// ---------------- INIT ----------------
+void AdasMidLayoutInit(AdasMidLayout* m, int width, int height, int lineHeight, int charWidth) {
+    memset(m, 0, sizeof(*m));
+    m->width = width;
+    m->height = height;
+    m->lineHeight = lineHeight > 0 ? lineHeight : 1;
+    m->charWidth = charWidth > 0 ? charWidth : 1;
+}
+
+AdasMidRect AdasMidRowRect(const AdasMidLayout* m, int row) {
+    AdasMidRect r = { 0, 0, 0, 0 };
+    if (row < 0 || row >= m->rowCount) return r;
+    // rows span the MID width so the background behind shorter text is repainted too
+    r.left = 0;
+    r.right = m->width;
+    r.top = m->rows[row].y;
+    r.bottom = r.top + m->lineHeight;
+    if (r.bottom > m->height) r.bottom = m->height;
+    if (r.top > r.bottom) r.top = r.bottom;
+    return r;
+}
+
+// ---------------- ROWS ----------------
+static void SetRow(AdasMidRow* row, const wchar_t* text, int len, int x, int y, AdasMidColor color) {
+    if (len < 0) len = 0;
+    if (len > ADAS_MID_ROW_CHARS - 1) len = ADAS_MID_ROW_CHARS - 1;
+    memcpy(row->text, text, (size_t)len * sizeof(wchar_t));
+    row->text[len] = L'\0';
+    row->len = len;
+    row->x = x;
+    row->y = y;
+    row->color = color;
+}
+
+// fixed header text; NULL rows are segments
+static const wchar_t* const headerFixed[ADAS_MID_HEADER_ROWS] = {
+    L"           RK",
+    L"----------------------------------------",
+    L"", NULL, NULL, L"", NULL, NULL, L"", NULL, NULL, L"", NULL, L"", NULL, NULL, NULL, L"",
+};
+
+// AdasSurfaceName as wide strings for swprintf
+static const wchar_t* const surfaceNames[ADAS_SURFACE_COUNT] = { L"DRY", L"WET", L"SNOW", L"ICE" };
+
+// header row of each segment
+static const int segmentRow[ADAS_MID_SEG_COUNT] = { 3, 4, 6, 7, 9, 10, 12, 14, 15, 16 };
+
+int AdasMidSegmentRow(AdasMidSegment seg) {
+    return (unsigned)seg < ADAS_MID_SEG_COUNT ? segmentRow[seg] : -1;
+}
+
+// everything a segment shows, packed into one integer
+static uint64_t SegmentKey(AdasMidSegment seg, const AdasVehicle* v, const AdasResult* res) {
+    switch (seg) {
+    case ADAS_MID_SEG_SPEED: return (uint32_t)v->speed;
+    case ADAS_MID_SEG_FRONT:
+        return (uint32_t)v->frontDistCm | (uint64_t)(uint32_t)v->leadSpeed << 32 | (uint64_t)v->fcwMode << 63;
+    case ADAS_MID_SEG_TPMS_BASE: return (uint32_t)v->basePressure;
+    case ADAS_MID_SEG_TPMS_TYRES:
+        return (uint64_t)(uint16_t)v->tp[0] | (uint64_t)(uint16_t)v->tp[1] << 16
+            | (uint64_t)(uint16_t)v->tp[2] << 32 | (uint64_t)(uint16_t)v->tp[3] << 48;
+    case ADAS_MID_SEG_LIGHTS: return (uint64_t)v->headlights | (uint64_t)v->nightMode << 1;
+    case ADAS_MID_SEG_HANDS: return v->handsOn;
+    case ADAS_MID_SEG_FCW:
+        if (v->fcwMode == ADAS_FCW_TTC) return (uint64_t)1 << 63 | AdasFollowTenths(&v->follow);
+        return (uint32_t)res->fcwThresholdCm | (uint64_t)v->surface << 32;
+    case ADAS_MID_SEG_OBSTACLE: return v->doorObstacle;
+    case ADAS_MID_SEG_DOORS:
+        return (uint64_t)v->doorOpen[0] | (uint64_t)v->doorOpen[1] << 1
+            | (uint64_t)v->doorOpen[2] << 2 | (uint64_t)v->doorOpen[3] << 3;
+    case ADAS_MID_SEG_INDICATORS: return (uint64_t)v->leftInd | (uint64_t)v->rightInd << 1;
+    default: return 0;
+    }
+}
+
+static int FormatSegment(AdasMidSegment seg, const AdasVehicle* v, const AdasResult* res, wchar_t* line) {
+    switch (seg) {
+    case ADAS_MID_SEG_SPEED: return swprintf(line, ADAS_MID_ROW_CHARS, L"Speed: %d km/h", v->speed);
+    case ADAS_MID_SEG_FRONT:
+        if (v->fcwMode == ADAS_FCW_TTC)
+            return swprintf(line, ADAS_MID_ROW_CHARS, L"Front: %d.%02d m | Lead: %d km/h",
+                (int)(v->frontDistCm / ADAS_CM_PER_M), (int)(v->frontDistCm % ADAS_CM_PER_M), v->leadSpeed);
+        return swprintf(line, ADAS_MID_ROW_CHARS, L"Front: %d.%02d m",
+            (int)(v->frontDistCm / ADAS_CM_PER_M), (int)(v->frontDistCm % ADAS_CM_PER_M));
+    case ADAS_MID_SEG_TPMS_BASE: return swprintf(line, ADAS_MID_ROW_CHARS, L"TPMS Base: %d PSI", v->basePressure);
+    case ADAS_MID_SEG_TPMS_TYRES:
+        return swprintf(line, ADAS_MID_ROW_CHARS, L"T1:%d  T2:%d  T3:%d  T4:%d", v->tp[0], v->tp[1], v->tp[2], v->tp[3]);
+    case ADAS_MID_SEG_LIGHTS:
+        return swprintf(line, ADAS_MID_ROW_CHARS, L"Headlights: %ls | Mode: %ls",
+            v->headlights ? L"ON" : L"OFF", v->nightMode ? L"NIGHT" : L"DAY");
+    case ADAS_MID_SEG_HANDS: return swprintf(line, ADAS_MID_ROW_CHARS, L"Hands On Steering: %ls", v->handsOn ? L"YES" : L"NO");
+    case ADAS_MID_SEG_FCW:
+        if (v->fcwMode == ADAS_FCW_TTC && v->follow.ttc >= ADAS_TTC_NONE)
+            return swprintf(line, ADAS_MID_ROW_CHARS, L"FCW TTC: -- | Brake: 0.0 m/s2");
+        if (v->fcwMode == ADAS_FCW_TTC)
+            return swprintf(line, ADAS_MID_ROW_CHARS, L"FCW TTC: %.1f s | Brake: %.1f m/s2",
+                (int)(v->follow.ttc * 10.0f) / 10.0, (int)(v->follow.reqDecel * 10.0f) / 10.0);
+        return swprintf(line, ADAS_MID_ROW_CHARS, L"FCW Threshold: %d.%02d m (capped at %d m) | %ls",
+            (int)(res->fcwThresholdCm / ADAS_CM_PER_M), (int)(res->fcwThresholdCm % ADAS_CM_PER_M), MAX_COLLISION_THRESHOLD, surfaceNames[(unsigned)v->surface < ADAS_SURFACE_COUNT ? v->surface : 0]);
+    case ADAS_MID_SEG_OBSTACLE: return swprintf(line, ADAS_MID_ROW_CHARS, L"Obstacles near Door: %ls", v->doorObstacle ? L"ON" : L"OFF");
+    case ADAS_MID_SEG_DOORS:
+        return swprintf(line, ADAS_MID_ROW_CHARS, L"Doors: FL:%ls FR:%ls RL:%ls RR:%ls",
+            v->doorOpen[0] ? L"OPEN" : L"CLOSED", v->doorOpen[1] ? L"OPEN" : L"CLOSED",
+            v->doorOpen[2] ? L"OPEN" : L"CLOSED", v->doorOpen[3] ? L"OPEN" : L"CLOSED");
+    case ADAS_MID_SEG_INDICATORS:
+        return swprintf(line, ADAS_MID_ROW_CHARS, L"Indicators: %ls %ls", v->leftInd ? L"LEFT" : L"-", v->rightInd ? L"RIGHT" : L"-");
+    default: return 0;
+    }
+}
+
+// brings the header rows up to date in place; marks the rows that changed
+static void UpdateHeader(AdasMidLayout* m, const AdasVehicle* v, const AdasResult* res, bool* changed) {
+    if (!m->headerValid) {
+        for (int i = 0; i < ADAS_MID_HEADER_ROWS; ++i) {
+            const wchar_t* text = headerFixed[i] ? headerFixed[i] : L"";
+            SetRow(&m->rows[i], text, (int)wcslen(text), 0, i * m->lineHeight, ADAS_MID_COLOR_HEADER);
+            m->rows[i].version = ++m->nextVersion;
+            changed[i] = true;
+        }
+    }
+    for (int seg = 0; seg < ADAS_MID_SEG_COUNT; ++seg) {
+        uint64_t key = SegmentKey((AdasMidSegment)seg, v, res);
+        if (m->headerValid && key == m->segmentKey[seg]) {
+            m->stats.segmentsReused++;
+            continue;
+        }
+        wchar_t line[ADAS_MID_ROW_CHARS];
+        int row = segmentRow[seg];
+        int len = FormatSegment((AdasMidSegment)seg, v, res, line);
+        SetRow(&m->rows[row], line, len, 0, row * m->lineHeight, ADAS_MID_COLOR_HEADER);
+        m->rows[row].version = ++m->nextVersion;
+        m->segmentKey[seg] = key;
+        changed[row] = true;
+        m->stats.segmentsFormatted++;
+    }
+    m->headerValid = true;
+}
+
+int AdasMidWrapColumns(const AdasMidLayout* m) {
+    int cols = (m->width - 2 * ADAS_MID_WARN_INSET) / m->charWidth;
+    if (cols < 1) cols = 1;
+    if (cols > ADAS_MID_ROW_CHARS - 1) cols = ADAS_MID_ROW_CHARS - 1;
+    return cols;
+}
+
+// greedy word wrap for a monospaced font, as DrawText(DT_WORDBREAK) does it: break at the last
+// space that fits (spaces at the break are dropped), or hard-break a word longer than the row
+int AdasMidWrapLines(const AdasMidLayout* m, const wchar_t* text, int len, int* starts, int* lens, int maxLines) {
+    int cols = AdasMidWrapColumns(m);
+    int n = 0;
+    int pos = 0;
+    do {
+        int take = len - pos;
+        if (take > cols) {
+            take = cols;
+            for (int i = pos + cols; i > pos; --i) {
+                if (text[i] == L' ') { take = i - pos; break; }
+            }
+        }
+        if (n >= maxLines) break;
+        starts[n] = pos;
+        lens[n] = take;
+        n++;
+        pos += take;
+        while (pos < len && text[pos] == L' ') pos++;
+    } while (pos < len);
+    return n;
+}
+
+static int WrapRows(AdasMidLayout* m, AdasMidRow* rows, int first, const wchar_t* text, int len, int x, int* y) {
+    int starts[ADAS_MID_MAX_ROWS], lens[ADAS_MID_MAX_ROWS];
+    int lines = AdasMidWrapLines(m, text, len, starts, lens, ADAS_MID_MAX_ROWS - first);
+    int n = first;
+    for (int i = 0; i < lines; ++i) {
+        SetRow(&rows[n++], text + starts[i], lens[i], x, *y, ADAS_MID_COLOR_WARNING);
+        *y += m->lineHeight;
+    }
+    return n;
+}
+
+static bool RowEqual(const AdasMidRow* a, const AdasMidRow* b) {
+    return a->len == b->len && a->x == b->x && a->y == b->y && a->color == b->color
+        && memcmp(a->text, b->text, (size_t)a->len * sizeof(wchar_t)) == 0;
+}
+
+// ---------------- UPDATE ----------------
+bool AdasMidWarningsChanged(const AdasMidLayout* m, const AdasResult* res) {
+    AdasWarningSet set;
+    AdasWarningSetFromResult(&set, res);
+    return !m->warningsValid || !AdasWarningSetEqual(&set, &m->warnings);
+}
+
+int AdasMidLayoutUpdate(AdasMidLayout* m, const AdasVehicle* v, const AdasResult* res,
+    AdasMidRect* dirty, int maxDirty) {
+    uint64_t probe = AdasProbeStart();
+    bool changed[ADAS_MID_MAX_ROWS] = { false };
+    // rows that vanish must be cleared: remember where they were
+    AdasMidRect gone[ADAS_MID_MAX_ROWS];
+    int oldCount = m->rowCount;
+
+    UpdateHeader(m, v, res, changed);
+
+    // warnings block: title row, then each active warning wrapped to the inset width; only
+    // rebuilt when the set changes
+    AdasWarningSet set;
+    AdasWarningSetFromResult(&set, res);
+    int n = m->rowCount > ADAS_MID_HEADER_ROWS ? m->rowCount : ADAS_MID_HEADER_ROWS + 1;
+    if (!m->warningsValid || !AdasWarningSetEqual(&set, &m->warnings)) {
+        AdasMidRow next[ADAS_MID_MAX_ROWS];
+        int first = ADAS_MID_HEADER_ROWS;
+        int y = first * m->lineHeight + ADAS_MID_WARN_GAP;
+        n = first;
+        SetRow(&next[n++], L"--- WARNINGS ---", 16, ADAS_MID_WARN_INSET, y, ADAS_MID_COLOR_WARNING);
+        y += m->lineHeight;
+        for (int id = 0; id < ADAS_WARN_COUNT; ++id) {
+            if (!(set.mask & ADAS_WARN_BIT(id))) continue;
+            wchar_t line[128];
+            int len = (int)AdasWarningLine(&set, (AdasWarningId)id, line, 128);
+            n = WrapRows(m, next, n, line, len, ADAS_MID_WARN_INSET, &y);
+        }
+        for (int i = first; i < n || i < oldCount; ++i) {
+            if (i >= n) {
+                gone[i] = AdasMidRowRect(m, i);
+                changed[i] = true;
+                continue;
+            }
+            if (i < oldCount && RowEqual(&next[i], &m->rows[i])) continue;
+            next[i].version = ++m->nextVersion;
+            m->rows[i] = next[i];
+            changed[i] = true;
+        }
+        m->warnings = set;
+        m->warningsValid = true;
+    }
+    int rows = n > oldCount ? n : oldCount;
+    m->rowCount = n;
+
+    // changed rows -> rectangles; rows closer than the header/warnings gap share one
+    int count = 0, changedRows = 0;
+    AdasMidRect open = { 0, 0, 0, 0 };
+    bool haveOpen = false;
+    for (int i = 0; i < rows; ++i) {
+        if (!changed[i]) continue;
+        changedRows++;
+        AdasMidRect rc = i < n ? AdasMidRowRect(m, i) : gone[i];
+        if (rc.top >= rc.bottom) continue;
+
+        if (haveOpen && rc.top <= open.bottom + ADAS_MID_WARN_GAP) {
+            if (rc.bottom > open.bottom) open.bottom = rc.bottom;
+            continue;
+        }
+        if (haveOpen) {
+            if (count < maxDirty) dirty[count++] = open;
+            else if (count > 0 && open.bottom > dirty[count - 1].bottom) dirty[count - 1].bottom = open.bottom;
+        }
+        open = rc;
+        haveOpen = true;
+    }
+    if (haveOpen) {
+        if (count < maxDirty) dirty[count++] = open;
+        else if (count > 0 && open.bottom > dirty[count - 1].bottom) dirty[count - 1].bottom = open.bottom;
+    }
+
+    m->stats.updates++;
+    m->stats.rowsChanged += (uint64_t)changedRows;
+    m->stats.fullPixels += (uint64_t)m->width * (uint64_t)m->height;
+    for (int i = 0; i < count; ++i)
+        m->stats.dirtyPixels += (uint64_t)(dirty[i].right - dirty[i].left) * (uint64_t)(dirty[i].bottom - dirty[i].top);
+    AdasProbeStop(ADAS_PROBE_FORMAT, probe);
+    return count;
+}
@@ -0,0 +1,110 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: MID line model: the display as rows of text at known rectangles.
+   - Header rows and (word-wrapped) warning rows are rebuilt from the vehicle state; rows whose
+     text, colour or position changed become dirty rectangles, so the window invalidates only those.
+   - The header is a set of segments (speed, front, TPMS, ...), each keyed by the values it shows
+     and reformatted only when its key changes. A row's version changes with its text, so the
+     window can keep measured glyphs per row.
+   - No Win32 dependency: the UI passes the font metrics (Consolas is monospaced), and the
+     headless tool drives the same model to report paint-area statistics.
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Mid.h
+*/
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <wchar.h>
+
+#include "ADAS_Vehicle.h"
+#include "ADAS_Warnings.h"
+
+#define ADAS_MID_MAX_ROWS 64
+#define ADAS_MID_ROW_CHARS 96       // longest row (header rows are ~45 chars)
+#define ADAS_MID_HEADER_ROWS 18     // header block, including its trailing blank row
+#define ADAS_MID_WARN_GAP 8         // px between header and the warnings block
+#define ADAS_MID_WARN_INSET 4       // px left/right inset of the warnings block
+
+// header rows that show vehicle values; every other header row is fixed text
+typedef enum AdasMidSegment {
+    ADAS_MID_SEG_SPEED = 0,
+    ADAS_MID_SEG_FRONT,
+    ADAS_MID_SEG_TPMS_BASE,
+    ADAS_MID_SEG_TPMS_TYRES,
+    ADAS_MID_SEG_LIGHTS,
+    ADAS_MID_SEG_HANDS,
+    ADAS_MID_SEG_FCW,
+    ADAS_MID_SEG_OBSTACLE,
+    ADAS_MID_SEG_DOORS,
+    ADAS_MID_SEG_INDICATORS,
+    ADAS_MID_SEG_COUNT
+} AdasMidSegment;
+
+typedef enum AdasMidColor {
+    ADAS_MID_COLOR_HEADER = 0,      // green
+    ADAS_MID_COLOR_WARNING,         // orange-red
+    ADAS_MID_COLOR_COUNT
+} AdasMidColor;
+
+// MID colours as 0xRRGGBB, shared by every renderer
+#define ADAS_MID_RGB_BG      0x0A0A0Au
+#define ADAS_MID_RGB_HEADER  0x00FF00u
+#define ADAS_MID_RGB_WARNING 0xFF5000u
+#define ADAS_MID_COLOR_RGB(c) ((c) == ADAS_MID_COLOR_HEADER ? ADAS_MID_RGB_HEADER : ADAS_MID_RGB_WARNING)
+
+// MID-local pixel rectangle (right/bottom exclusive), same layout as a Win32 RECT
+typedef struct AdasMidRect {
+    int left, top, right, bottom;
+} AdasMidRect;
+
+typedef struct AdasMidRow {
+    wchar_t text[ADAS_MID_ROW_CHARS];
+    int len;
+    int x, y;                       // text origin
+    AdasMidColor color;
+    uint32_t version;               // changes whenever text/colour/position change; never reused
+} AdasMidRow;
+
+typedef struct AdasMidStats {
+    uint64_t updates;
+    uint64_t rowsChanged;
+    uint64_t dirtyPixels;           // area handed out as dirty rectangles
+    uint64_t fullPixels;            // area a whole-MID invalidation would have cost
+    uint64_t segmentsFormatted;     // header segments whose key changed
+    uint64_t segmentsReused;
+} AdasMidStats;
+
+typedef struct AdasMidLayout {
+    int width, height;              // MID size (px)
+    int lineHeight, charWidth;      // font metrics (px)
+    int rowCount;
+    AdasMidRow rows[ADAS_MID_MAX_ROWS];
+
+    uint64_t segmentKey[ADAS_MID_SEG_COUNT];  // values each header segment was formatted for
+    bool headerValid;
+    uint32_t nextVersion;
+
+    AdasWarningSet warnings;        // set the warning rows were wrapped for
+    bool warningsValid;
+    AdasMidStats stats;
+} AdasMidLayout;
+
+// ---------------- FUNCTION DECLARATIONS ----------------
+// (re)starts the model for a MID size and font; the next update reports every row dirty
+void AdasMidLayoutInit(AdasMidLayout* m, int width, int height, int lineHeight, int charWidth);
+// rebuilds the rows for this state; writes up to maxDirty rectangles covering every changed row
+// (adjacent rows merged, the rest folded into the last one) and returns how many were written
+int AdasMidLayoutUpdate(AdasMidLayout* m, const AdasVehicle* v, const AdasResult* res,
+    AdasMidRect* dirty, int maxDirty);
+AdasMidRect AdasMidRowRect(const AdasMidLayout* m, int row);
+// true when res would change the warning rows (always before the first update); the MID beeps
+// on a repaint only after an input or when this is true
+bool AdasMidWarningsChanged(const AdasMidLayout* m, const AdasResult* res);
+// header row that shows a segment
+int AdasMidSegmentRow(AdasMidSegment seg);
+// characters per warning row, and the word wrap used for warning rows: writes the start and
+// length of each line (at most maxLines) and returns the line count
+int AdasMidWrapColumns(const AdasMidLayout* m);
+int AdasMidWrapLines(const AdasMidLayout* m, const wchar_t* text, int len, int* starts, int* lens, int maxLines);
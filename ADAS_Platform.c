@@ -0,0 +1,285 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Portability layer implementation (timing, threads, events, atomics).
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Platform.c
+*/
+
+#include "ADAS_Platform.h"
+
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+// ---------------- TIMING ----------------
+uint64_t AdasNowNs(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER c;
+    if (!freq.QuadPart) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&c);
+    // split to avoid overflowing 64 bits on long uptimes
+    uint64_t sec = (uint64_t)(c.QuadPart / freq.QuadPart);
+    uint64_t rem = (uint64_t)(c.QuadPart % freq.QuadPart);
+    return sec * 1000000000ull + rem * 1000000000ull / (uint64_t)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+double AdasNowSeconds(void) {
+    return (double)AdasNowNs() * 1e-9;
+}
+
+void AdasSleepMs(unsigned ms) {
+#ifdef _WIN32
+    Sleep(ms);
+#else
+    struct timespec ts;
+    ts.tv_sec = ms / 1000;
+    ts.tv_nsec = (long)(ms % 1000) * 1000000L;
+    nanosleep(&ts, NULL);
+#endif
+}
+
+// ---------------- THREADS ----------------
+typedef struct ThreadStart {
+    AdasThreadFn fn;
+    void* arg;
+} ThreadStart;
+
+#ifdef _WIN32
+static DWORD WINAPI ThreadTrampoline(LPVOID p) {
+#else
+static void* ThreadTrampoline(void* p) {
+#endif
+    ThreadStart start = *(ThreadStart*)p;
+    free(p);
+    start.fn(start.arg);
+    return 0;
+}
+
+int AdasCpuCount(void) {
+#ifdef _WIN32
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    return (int)si.dwNumberOfProcessors;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+#endif
+}
+
+int AdasThreadStart(AdasThread* t, AdasThreadFn fn, void* arg) {
+    ThreadStart* start = (ThreadStart*)malloc(sizeof(ThreadStart));
+    if (!start) return -1;
+    start->fn = fn;
+    start->arg = arg;
+#ifdef _WIN32
+    HANDLE h = CreateThread(NULL, 0, ThreadTrampoline, start, 0, NULL);
+    if (!h) {
+        free(start);
+        return -1;
+    }
+    t->handle = h;
+#else
+    pthread_t* th = (pthread_t*)malloc(sizeof(pthread_t));
+    if (!th || pthread_create(th, NULL, ThreadTrampoline, start) != 0) {
+        free(th);
+        free(start);
+        return -1;
+    }
+    t->handle = th;
+#endif
+    return 0;
+}
+
+void AdasThreadJoin(AdasThread* t) {
+    if (!t->handle) return;
+#ifdef _WIN32
+    WaitForSingleObject((HANDLE)t->handle, INFINITE);
+    CloseHandle((HANDLE)t->handle);
+#else
+    pthread_join(*(pthread_t*)t->handle, NULL);
+    free(t->handle);
+#endif
+    t->handle = NULL;
+}
+
+// ---------------- EVENTS ----------------
+#ifndef _WIN32
+typedef struct PosixEvent {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    bool signalled;
+} PosixEvent;
+#endif
+
+int AdasEventInit(AdasEvent* e) {
+#ifdef _WIN32
+    e->handle = CreateEventW(NULL, FALSE, FALSE, NULL);
+    return e->handle ? 0 : -1;
+#else
+    PosixEvent* pe = (PosixEvent*)malloc(sizeof(PosixEvent));
+    if (!pe) return -1;
+    // timed waits run on the monotonic clock, like AdasNowNs
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_mutex_init(&pe->lock, NULL);
+    pthread_cond_init(&pe->cond, &attr);
+    pthread_condattr_destroy(&attr);
+    pe->signalled = false;
+    e->handle = pe;
+    return 0;
+#endif
+}
+
+void AdasEventFree(AdasEvent* e) {
+    if (!e->handle) return;
+#ifdef _WIN32
+    CloseHandle((HANDLE)e->handle);
+#else
+    PosixEvent* pe = (PosixEvent*)e->handle;
+    pthread_cond_destroy(&pe->cond);
+    pthread_mutex_destroy(&pe->lock);
+    free(pe);
+#endif
+    e->handle = NULL;
+}
+
+void AdasEventSignal(AdasEvent* e) {
+#ifdef _WIN32
+    SetEvent((HANDLE)e->handle);
+#else
+    PosixEvent* pe = (PosixEvent*)e->handle;
+    pthread_mutex_lock(&pe->lock);
+    pe->signalled = true;
+    pthread_cond_signal(&pe->cond);
+    pthread_mutex_unlock(&pe->lock);
+#endif
+}
+
+bool AdasEventWait(AdasEvent* e, unsigned ms) {
+#ifdef _WIN32
+    return WaitForSingleObject((HANDLE)e->handle, ms == ADAS_WAIT_FOREVER ? INFINITE : ms) == WAIT_OBJECT_0;
+#else
+    PosixEvent* pe = (PosixEvent*)e->handle;
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += ms / 1000;
+    deadline.tv_nsec += (long)(ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    pthread_mutex_lock(&pe->lock);
+    while (!pe->signalled) {
+        int rc = ms == ADAS_WAIT_FOREVER ? pthread_cond_wait(&pe->cond, &pe->lock)
+            : pthread_cond_timedwait(&pe->cond, &pe->lock, &deadline);
+        if (rc != 0 && rc != EINTR) break;
+    }
+    bool signalled = pe->signalled;
+    pe->signalled = false;
+    pthread_mutex_unlock(&pe->lock);
+    return signalled;
+#endif
+}
+
+// ---------------- ATOMICS ----------------
+// Interlocked functions on Windows (full barriers), GCC/Clang __atomic builtins elsewhere
+uint32_t AdasAtomicLoad32(const volatile uint32_t* p) {
+#ifdef _WIN32
+    // a plain load: a locked compare-exchange writes the line, so readers on other cores would contend
+    return (uint32_t)ReadAcquire((const volatile LONG*)p);
+#else
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+#endif
+}
+
+void AdasAtomicStore32(volatile uint32_t* p, uint32_t v) {
+#ifdef _WIN32
+    InterlockedExchange((volatile LONG*)p, (LONG)v);
+#else
+    __atomic_store_n(p, v, __ATOMIC_RELEASE);
+#endif
+}
+
+bool AdasAtomicCas32(volatile uint32_t* p, uint32_t expected, uint32_t desired) {
+#ifdef _WIN32
+    return (uint32_t)InterlockedCompareExchange((volatile LONG*)p, (LONG)desired, (LONG)expected) == expected;
+#else
+    return __atomic_compare_exchange_n(p, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif
+}
+
+uint64_t AdasAtomicLoad64(const volatile uint64_t* p) {
+#ifdef _WIN32
+    // also atomic on 32-bit builds, where a plain 64-bit read is two loads
+    return (uint64_t)InterlockedCompareExchange64((volatile LONG64*)p, 0, 0);
+#else
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+#endif
+}
+
+bool AdasAtomicCas64(volatile uint64_t* p, uint64_t expected, uint64_t desired) {
+#ifdef _WIN32
+    return (uint64_t)InterlockedCompareExchange64((volatile LONG64*)p, (LONG64)desired, (LONG64)expected) == expected;
+#else
+    return __atomic_compare_exchange_n(p, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif
+}
+
+uint64_t AdasAtomicAdd64(volatile uint64_t* p, uint64_t v) {
+#ifdef _WIN32
+    return (uint64_t)InterlockedAdd64((volatile LONG64*)p, (LONG64)v);
+#else
+    return __atomic_add_fetch(p, v, __ATOMIC_ACQ_REL);
+#endif
+}
+
+void* AdasAtomicLoadPtr(void* const volatile* p) {
+#ifdef _WIN32
+    return InterlockedCompareExchangePointer((PVOID volatile*)p, NULL, NULL);
+#else
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+#endif
+}
+
+void AdasAtomicStorePtr(void* volatile* p, void* v) {
+#ifdef _WIN32
+    InterlockedExchangePointer(p, v);
+#else
+    __atomic_store_n(p, v, __ATOMIC_RELEASE);
+#endif
+}
+
+bool AdasAtomicCasPtr(void* volatile* p, void* expected, void* desired) {
+#ifdef _WIN32
+    return InterlockedCompareExchangePointer(p, desired, expected) == expected;
+#else
+    return __atomic_compare_exchange_n(p, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif
+}
+
+// ---------------- ONE-TIME INIT ----------------
+// 0 = not built, 1 = being built, ADAS_ONCE_DONE = ready
+bool AdasOnceBegin(volatile uint32_t* state) {
+    if (AdasAtomicLoad32(state) == ADAS_ONCE_DONE) return false;
+    if (AdasAtomicCas32(state, 0, 1)) return true;
+    while (AdasAtomicLoad32(state) != ADAS_ONCE_DONE) AdasSleepMs(0);
+    return false;
+}
+
+void AdasOnceDone(volatile uint32_t* state) {
+    AdasAtomicStore32(state, ADAS_ONCE_DONE);
+}
@@ -0,0 +1,70 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Small portability layer for the headless modules (timing, threads, events, atomics).
+   Win32 API on Windows, POSIX everywhere else.
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Platform.h
+*/
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// per-thread storage for plain data (no constructors in C)
+#ifdef _WIN32
+#define ADAS_THREAD_LOCAL __declspec(thread)
+#else
+#define ADAS_THREAD_LOCAL __thread
+#endif
+
+typedef struct AdasThread {
+    void* handle;
+} AdasThread;
+
+typedef void (*AdasThreadFn)(void* arg);
+
+// auto-reset event: one Signal wakes one Wait (or the next one, if nobody is waiting)
+typedef struct AdasEvent {
+    void* handle;
+} AdasEvent;
+
+#define ADAS_WAIT_FOREVER 0xFFFFFFFFu
+
+// ---------------- FUNCTION DECLARATIONS ----------------
+// monotonic clock
+uint64_t AdasNowNs(void);
+double AdasNowSeconds(void);
+void AdasSleepMs(unsigned ms);
+
+int AdasCpuCount(void);
+// returns 0 on success
+int AdasThreadStart(AdasThread* t, AdasThreadFn fn, void* arg);
+void AdasThreadJoin(AdasThread* t);
+
+// returns 0 on success
+int AdasEventInit(AdasEvent* e);
+void AdasEventFree(AdasEvent* e);
+void AdasEventSignal(AdasEvent* e);
+// true when signalled, false on timeout (ms, or ADAS_WAIT_FOREVER)
+bool AdasEventWait(AdasEvent* e, unsigned ms);
+
+// ---------------- ATOMICS ----------------
+// loads acquire, stores release, read-modify-write operations are full barriers
+uint32_t AdasAtomicLoad32(const volatile uint32_t* p);
+void AdasAtomicStore32(volatile uint32_t* p, uint32_t v);
+bool AdasAtomicCas32(volatile uint32_t* p, uint32_t expected, uint32_t desired);
+uint64_t AdasAtomicLoad64(const volatile uint64_t* p);
+bool AdasAtomicCas64(volatile uint64_t* p, uint64_t expected, uint64_t desired);
+uint64_t AdasAtomicAdd64(volatile uint64_t* p, uint64_t v);   // returns the new value
+void* AdasAtomicLoadPtr(void* const volatile* p);
+void AdasAtomicStorePtr(void* volatile* p, void* v);
+bool AdasAtomicCasPtr(void* volatile* p, void* expected, void* desired);
+
+// ---------------- ONE-TIME INIT ----------------
+// state starts at 0. AdasOnceBegin is true for the one caller that must build (it then calls
+// AdasOnceDone); every other caller waits until the build is done. Once done, callers only
+// pay an acquire load, so hot paths can check AdasOnceReady on every call.
+#define ADAS_ONCE_DONE 2u
+bool AdasOnceBegin(volatile uint32_t* state);
+void AdasOnceDone(volatile uint32_t* state);
+#define AdasOnceReady(state) (AdasAtomicLoad32(state) == ADAS_ONCE_DONE)
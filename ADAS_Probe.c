@@ -0,0 +1,219 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Phase timing probes: per-thread rings and log-linear histograms (see ADAS_Probe.h).
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Probe.c
+*/
+#include "ADAS_Probe.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ADAS_Platform.h"
+
+#define SUB_COUNT (1u << ADAS_PROBE_SUB_BITS)
+#define NS_BITS 56                  // entry = phase << 56 | ns
+
+// ---------------- RINGS ----------------
+// single producer (the owning thread) writes head, single consumer (the collector) writes tail
+typedef struct ProbeRing {
+    uint64_t entries[ADAS_PROBE_RING];
+    volatile uint32_t head;
+    volatile uint32_t tail;
+    volatile uint32_t inUse;        // 1 while a thread owns the ring
+    volatile uint64_t dropped;
+    struct ProbeRing* next;         // registry; rings are never unlinked, only handed over
+} ProbeRing;
+
+static void* volatile ringList = NULL;
+static ADAS_THREAD_LOCAL ProbeRing* threadRing = NULL;
+
+// histograms belong to whoever holds this flag
+static volatile uint32_t histLock = 0;
+static AdasProbeHistogram histograms[ADAS_PROBE_PHASE_COUNT];
+
+static const char* const phaseNames[ADAS_PROBE_PHASE_COUNT] = {
+    "rules", "format", "clear", "text", "blit", "frame",
+};
+
+static ProbeRing* ClaimRing(void) {
+    // reuse a ring a finished thread handed back, else add a new one to the registry
+    for (ProbeRing* r = (ProbeRing*)AdasAtomicLoadPtr(&ringList); r; r = r->next) {
+        if (AdasAtomicCas32(&r->inUse, 0, 1)) return r;
+    }
+    ProbeRing* r = (ProbeRing*)calloc(1, sizeof(ProbeRing));
+    if (!r) return NULL;
+    r->inUse = 1;
+    void* head;
+    do {
+        head = AdasAtomicLoadPtr(&ringList);
+        r->next = (ProbeRing*)head;
+    } while (!AdasAtomicCasPtr(&ringList, head, r));
+    return r;
+}
+
+#if ADAS_PROBE_ENABLED
+uint64_t AdasProbeStart(void) {
+    return AdasNowNs();
+}
+
+void AdasProbeStop(AdasProbePhase phase, uint64_t start) {
+    AdasProbeRecord(phase, AdasNowNs() - start);
+}
+#endif
+
+void AdasProbeRecord(AdasProbePhase phase, uint64_t ns) {
+    ProbeRing* r = threadRing;
+    if (!r) {
+        r = threadRing = ClaimRing();
+        if (!r) return;
+    }
+    uint32_t head = r->head;
+    // never drains here: a probe may sit inside another phase's span. Until the next collect
+    // a full ring only counts what it cannot keep
+    if (head - AdasAtomicLoad32(&r->tail) >= ADAS_PROBE_RING) {
+        AdasAtomicAdd64(&r->dropped, 1);
+        return;
+    }
+    if (ns >> NS_BITS) ns = (1ull << NS_BITS) - 1;
+    r->entries[head & (ADAS_PROBE_RING - 1)] = (uint64_t)phase << NS_BITS | ns;
+    AdasAtomicStore32(&r->head, head + 1);
+}
+
+void AdasProbeThreadExit(void) {
+    ProbeRing* r = threadRing;
+    if (!r) return;
+    threadRing = NULL;
+    AdasAtomicStore32(&r->inUse, 0);
+}
+
+// ---------------- HISTOGRAMS ----------------
+static int Msb(uint64_t v) {
+    int n = 0;
+    if (v >> 32) { v >>= 32; n += 32; }
+    if (v >> 16) { v >>= 16; n += 16; }
+    if (v >> 8) { v >>= 8; n += 8; }
+    if (v >> 4) { v >>= 4; n += 4; }
+    if (v >> 2) { v >>= 2; n += 2; }
+    if (v >> 1) n += 1;
+    return n;
+}
+
+// values below SUB_COUNT are exact; above, each power of two splits into SUB_COUNT buckets
+static int BucketOf(uint64_t v) {
+    if (v < SUB_COUNT) return (int)v;
+    int shift = Msb(v) - ADAS_PROBE_SUB_BITS;
+    return ((shift + 1) << ADAS_PROBE_SUB_BITS) + (int)((v >> shift) & (SUB_COUNT - 1));
+}
+
+static uint64_t BucketHigh(int b) {
+    if (b < (int)SUB_COUNT) return (uint64_t)b;
+    int shift = (b >> ADAS_PROBE_SUB_BITS) - 1;
+    uint64_t low = (uint64_t)(SUB_COUNT + (b & (SUB_COUNT - 1))) << shift;
+    return low + (1ull << shift) - 1;
+}
+
+// only report-side callers take the lock, so it is rarely contended: sleep rather than spin
+static void LockHistograms(void) {
+    while (!AdasAtomicCas32(&histLock, 0, 1)) AdasSleepMs(1);
+}
+
+static void UnlockHistograms(void) {
+    AdasAtomicStore32(&histLock, 0);
+}
+
+static void DrainRings(void) {
+    for (ProbeRing* r = (ProbeRing*)AdasAtomicLoadPtr(&ringList); r; r = r->next) {
+        uint32_t head = AdasAtomicLoad32(&r->head);
+        uint32_t tail = r->tail;
+        for (; tail != head; ++tail) {
+            uint64_t e = r->entries[tail & (ADAS_PROBE_RING - 1)];
+            unsigned phase = (unsigned)(e >> NS_BITS);
+            uint64_t ns = e & ((1ull << NS_BITS) - 1);
+            if (phase >= ADAS_PROBE_PHASE_COUNT) continue;
+            AdasProbeHistogram* h = &histograms[phase];
+            h->counts[BucketOf(ns)]++;
+            h->count++;
+            h->totalNs += ns;
+            if (ns > h->maxNs) h->maxNs = ns;
+        }
+        AdasAtomicStore32(&r->tail, tail);
+    }
+}
+
+void AdasProbeCollect(void) {
+    if (!AdasAtomicCas32(&histLock, 0, 1)) return;
+    DrainRings();
+    UnlockHistograms();
+}
+
+void AdasProbeReset(void) {
+    LockHistograms();
+    // samples already in the rings belong to the old period
+    DrainRings();
+    memset(histograms, 0, sizeof(histograms));
+    UnlockHistograms();
+}
+
+const char* AdasProbePhaseName(AdasProbePhase phase) {
+    return (unsigned)phase < ADAS_PROBE_PHASE_COUNT ? phaseNames[phase] : "?";
+}
+
+void AdasProbeHistogramOf(AdasProbePhase phase, AdasProbeHistogram* out) {
+    memset(out, 0, sizeof(*out));
+    if ((unsigned)phase >= ADAS_PROBE_PHASE_COUNT) return;
+    LockHistograms();
+    *out = histograms[phase];
+    UnlockHistograms();
+}
+
+uint64_t AdasProbePercentile(const AdasProbeHistogram* h, double pct) {
+    if (!h->count) return 0;
+    uint64_t rank = (uint64_t)(pct / 100.0 * (double)h->count + 0.999999);
+    if (rank < 1) rank = 1;
+    if (rank > h->count) rank = h->count;
+    uint64_t seen = 0;
+    for (int b = 0; b < ADAS_PROBE_BUCKETS; ++b) {
+        seen += h->counts[b];
+        if (seen >= rank) {
+            uint64_t high = BucketHigh(b);
+            return high < h->maxNs ? high : h->maxNs;
+        }
+    }
+    return h->maxNs;
+}
+
+uint64_t AdasProbeDropped(void) {
+    uint64_t dropped = 0;
+    for (ProbeRing* r = (ProbeRing*)AdasAtomicLoadPtr(&ringList); r; r = r->next)
+        dropped += AdasAtomicAdd64(&r->dropped, 0);
+    return dropped;
+}
+
+// ---------------- REPORT ----------------
+size_t AdasProbeReport(char* buf, size_t cap) {
+    static AdasProbeHistogram h;    // large; the report is not reentrant anyway
+    size_t len = 0;
+    int n;
+    if (!cap) return 0;
+    buf[0] = '\0';
+
+    LockHistograms();
+    DrainRings();
+    UnlockHistograms();
+
+    n = snprintf(buf, cap, "%-8s %10s %10s %10s %10s %10s\n", "phase", "count", "p50 us", "p99 us", "max us", "mean us");
+    if (n > 0) len = (size_t)n < cap ? (size_t)n : cap - 1;
+    for (int p = 0; p < ADAS_PROBE_PHASE_COUNT; ++p) {
+        AdasProbeHistogramOf((AdasProbePhase)p, &h);
+        if (!h.count) continue;
+        n = snprintf(buf + len, cap - len, "%-8s %10llu %10.2f %10.2f %10.2f %10.2f\n", phaseNames[p],
+            (unsigned long long)h.count, AdasProbePercentile(&h, 50) / 1e3, AdasProbePercentile(&h, 99) / 1e3,
+            h.maxNs / 1e3, (double)h.totalNs / (double)h.count / 1e3);
+        if (n > 0) len += (size_t)n < cap - len ? (size_t)n : cap - len - 1;
+    }
+    n = snprintf(buf + len, cap - len, "dropped samples: %llu\n", (unsigned long long)AdasProbeDropped());
+    if (n > 0) len += (size_t)n < cap - len ? (size_t)n : cap - len - 1;
+    return len;
+}
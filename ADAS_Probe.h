@@ -0,0 +1,71 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Always-on timing probes for the phases of a MID frame.
+   - A probe is two clock reads and one store into the calling thread's ring buffer: no locks,
+     no allocation after the thread's first probe, and never a drain. A full ring drops (and
+     counts) the sample.
+   - AdasProbeCollect drains every ring into one log-linear histogram per phase (HDR-style:
+     16 sub-buckets per power of two, so any percentile is within 1/16 of the true value).
+     Only the reporting side calls it: the window on a slow timer of its own, adas_headless
+     --probe on a collector thread, and every report.
+   - AdasProbeReport prints count, p50, p99 and max per phase: the window dumps it on F12 and at
+     exit, adas_headless --probe <command> at exit.
+   - Build with ADAS_PROBE_ENABLED=0 to compile the probes out.
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Probe.h
+*/
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef ADAS_PROBE_ENABLED
+#define ADAS_PROBE_ENABLED 1
+#endif
+
+#define ADAS_PROBE_RING 4096        // samples per thread between collections (power of two)
+#define ADAS_PROBE_SUB_BITS 4
+#define ADAS_PROBE_BUCKETS ((64 - ADAS_PROBE_SUB_BITS + 1) << ADAS_PROBE_SUB_BITS)
+
+typedef enum AdasProbePhase {
+    ADAS_PROBE_RULES = 0,           // incremental rule evaluation, FCW threshold included
+    ADAS_PROBE_FORMAT,              // MID line model: header segments, warning text and wrap, row diff
+    ADAS_PROBE_CLEAR,               // background fills
+    ADAS_PROBE_TEXT,                // drawing the rows (GDI, atlas, software or terminal escapes)
+    ADAS_PROBE_BLIT,                // back buffer to the window
+    ADAS_PROBE_FRAME,               // one whole MID frame
+    ADAS_PROBE_PHASE_COUNT
+} AdasProbePhase;
+
+typedef struct AdasProbeHistogram {
+    uint64_t counts[ADAS_PROBE_BUCKETS];
+    uint64_t count;
+    uint64_t totalNs;
+    uint64_t maxNs;
+} AdasProbeHistogram;
+
+// ---------------- FUNCTION DECLARATIONS ----------------
+#if ADAS_PROBE_ENABLED
+uint64_t AdasProbeStart(void);
+// records now - start for phase in the calling thread's ring
+void AdasProbeStop(AdasProbePhase phase, uint64_t start);
+#else
+#define AdasProbeStart() 0
+#define AdasProbeStop(phase, start) ((void)(phase), (void)(start))
+#endif
+void AdasProbeRecord(AdasProbePhase phase, uint64_t ns);
+// hands the calling thread's ring to the next thread that starts probing
+void AdasProbeThreadExit(void);
+
+// drains every ring into the histograms; one collector at a time (a concurrent call returns at once)
+void AdasProbeCollect(void);
+void AdasProbeReset(void);
+const char* AdasProbePhaseName(AdasProbePhase phase);
+// copies one phase's histogram (after a collect)
+void AdasProbeHistogramOf(AdasProbePhase phase, AdasProbeHistogram* out);
+// highest value in the bucket holding the pct-th percentile, capped at the recorded max
+uint64_t AdasProbePercentile(const AdasProbeHistogram* h, double pct);
+uint64_t AdasProbeDropped(void);
+// collects, then writes a table (one line per phase with samples) into buf; returns its length
+size_t AdasProbeReport(char* buf, size_t cap);
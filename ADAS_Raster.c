@@ -0,0 +1,294 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Software MID renderer, built-in bitmap font and PPM/PNG encoders (see ADAS_Raster.h).
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Raster.c
+*/
+#include "ADAS_Raster.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ---------------- FONT ----------------
+// 5x8 glyphs, one byte per column, bit 0 = top row; row 7 holds descenders
+#define FONT_W 5
+#define FONT_H 8
+#define FONT_FIRST 0x20
+#define FONT_LAST 0x7E
+
+static const uint8_t fontAscii[FONT_LAST - FONT_FIRST + 1][FONT_W] = {
+    { 0x00, 0x00, 0x00, 0x00, 0x00 }, { 0x00, 0x00, 0x5F, 0x00, 0x00 }, // space !
+    { 0x00, 0x07, 0x00, 0x07, 0x00 }, { 0x14, 0x7F, 0x14, 0x7F, 0x14 }, // " #
+    { 0x24, 0x2A, 0x7F, 0x2A, 0x12 }, { 0x23, 0x13, 0x08, 0x64, 0x62 }, // $ %
+    { 0x36, 0x49, 0x56, 0x20, 0x50 }, { 0x00, 0x08, 0x07, 0x03, 0x00 }, // & '
+    { 0x00, 0x1C, 0x22, 0x41, 0x00 }, { 0x00, 0x41, 0x22, 0x1C, 0x00 }, // ( )
+    { 0x2A, 0x1C, 0x7F, 0x1C, 0x2A }, { 0x08, 0x08, 0x3E, 0x08, 0x08 }, // * +
+    { 0x00, 0x80, 0x70, 0x30, 0x00 }, { 0x08, 0x08, 0x08, 0x08, 0x08 }, // , -
+    { 0x00, 0x00, 0x60, 0x60, 0x00 }, { 0x20, 0x10, 0x08, 0x04, 0x02 }, // . /
+    { 0x3E, 0x51, 0x49, 0x45, 0x3E }, { 0x00, 0x42, 0x7F, 0x40, 0x00 }, // 0 1
+    { 0x72, 0x49, 0x49, 0x49, 0x46 }, { 0x21, 0x41, 0x49, 0x4D, 0x33 }, // 2 3
+    { 0x18, 0x14, 0x12, 0x7F, 0x10 }, { 0x27, 0x45, 0x45, 0x45, 0x39 }, // 4 5
+    { 0x3C, 0x4A, 0x49, 0x49, 0x31 }, { 0x41, 0x21, 0x11, 0x09, 0x07 }, // 6 7
+    { 0x36, 0x49, 0x49, 0x49, 0x36 }, { 0x46, 0x49, 0x49, 0x29, 0x1E }, // 8 9
+    { 0x00, 0x00, 0x14, 0x00, 0x00 }, { 0x00, 0x40, 0x34, 0x00, 0x00 }, // : ;
+    { 0x00, 0x08, 0x14, 0x22, 0x41 }, { 0x14, 0x14, 0x14, 0x14, 0x14 }, // < =
+    { 0x00, 0x41, 0x22, 0x14, 0x08 }, { 0x02, 0x01, 0x59, 0x09, 0x06 }, // > ?
+    { 0x3E, 0x41, 0x5D, 0x59, 0x4E }, { 0x7C, 0x12, 0x11, 0x12, 0x7C }, // @ A
+    { 0x7F, 0x49, 0x49, 0x49, 0x36 }, { 0x3E, 0x41, 0x41, 0x41, 0x22 }, // B C
+    { 0x7F, 0x41, 0x41, 0x41, 0x3E }, { 0x7F, 0x49, 0x49, 0x49, 0x41 }, // D E
+    { 0x7F, 0x09, 0x09, 0x09, 0x01 }, { 0x3E, 0x41, 0x41, 0x51, 0x73 }, // F G
+    { 0x7F, 0x08, 0x08, 0x08, 0x7F }, { 0x00, 0x41, 0x7F, 0x41, 0x00 }, // H I
+    { 0x20, 0x40, 0x41, 0x3F, 0x01 }, { 0x7F, 0x08, 0x14, 0x22, 0x41 }, // J K
+    { 0x7F, 0x40, 0x40, 0x40, 0x40 }, { 0x7F, 0x02, 0x1C, 0x02, 0x7F }, // L M
+    { 0x7F, 0x04, 0x08, 0x10, 0x7F }, { 0x3E, 0x41, 0x41, 0x41, 0x3E }, // N O
+    { 0x7F, 0x09, 0x09, 0x09, 0x06 }, { 0x3E, 0x41, 0x51, 0x21, 0x5E }, // P Q
+    { 0x7F, 0x09, 0x19, 0x29, 0x46 }, { 0x26, 0x49, 0x49, 0x49, 0x32 }, // R S
+    { 0x03, 0x01, 0x7F, 0x01, 0x03 }, { 0x3F, 0x40, 0x40, 0x40, 0x3F }, // T U
+    { 0x1F, 0x20, 0x40, 0x20, 0x1F }, { 0x3F, 0x40, 0x38, 0x40, 0x3F }, // V W
+    { 0x63, 0x14, 0x08, 0x14, 0x63 }, { 0x03, 0x04, 0x78, 0x04, 0x03 }, // X Y
+    { 0x61, 0x59, 0x49, 0x4D, 0x43 }, { 0x00, 0x7F, 0x41, 0x41, 0x41 }, // Z [
+    { 0x02, 0x04, 0x08, 0x10, 0x20 }, { 0x00, 0x41, 0x41, 0x41, 0x7F }, // backslash ]
+    { 0x04, 0x02, 0x01, 0x02, 0x04 }, { 0x40, 0x40, 0x40, 0x40, 0x40 }, // ^ _
+    { 0x00, 0x03, 0x07, 0x08, 0x00 }, { 0x20, 0x54, 0x54, 0x78, 0x40 }, // ` a
+    { 0x7F, 0x28, 0x44, 0x44, 0x38 }, { 0x38, 0x44, 0x44, 0x44, 0x28 }, // b c
+    { 0x38, 0x44, 0x44, 0x28, 0x7F }, { 0x38, 0x54, 0x54, 0x54, 0x18 }, // d e
+    { 0x00, 0x08, 0x7E, 0x09, 0x02 }, { 0x18, 0xA4, 0xA4, 0x9C, 0x78 }, // f g
+    { 0x7F, 0x08, 0x04, 0x04, 0x78 }, { 0x00, 0x44, 0x7D, 0x40, 0x00 }, // h i
+    { 0x20, 0x40, 0x40, 0x3D, 0x00 }, { 0x7F, 0x10, 0x28, 0x44, 0x00 }, // j k
+    { 0x00, 0x41, 0x7F, 0x40, 0x00 }, { 0x7C, 0x04, 0x78, 0x04, 0x78 }, // l m
+    { 0x7C, 0x08, 0x04, 0x04, 0x78 }, { 0x38, 0x44, 0x44, 0x44, 0x38 }, // n o
+    { 0xFC, 0x18, 0x24, 0x24, 0x18 }, { 0x18, 0x24, 0x24, 0x18, 0xFC }, // p q
+    { 0x7C, 0x08, 0x04, 0x04, 0x08 }, { 0x48, 0x54, 0x54, 0x54, 0x24 }, // r s
+    { 0x04, 0x04, 0x3F, 0x44, 0x24 }, { 0x3C, 0x40, 0x40, 0x20, 0x7C }, // t u
+    { 0x1C, 0x20, 0x40, 0x20, 0x1C }, { 0x3C, 0x40, 0x30, 0x40, 0x3C }, // v w
+    { 0x44, 0x28, 0x10, 0x28, 0x44 }, { 0x4C, 0x90, 0x90, 0x90, 0x7C }, // x y
+    { 0x44, 0x64, 0x54, 0x4C, 0x44 }, { 0x00, 0x08, 0x36, 0x41, 0x00 }, // z {
+    { 0x00, 0x00, 0x77, 0x00, 0x00 }, { 0x00, 0x41, 0x36, 0x08, 0x00 }, // | }
+    { 0x02, 0x01, 0x02, 0x04, 0x02 },                                   // ~
+};
+
+// U+26A0 warning sign: solid triangle with the exclamation mark cut out
+static const uint8_t fontWarning[FONT_W] = { 0x78, 0x7E, 0x53, 0x7E, 0x78 };
+// anything else: an empty box
+static const uint8_t fontMissing[FONT_W] = { 0x7F, 0x41, 0x41, 0x41, 0x7F };
+
+static const uint8_t* Glyph(wchar_t ch) {
+    if (ch >= FONT_FIRST && ch <= FONT_LAST) return fontAscii[ch - FONT_FIRST];
+    if (ch == 0x26A0) return fontWarning;
+    return fontMissing;
+}
+
+// ---------------- FRAMEBUFFER ----------------
+// 0xRRGGBB -> pixel with bytes R,G,B,A in memory, whatever the host byte order
+static uint32_t PackRgb(uint32_t rgb) {
+    uint8_t b[4] = { (uint8_t)(rgb >> 16), (uint8_t)(rgb >> 8), (uint8_t)rgb, 255 };
+    uint32_t p;
+    memcpy(&p, b, sizeof(p));
+    return p;
+}
+
+bool AdasRasterInit(AdasRaster* r, int width, int height) {
+    r->width = width > 0 ? width : 0;
+    r->height = height > 0 ? height : 0;
+    r->pixels = (uint32_t*)calloc((size_t)r->width * (size_t)r->height + 1, sizeof(uint32_t));
+    return r->pixels != NULL;
+}
+
+void AdasRasterFree(AdasRaster* r) {
+    free(r->pixels);
+    r->pixels = NULL;
+    r->width = r->height = 0;
+}
+
+static void FillPixels(AdasRaster* r, int left, int top, int right, int bottom, uint32_t pixel) {
+    for (int y = top; y < bottom; ++y) {
+        uint32_t* p = r->pixels + (size_t)y * (size_t)r->width;
+        for (int x = left; x < right; ++x) p[x] = pixel;
+    }
+}
+
+uint32_t AdasRasterPixelRgb(const AdasRaster* r, int x, int y) {
+    if (x < 0 || y < 0 || x >= r->width || y >= r->height) return 0;
+    uint8_t b[4];
+    memcpy(b, &r->pixels[(size_t)y * (size_t)r->width + (size_t)x], sizeof(b));
+    return ((uint32_t)b[0] << 16) | ((uint32_t)b[1] << 8) | b[2];
+}
+
+uint64_t AdasRasterHash(const AdasRaster* r) {
+    const uint8_t* p = (const uint8_t*)r->pixels;
+    size_t n = (size_t)r->width * (size_t)r->height * 4;
+    uint64_t h = 1469598103934665603ull;
+    for (size_t i = 0; i < n; ++i) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+// ---------------- RENDERER ----------------
+static void RasterBegin(void* target, const AdasMidLayout* m, AdasMidRect clip) {
+    (void)target; (void)m; (void)clip;
+}
+
+static void RasterClear(void* target, AdasMidRect rect) {
+    AdasRaster* r = (AdasRaster*)target;
+    AdasMidRect bounds = { 0, 0, r->width, r->height };
+    if (!AdasMidRectIntersect(&rect, rect, bounds)) return;
+    FillPixels(r, rect.left, rect.top, rect.right, rect.bottom, PackRgb(ADAS_MID_RGB_BG));
+}
+
+static void RasterText(void* target, const AdasMidLayout* m, int index, AdasMidRect part) {
+    AdasRaster* r = (AdasRaster*)target;
+    AdasMidRect bounds = { 0, 0, r->width, r->height };
+    if (!AdasMidRectIntersect(&part, part, bounds)) return;
+    const AdasMidRow* row = &m->rows[index];
+    uint32_t pixel = PackRgb(ADAS_MID_COLOR_RGB(row->color));
+
+    // whole-pixel scale that fits the cell, glyph centred vertically
+    int sx = m->charWidth / FONT_W, sy = m->lineHeight / FONT_H;
+    int scale = sx < sy ? sx : sy;
+    if (scale < 1) scale = 1;
+    int top = row->y + (m->lineHeight - FONT_H * scale) / 2;
+
+    for (int i = 0; i < row->len; ++i) {
+        int gx = row->x + i * m->charWidth;
+        if (gx >= part.right) break;
+        if (gx + FONT_W * scale <= part.left) continue;
+        const uint8_t* g = Glyph(row->text[i]);
+        for (int c = 0; c < FONT_W; ++c) {
+            int x0 = gx + c * scale, x1 = x0 + scale;
+            if (x0 < part.left) x0 = part.left;
+            if (x1 > part.right) x1 = part.right;
+            if (x0 >= x1 || !g[c]) continue;
+            for (int b = 0; b < FONT_H; ++b) {
+                if (!(g[c] & (1u << b))) continue;
+                int y0 = top + b * scale, y1 = y0 + scale;
+                if (y0 < part.top) y0 = part.top;
+                if (y1 > part.bottom) y1 = part.bottom;
+                if (y0 < y1) FillPixels(r, x0, y0, x1, y1, pixel);
+            }
+        }
+    }
+}
+
+static void RasterEnd(void* target) {
+    (void)target;
+}
+
+static const AdasRenderOps rasterOps = { "software", RasterBegin, RasterClear, RasterText, RasterEnd };
+
+AdasRenderer AdasRasterRenderer(AdasRaster* r) {
+    AdasRenderer renderer = { &rasterOps, r };
+    return renderer;
+}
+
+// ---------------- PPM ----------------
+uint8_t* AdasRasterEncodePpm(const AdasRaster* r, size_t* size) {
+    char header[32];
+    int headerLen = snprintf(header, sizeof(header), "P6\n%d %d\n255\n", r->width, r->height);
+    size_t pixels = (size_t)r->width * (size_t)r->height;
+    uint8_t* out = (uint8_t*)malloc((size_t)headerLen + pixels * 3);
+    if (!out) return NULL;
+    memcpy(out, header, (size_t)headerLen);
+    uint8_t* p = out + headerLen;
+    for (size_t i = 0; i < pixels; ++i) {
+        uint8_t b[4];
+        memcpy(b, &r->pixels[i], sizeof(b));
+        *p++ = b[0];
+        *p++ = b[1];
+        *p++ = b[2];
+    }
+    *size = (size_t)(p - out);
+    return out;
+}
+
+// ---------------- PNG ----------------
+// RGBA, filter 0 on every scanline, zlib stream of stored (uncompressed) deflate blocks
+static uint32_t crcTable[256];
+static bool crcReady = false;
+
+static uint32_t Crc32(const uint8_t* p, size_t n) {
+    if (!crcReady) {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            crcTable[i] = c;
+        }
+        crcReady = true;
+    }
+    uint32_t c = 0xFFFFFFFFu;
+    for (size_t i = 0; i < n; ++i) c = crcTable[(c ^ p[i]) & 0xFF] ^ (c >> 8);
+    return c ^ 0xFFFFFFFFu;
+}
+
+static uint8_t* PutBe32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+    return p + 4;
+}
+
+// writes length, type, data (already at p + 8) and CRC; returns the end of the chunk
+static uint8_t* FinishChunk(uint8_t* p, const char* type, size_t len) {
+    PutBe32(p, (uint32_t)len);
+    memcpy(p + 4, type, 4);
+    uint32_t crc = Crc32(p + 4, len + 4);
+    return PutBe32(p + 8 + len, crc);
+}
+
+uint8_t* AdasRasterEncodePng(const AdasRaster* r, size_t* size) {
+    static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    size_t rowBytes = 1 + (size_t)r->width * 4;
+    size_t raw = rowBytes * (size_t)r->height;
+    size_t blocks = raw / 65535 + 1;
+    size_t zlib = 2 + blocks * 5 + raw + 4;
+    uint8_t* out = (uint8_t*)malloc(sizeof(signature) + (12 + 13) + (12 + zlib) + 12);
+    if (!out) return NULL;
+
+    uint8_t* p = out;
+    memcpy(p, signature, sizeof(signature));
+    p += sizeof(signature);
+
+    uint8_t* d = p + 8;
+    d = PutBe32(d, (uint32_t)r->width);
+    d = PutBe32(d, (uint32_t)r->height);
+    *d++ = 8;    // bit depth
+    *d++ = 6;    // RGBA
+    *d++ = 0;    // deflate
+    *d++ = 0;    // adaptive filtering
+    *d++ = 0;    // no interlace
+    p = FinishChunk(p, "IHDR", 13);
+
+    // the scanlines are streamed through the stored blocks without building them first
+    d = p + 8;
+    *d++ = 0x78;
+    *d++ = 0x01;
+    uint32_t s1 = 1, s2 = 0;
+    size_t left = raw, pos = 0;
+    for (size_t b = 0; b < blocks; ++b) {
+        size_t n = left < 65535 ? left : 65535;
+        left -= n;
+        *d++ = left == 0 ? 1 : 0;
+        *d++ = (uint8_t)n;
+        *d++ = (uint8_t)(n >> 8);
+        *d++ = (uint8_t)~n;
+        *d++ = (uint8_t)(~n >> 8);
+        for (size_t i = 0; i < n; ++i, ++pos) {
+            size_t y = pos / rowBytes, x = pos % rowBytes;
+            uint8_t v = 0;
+            if (x) v = ((const uint8_t*)r->pixels)[y * (size_t)r->width * 4 + x - 1];
+            *d++ = v;
+            s1 = (s1 + v) % 65521;
+            s2 = (s2 + s1) % 65521;
+        }
+        if (!left) break;
+    }
+    d = PutBe32(d, (s2 << 16) | s1);
+    p = FinishChunk(p, "IDAT", (size_t)(d - (p + 8)));
+
+    p = FinishChunk(p, "IEND", 0);
+    *size = (size_t)(p - out);
+    return out;
+}
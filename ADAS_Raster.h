@@ -0,0 +1,34 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Software MID renderer into an in-memory RGBA framebuffer.
+   - Draws the same line model as the GDI path with a built-in 5x8 bitmap font scaled to the
+     layout's cell (11x20 px cells give 10x16 px glyphs), so frames need no fonts or display.
+   - Frames encode to PPM or PNG (stored deflate, no zlib) in memory; the caller writes the file.
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Raster.h
+*/
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ADAS_Render.h"
+
+typedef struct AdasRaster {
+    int width, height;
+    uint32_t* pixels;       // row-major, no padding; bytes R,G,B,A in memory order
+} AdasRaster;
+
+// ---------------- FUNCTION DECLARATIONS ----------------
+bool AdasRasterInit(AdasRaster* r, int width, int height);
+void AdasRasterFree(AdasRaster* r);
+// renderer drawing into r (MID-local coordinates are framebuffer coordinates)
+AdasRenderer AdasRasterRenderer(AdasRaster* r);
+// FNV-1a over the pixels, for reference frames
+uint64_t AdasRasterHash(const AdasRaster* r);
+uint32_t AdasRasterPixelRgb(const AdasRaster* r, int x, int y);
+
+// encoded file in a malloc'd buffer (caller frees); NULL when out of memory
+uint8_t* AdasRasterEncodePpm(const AdasRaster* r, size_t* size);
+uint8_t* AdasRasterEncodePng(const AdasRaster* r, size_t* size);
@@ -0,0 +1,39 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Backend-independent MID drawing (see ADAS_Render.h).
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Render.c
+*/
+#include "ADAS_Render.h"
+#include "ADAS_Probe.h"
+
+bool AdasMidRectIntersect(AdasMidRect* out, AdasMidRect a, AdasMidRect b) {
+    out->left = a.left > b.left ? a.left : b.left;
+    out->top = a.top > b.top ? a.top : b.top;
+    out->right = a.right < b.right ? a.right : b.right;
+    out->bottom = a.bottom < b.bottom ? a.bottom : b.bottom;
+    return out->left < out->right && out->top < out->bottom;
+}
+
+int AdasMidRender(const AdasMidLayout* m, const AdasRenderer* r, AdasMidRect clip) {
+    AdasMidRect bounds = { 0, 0, m->width, m->height };
+    if (!AdasMidRectIntersect(&clip, clip, bounds)) return 0;
+
+    r->ops->begin(r->target, m, clip);
+    // the MID is opaque: clear the whole clip, then draw the rows on top
+    uint64_t probe = AdasProbeStart();
+    r->ops->clear(r->target, clip);
+    AdasProbeStop(ADAS_PROBE_CLEAR, probe);
+
+    probe = AdasProbeStart();
+    int drawn = 0;
+    for (int i = 0; i < m->rowCount; ++i) {
+        AdasMidRect part;
+        if (!m->rows[i].len || !AdasMidRectIntersect(&part, AdasMidRowRect(m, i), clip)) continue;
+        r->ops->text(r->target, m, i, part);
+        drawn++;
+    }
+    AdasProbeStop(ADAS_PROBE_TEXT, probe);
+    r->ops->end(r->target);
+    return drawn;
+}
@@ -0,0 +1,37 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Renderer interface behind DrawMID.
+   - AdasMidRender walks the MID line model and hands a backend the background to clear and
+     the rows to draw, clipped to the paint rectangle.
+   - Backends: GDI in the window (FOP_Mini_Prj_ADAS.c), software RGBA framebuffer (ADAS_Raster.c)
+     for headless benchmarks and reference frames.
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Render.h
+*/
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ADAS_Mid.h"
+
+// one backend; every rectangle is MID-local and already clipped to the paint rectangle
+typedef struct AdasRenderOps {
+    const char* name;
+    void (*begin)(void* target, const AdasMidLayout* m, AdasMidRect clip);
+    // fills rect with ADAS_MID_RGB_BG
+    void (*clear)(void* target, AdasMidRect rect);
+    // draws m->rows[row] in its colour; must not touch pixels outside part
+    void (*text)(void* target, const AdasMidLayout* m, int row, AdasMidRect part);
+    void (*end)(void* target);
+} AdasRenderOps;
+
+typedef struct AdasRenderer {
+    const AdasRenderOps* ops;
+    void* target;
+} AdasRenderer;
+
+// ---------------- FUNCTION DECLARATIONS ----------------
+// draws the part of the MID inside clip (MID-local); returns the number of rows drawn
+int AdasMidRender(const AdasMidLayout* m, const AdasRenderer* r, AdasMidRect clip);
+bool AdasMidRectIntersect(AdasMidRect* out, AdasMidRect a, AdasMidRect b);
@@ -0,0 +1,295 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Headless ADAS rule evaluator (headlights, FCW, TPMS, hands-off, doors, lane change).
+   The rules are the ones DrawMID used to run inline; DrawMID now calls AdasEvaluate so the
+   window and the batch tools always agree.
+   Rules are declared as a table (condition, warning, priority) over packed boolean predicates and
+   compiled once into a decision table indexed by the predicate word, so evaluation is
+   branch-free and costs the same however many rules exist.
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Rules.c
+*/
+
+// FCW thresholds must match the table bit for bit: no FMA contraction (GCC: -ffp-contract=off)
+#if defined(_MSC_VER) && !defined(__clang__)
+#pragma fp_contract(off)
+#elif defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#endif
+
+#include "ADAS_Rules.h"
+#include "ADAS_Fcw.h"
+#include "ADAS_Platform.h"
+
+#include <math.h>
+#include <string.h>
+
+// ---------------- STOPPING DISTANCE ----------------
+double StoppingDistance_m(int speed_kmh) {
+    // Reaction time = 1.8s, braking distance estimate (mu ~0.7)
+    return StoppingDistanceParams_m(speed_kmh, ADAS_REACTION_TIME_S, ADAS_FRICTION_MU);
+}
+
+double StoppingDistanceParams_m(int speed_kmh, double reaction, double mu) {
+    double v = speed_kmh * 1000.0 / 3600.0; // m/s
+    double g = ADAS_GRAVITY;
+    double reaction_distance = v * reaction;
+    double braking_distance = (v * v) / (2.0 * mu * g);
+    return reaction_distance + braking_distance;
+}
+
+// FCW adaptive threshold based on current speed + vehicle length, capped
+int32_t AdasFcwThresholdCm(int speed_kmh) {
+    return AdasFcwThresholdParamsCm(speed_kmh, ADAS_REACTION_TIME_S, ADAS_FRICTION_MU);
+}
+
+int32_t AdasFcwThresholdParamsCm(int speed_kmh, double reaction, double mu) {
+    double stopping = StoppingDistanceParams_m(speed_kmh, reaction, mu);
+    double threshold_d = stopping + VEHICLE_LENGTH_M; // include vehicle length
+    // round up to the centimetre with small margin; the cap keeps the ceil in int32 range
+    double threshold_cm = threshold_d * ADAS_CM_PER_M + ADAS_FCW_MARGIN_CM;
+    if (threshold_cm > MAX_COLLISION_THRESHOLD_CM)
+        return MAX_COLLISION_THRESHOLD_CM;
+    return (int32_t)ceil(threshold_cm);
+}
+
+// ---------------- PREDICATES ----------------
+// packed boolean inputs; the decision table is indexed by these bits
+enum {
+    PRED_NIGHT = 0,
+    PRED_HEADLIGHTS,
+    PRED_FCW,           // frontDistCm < adaptive threshold, or the TTC model's verdict
+    PRED_TYRE_LOW_1,    // tp[i] < basePressure - 4
+    PRED_TYRE_LOW_2,
+    PRED_TYRE_LOW_3,
+    PRED_TYRE_LOW_4,
+    PRED_TYRE_LEAK,     // any tyre losing pressure; which ones travels beside the mask
+    PRED_HANDS_ON,
+    PRED_DOOR_OPEN,     // any door open
+    PRED_MOVING,        // speed > 0
+    PRED_OBSTACLE,
+    PRED_DOOR_BLOCK,
+    PRED_LANE_REQ,
+    PRED_INDICATOR,     // left or right indicator on
+    PRED_COUNT
+};
+
+#define P(pred) (1u << (pred))
+
+// input groups each predicate reads (must match PackPredicates)
+static const uint32_t predicateDeps[PRED_COUNT] = {
+    ADAS_IN_NIGHT,
+    ADAS_IN_HEADLIGHTS,
+    ADAS_IN_SPEED | ADAS_IN_FRONT,
+    ADAS_IN_TPMS, ADAS_IN_TPMS, ADAS_IN_TPMS, ADAS_IN_TPMS,
+    ADAS_IN_TPMS,
+    ADAS_IN_HANDS,
+    ADAS_IN_DOORS,
+    ADAS_IN_SPEED,
+    ADAS_IN_OBSTACLE,
+    ADAS_IN_DOOR_BLOCK,
+    ADAS_IN_LANE,
+    ADAS_IN_INDICATORS,
+};
+
+// computes the predicates whose inputs are in groups; with ADAS_IN_ALL this folds to straight-line code
+static uint32_t PackPredicates(const AdasInputs* in, uint32_t groups, int32_t* threshold, bool* ttc, uint8_t* leak) {
+    uint32_t p = 0;
+    if (groups & ADAS_IN_NIGHT) p |= (uint32_t)in->nightMode << PRED_NIGHT;
+    if (groups & ADAS_IN_HEADLIGHTS) p |= (uint32_t)in->headlights << PRED_HEADLIGHTS;
+    if (groups & (ADAS_IN_SPEED | ADAS_IN_FRONT)) {
+        // adaptive threshold; slider speeds are a load from the profile's table (built-in: dry, day)
+        const AdasFcwTable* ft = in->fcwTable;
+        const int32_t* column = ft ? ft->threshold : adasFcwThresholdTable;
+        int32_t t = (unsigned)in->speed <= ADAS_SPEED_MAX ? column[in->speed]
+            : ft ? AdasFcwThresholdParamsCm(in->speed, ft->reaction, ft->mu) : AdasFcwThresholdCm(in->speed);
+        *threshold = t;
+        *ttc = in->fcwTtc;
+        p |= (uint32_t)(in->fcwTtc ? in->ttcWarning : in->frontDistCm < t) << PRED_FCW;
+    }
+    if (groups & ADAS_IN_TPMS) {
+        int low = in->basePressure - 4;
+        p |= (uint32_t)(in->tp[0] < low) << PRED_TYRE_LOW_1;
+        p |= (uint32_t)(in->tp[1] < low) << PRED_TYRE_LOW_2;
+        p |= (uint32_t)(in->tp[2] < low) << PRED_TYRE_LOW_3;
+        p |= (uint32_t)(in->tp[3] < low) << PRED_TYRE_LOW_4;
+        *leak = in->tyreLeak;
+        p |= (uint32_t)(in->tyreLeak != 0) << PRED_TYRE_LEAK;
+    }
+    if (groups & ADAS_IN_HANDS) p |= (uint32_t)in->handsOn << PRED_HANDS_ON;
+    if (groups & ADAS_IN_DOORS)
+        p |= (uint32_t)(in->doorOpen[0] | in->doorOpen[1] | in->doorOpen[2] | in->doorOpen[3]) << PRED_DOOR_OPEN;
+    if (groups & ADAS_IN_SPEED) p |= (uint32_t)(in->speed > 0) << PRED_MOVING;
+    if (groups & ADAS_IN_OBSTACLE) p |= (uint32_t)in->doorObstacle << PRED_OBSTACLE;
+    if (groups & ADAS_IN_DOOR_BLOCK) p |= (uint32_t)in->doorBlockActive << PRED_DOOR_BLOCK;
+    if (groups & ADAS_IN_LANE) p |= (uint32_t)in->laneChangeReq << PRED_LANE_REQ;
+    if (groups & ADAS_IN_INDICATORS) p |= (uint32_t)(in->leftInd | in->rightInd) << PRED_INDICATOR;
+    return p;
+}
+
+// ---------------- RULE TABLE ----------------
+// a rule fires when every whenSet predicate is true and every whenClear predicate is false.
+// To add a rule: add its warning id/text, then a row here. Rows only cost time at compile.
+typedef struct AdasRuleRow {
+    uint32_t whenSet;
+    uint32_t whenClear;
+    AdasWarningId warning;
+    uint8_t priority;
+} AdasRuleRow;
+
+static const AdasRuleRow ruleTable[] = {
+    // headlights follow the day/night switch (nightMode) rather than local time
+    { P(PRED_NIGHT),                     P(PRED_HEADLIGHTS), ADAS_WARN_HEADLIGHTS_OFF_NIGHT, ADAS_PRIO_MEDIUM },
+    { P(PRED_HEADLIGHTS),                P(PRED_NIGHT),      ADAS_WARN_HEADLIGHTS_ON_DAY,    ADAS_PRIO_LOW },
+    { P(PRED_FCW),                       0,                  ADAS_WARN_FCW,                  ADAS_PRIO_HIGH },
+    { P(PRED_TYRE_LOW_1),                0,                  ADAS_WARN_LOW_TYRE_1,           ADAS_PRIO_MEDIUM },
+    { P(PRED_TYRE_LOW_2),                0,                  ADAS_WARN_LOW_TYRE_2,           ADAS_PRIO_MEDIUM },
+    { P(PRED_TYRE_LOW_3),                0,                  ADAS_WARN_LOW_TYRE_3,           ADAS_PRIO_MEDIUM },
+    { P(PRED_TYRE_LOW_4),                0,                  ADAS_WARN_LOW_TYRE_4,           ADAS_PRIO_MEDIUM },
+    // early warning from the pressure trend, before a tyre is low
+    { P(PRED_TYRE_LEAK),                 0,                  ADAS_WARN_TYRE_LEAK,            ADAS_PRIO_LOW },
+    { 0,                                 P(PRED_HANDS_ON),   ADAS_WARN_HANDS_OFF,            ADAS_PRIO_MEDIUM },
+    { P(PRED_DOOR_OPEN) | P(PRED_MOVING),   0,               ADAS_WARN_DOOR_MOVING,          ADAS_PRIO_HIGH },
+    { P(PRED_DOOR_OPEN) | P(PRED_OBSTACLE), 0,               ADAS_WARN_DOOR_OBSTACLE,        ADAS_PRIO_HIGH },
+    { P(PRED_DOOR_BLOCK),                0,                  ADAS_WARN_DOOR_BLOCKED,         ADAS_PRIO_MEDIUM },
+    // lane change: only warn when unsafe (no indicator)
+    { P(PRED_LANE_REQ),                  P(PRED_INDICATOR),  ADAS_WARN_LANE_NO_INDICATOR,    ADAS_PRIO_LOW },
+};
+
+// ADAS_RULE_COUNT must be bumped with every row: a missing row would be an all-zero row that matches
+// every predicate word (HEADLIGHTS_OFF_NIGHT raised always)
+typedef char AdasRuleCountMatches[sizeof(ruleTable) / sizeof(ruleTable[0]) == ADAS_RULE_COUNT ? 1 : -1];
+
+// ---------------- COMPILED TABLES ----------------
+// every warning bit fits 16 bits, so 15 predicates still cost 64 KB (32 K entries x 2 bytes)
+typedef char AdasWarnMaskFits16[ADAS_WARN_COUNT <= 16 ? 1 : -1];
+static uint16_t decisionTable[1u << PRED_COUNT];    // predicate word -> warning mask
+static uint8_t warningPriority[ADAS_WARN_COUNT];
+static uint32_t mediumOrHighMask;                   // warnings with priority >= medium
+static uint32_t highMask;                           // warnings with priority high
+static uint32_t ruleDeps[ADAS_RULE_COUNT];          // input groups behind each rule row
+// dirty input groups (ADAS_IN_*) -> predicates they feed / rule rows that read them, so an
+// incremental frame costs two loads however many groups changed
+static uint32_t dirtyPredicates[ADAS_IN_ALL + 1];
+static uint8_t dirtyRules[ADAS_IN_ALL + 1];
+static volatile uint32_t rulesState;                // AdasOnceBegin
+
+void AdasRulesInit(void) {
+    if (!AdasOnceBegin(&rulesState)) return;
+
+    for (uint32_t idx = 0; idx < (1u << PRED_COUNT); idx++) {
+        uint32_t mask = 0;
+        for (int r = 0; r < ADAS_RULE_COUNT; r++) {
+            const AdasRuleRow* row = &ruleTable[r];
+            if ((idx & row->whenSet) == row->whenSet && (idx & row->whenClear) == 0)
+                mask |= ADAS_WARN_BIT(row->warning);
+        }
+        decisionTable[idx] = (uint16_t)mask;
+    }
+
+    memset(warningPriority, 0, sizeof(warningPriority));
+    mediumOrHighMask = highMask = 0;
+    for (int r = 0; r < ADAS_RULE_COUNT; r++) {
+        const AdasRuleRow* row = &ruleTable[r];
+        if (row->priority > warningPriority[row->warning]) warningPriority[row->warning] = row->priority;
+
+        uint32_t deps = 0;
+        for (int pr = 0; pr < PRED_COUNT; pr++) {
+            if ((row->whenSet | row->whenClear) & P(pr)) deps |= predicateDeps[pr];
+        }
+        ruleDeps[r] = deps;
+    }
+    for (int id = 0; id < ADAS_WARN_COUNT; id++) {
+        if (warningPriority[id] >= ADAS_PRIO_MEDIUM) mediumOrHighMask |= ADAS_WARN_BIT(id);
+        if (warningPriority[id] >= ADAS_PRIO_HIGH) highMask |= ADAS_WARN_BIT(id);
+    }
+
+    for (uint32_t d = 0; d <= ADAS_IN_ALL; d++) {
+        uint32_t preds = 0;
+        uint8_t rules = 0;
+        for (int pr = 0; pr < PRED_COUNT; pr++) {
+            if (predicateDeps[pr] & d) preds |= P(pr);
+        }
+        for (int r = 0; r < ADAS_RULE_COUNT; r++) rules += (ruleDeps[r] & d) != 0;
+        dirtyPredicates[d] = preds;
+        dirtyRules[d] = rules;
+    }
+
+    AdasOnceDone(&rulesState);
+}
+
+// highest priority as a sum of three mask tests (priorities nest: high implies >= medium)
+int AdasMaskPriority(uint32_t mask) {
+    if (!AdasOnceReady(&rulesState)) AdasRulesInit();
+    return (mask != 0) + ((mask & mediumOrHighMask) != 0) + ((mask & highMask) != 0);
+}
+
+int AdasWarningPriority(AdasWarningId id) {
+    if ((unsigned)id >= ADAS_WARN_COUNT) return ADAS_PRIO_NONE;
+    if (!AdasOnceReady(&rulesState)) AdasRulesInit();
+    return warningPriority[id];
+}
+
+uint32_t AdasRuleDeps(int rule) {
+    if ((unsigned)rule >= ADAS_RULE_COUNT) return 0;
+    if (!AdasOnceReady(&rulesState)) AdasRulesInit();
+    return ruleDeps[rule];
+}
+
+// ---------------- EVALUATION ----------------
+void AdasEvaluate(const AdasInputs* in, AdasResult* out) {
+    if (!AdasOnceReady(&rulesState)) AdasRulesInit();
+    int32_t threshold = 0;
+    bool ttc = false;
+    uint8_t leak = 0;
+    uint32_t mask = decisionTable[PackPredicates(in, ADAS_IN_ALL, &threshold, &ttc, &leak)];
+
+    out->mask = mask;
+    out->fcwThresholdCm = threshold;
+    out->fcwTtc = ttc;
+    out->leakTyres = leak;
+    out->priority = (mask != 0) + ((mask & mediumOrHighMask) != 0) + ((mask & highMask) != 0);
+}
+
+// ---------------- INCREMENTAL ----------------
+void AdasEvalCacheReset(AdasEvalCache* cache) {
+    memset(cache, 0, sizeof(*cache));
+}
+
+void AdasEvaluateIncremental(AdasEvalCache* cache, const AdasInputs* in, uint32_t dirty, AdasResult* out) {
+    if (!AdasOnceReady(&rulesState)) AdasRulesInit();
+    // first frame (or after a reset) has nothing cached
+    if (!cache->valid) dirty = ADAS_IN_ALL;
+
+    dirty &= ADAS_IN_ALL;
+
+    // refresh only predicates fed by dirty inputs, keep the rest from the last frame
+    uint32_t stale = dirtyPredicates[dirty];
+    cache->predicates = (cache->predicates & ~stale) | PackPredicates(in, dirty, &cache->fcwThresholdCm, &cache->fcwTtc, &cache->leakTyres);
+    cache->valid = true;
+
+    uint32_t evaluated = dirtyRules[dirty];
+
+    cache->frameEvaluated = evaluated;
+    cache->frameSkipped = ADAS_RULE_COUNT - evaluated;
+    cache->totalEvaluated += evaluated;
+    cache->totalSkipped += ADAS_RULE_COUNT - evaluated;
+    cache->frames++;
+
+    uint32_t mask = decisionTable[cache->predicates];
+    out->mask = mask;
+    out->fcwThresholdCm = cache->fcwThresholdCm;
+    out->fcwTtc = cache->fcwTtc;
+    out->leakTyres = cache->leakTyres;
+    out->priority = (mask != 0) + ((mask & mediumOrHighMask) != 0) + ((mask & highMask) != 0);
+}
+
+// evaluate many recorded states; masks/priorities are parallel output arrays
+void AdasEvaluateBatch(const AdasInputs* in, size_t count, uint32_t* masks, uint8_t* priorities) {
+    for (size_t i = 0; i < count; i++) {
+        AdasResult r;
+        AdasEvaluate(&in[i], &r);
+        masks[i] = r.mask;
+        if (priorities) priorities[i] = (uint8_t)r.priority;
+    }
+}
@@ -0,0 +1,149 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Headless ADAS rule evaluator shared by the Win32 MID and the batch tools.
+   - No Win32 dependency: builds with MSVC and with gcc/clang on Linux.
+   - Evaluates one vehicle state (DrawMID) or whole arrays of recorded states.
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Rules.h
+*/
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// speed trackbar (ID_SPEED) range is 0..ADAS_SPEED_MAX km/h
+#define ADAS_SPEED_MAX 180
+
+// distances are fixed-point centimetres (int32) from the slider to the FCW tables
+#define ADAS_CM_PER_M 100
+#define ADAS_DIST_MAX_M 300
+#define ADAS_DIST_MAX_CM (ADAS_DIST_MAX_M * ADAS_CM_PER_M)
+
+// FCW cap (meters): the longest distance carried, so highway thresholds are not flattened
+#define MAX_COLLISION_THRESHOLD ADAS_DIST_MAX_M
+#define MAX_COLLISION_THRESHOLD_CM ADAS_DIST_MAX_CM
+
+// small safety margin added before rounding the threshold up to the next centimetre
+#define ADAS_FCW_MARGIN_CM 50
+
+// vehicle physical length (m)
+#define VEHICLE_LENGTH_M 5.0
+
+// stopping distance model: reaction time (s), tyre-road friction, gravity (m/s^2)
+#define ADAS_REACTION_TIME_S 1.8
+#define ADAS_FRICTION_MU     0.7
+#define ADAS_GRAVITY         9.81
+
+// warning priorities (also select the beep pattern)
+#define ADAS_PRIO_NONE   0
+#define ADAS_PRIO_LOW    1
+#define ADAS_PRIO_MEDIUM 2
+#define ADAS_PRIO_HIGH   3
+
+// ---------------- WARNING IDs ----------------
+// bit position in the warning mask; order is the MID display order
+typedef enum AdasWarningId {
+    ADAS_WARN_HEADLIGHTS_OFF_NIGHT = 0,
+    ADAS_WARN_HEADLIGHTS_ON_DAY,
+    ADAS_WARN_FCW,
+    ADAS_WARN_LOW_TYRE_1,
+    ADAS_WARN_LOW_TYRE_2,
+    ADAS_WARN_LOW_TYRE_3,
+    ADAS_WARN_LOW_TYRE_4,
+    ADAS_WARN_TYRE_LEAK,            // one line for every tyre losing pressure (ADAS_Tpms.h)
+    ADAS_WARN_HANDS_OFF,
+    ADAS_WARN_DOOR_MOVING,
+    ADAS_WARN_DOOR_OBSTACLE,
+    ADAS_WARN_DOOR_BLOCKED,
+    ADAS_WARN_LANE_NO_INDICATOR,
+    ADAS_WARN_COUNT
+} AdasWarningId;
+
+#define ADAS_WARN_BIT(id) (1u << (id))
+
+// ---------------- RULES & INPUT GROUPS ----------------
+// rows in the declarative rule table (ADAS_Rules.c), one per warning today; the build fails if
+// it does not match the table
+#define ADAS_RULE_COUNT 13
+
+// input groups, used as dirty flags: a rule re-runs only when one of its inputs changed
+#define ADAS_IN_SPEED       (1u << 0)
+#define ADAS_IN_FRONT       (1u << 1)  // gap, FCW mode and table, the TTC model's verdict
+#define ADAS_IN_TPMS        (1u << 2)  // base pressure, tyre pressures and leak flags
+#define ADAS_IN_HEADLIGHTS  (1u << 3)
+#define ADAS_IN_NIGHT       (1u << 4)
+#define ADAS_IN_HANDS       (1u << 5)
+#define ADAS_IN_INDICATORS  (1u << 6)
+#define ADAS_IN_OBSTACLE    (1u << 7)
+#define ADAS_IN_LANE        (1u << 8)
+#define ADAS_IN_DOORS       (1u << 9)
+#define ADAS_IN_DOOR_BLOCK  (1u << 10)
+#define ADAS_IN_ALL         ((1u << 11) - 1)
+
+// ---------------- VEHICLE INPUTS ----------------
+// one snapshot of everything the rules read
+struct AdasFcwTable;
+
+typedef struct AdasInputs {
+    int speed;          // km/h
+    int32_t frontDistCm; // cm, 0..ADAS_DIST_MAX_CM
+    int basePressure;   // PSI
+    int tp[4];          // PSI per tyre
+    uint8_t tyreLeak;   // bit i: tyre i losing pressure (ADAS_Tpms.h)
+    bool doorOpen[4];   // 0=FL,1=FR,2=RL,3=RR
+    bool headlights;
+    bool nightMode;
+    bool handsOn;
+    bool leftInd;
+    bool rightInd;
+    bool doorObstacle;
+    bool laneChangeReq;
+    bool doorBlockActive; // door-open attempt was blocked recently
+    bool fcwTtc;        // FCW from the TTC model (ADAS_Ttc.h) instead of the frontDistCm threshold
+    bool ttcWarning;    // the TTC model's verdict, used when fcwTtc is set
+    const struct AdasFcwTable* fcwTable; // surface/night profile (ADAS_Fcw.h); NULL = dry, day
+} AdasInputs;
+
+typedef struct AdasResult {
+    uint32_t mask;         // ADAS_WARN_BIT(...) of every active warning
+    int32_t fcwThresholdCm; // adaptive FCW threshold (cm), always computed
+    bool fcwTtc;           // FCW came from the TTC model
+    int priority;          // highest active priority (ADAS_PRIO_*)
+    uint8_t leakTyres;     // tyres named by ADAS_WARN_TYRE_LEAK (bit i = tyre i)
+} AdasResult;
+
+// predicate word and FCW threshold kept between frames by AdasEvaluateIncremental
+typedef struct AdasEvalCache {
+    bool valid;
+    uint32_t predicates;
+    int32_t fcwThresholdCm;
+    bool fcwTtc;
+    uint8_t leakTyres;
+
+    // rules whose inputs changed (re-run) vs reused in the last frame, and running totals
+    uint32_t frameEvaluated;
+    uint32_t frameSkipped;
+    uint64_t totalEvaluated;
+    uint64_t totalSkipped;
+    uint64_t frames;
+} AdasEvalCache;
+
+// ---------------- FUNCTION DECLARATIONS ----------------
+// compiles the rule table into the decision table; called lazily on first use from any thread
+void AdasRulesInit(void);
+
+double StoppingDistance_m(int speed_kmh);
+double StoppingDistanceParams_m(int speed_kmh, double reaction, double mu);
+// stopping distance + vehicle length + margin, rounded up to the centimetre and capped
+int32_t AdasFcwThresholdCm(int speed_kmh);
+int32_t AdasFcwThresholdParamsCm(int speed_kmh, double reaction, double mu);
+int AdasWarningPriority(AdasWarningId id);
+int AdasMaskPriority(uint32_t mask);
+void AdasEvaluate(const AdasInputs* in, AdasResult* out);
+void AdasEvaluateBatch(const AdasInputs* in, size_t count, uint32_t* masks, uint8_t* priorities);
+
+uint32_t AdasRuleDeps(int rule);
+void AdasEvalCacheReset(AdasEvalCache* cache);
+// re-runs only the rules whose inputs are in dirty (ADAS_IN_*); same result as AdasEvaluate
+void AdasEvaluateIncremental(AdasEvalCache* cache, const AdasInputs* in, uint32_t dirty, AdasResult* out);
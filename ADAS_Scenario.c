@@ -0,0 +1,301 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Scenario parser and runner (see ADAS_Scenario.h).
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Scenario.c
+*/
+
+#include "ADAS_Scenario.h"
+#include "ADAS_Platform.h"
+#include "ADAS_Warnings.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ---------------- SCRIPT ----------------
+typedef struct OpName {
+    const char* name;
+    AdasScenarioOp op;
+    int args;               // 0, 1 (value / door) or 2 (tyre, psi or psi/min)
+    int min, max;           // integer value range: the window's slider range
+} OpName;
+
+static const OpName opNames[] = {
+    { "speed", ADAS_SCN_SPEED, 1, 0, ADAS_SPEED_MAX },
+    { "front", ADAS_SCN_FRONT, 1, 0, 0 },
+    { "base", ADAS_SCN_BASE, 1, ADAS_PSI_MIN, ADAS_PSI_MAX },
+    { "tyre", ADAS_SCN_TYRE, 2, ADAS_PSI_MIN, ADAS_PSI_MAX },
+    { "headlights", ADAS_SCN_HEADLIGHTS, 0, 0, 0 },
+    { "night", ADAS_SCN_NIGHT, 0, 0, 0 },
+    { "hands", ADAS_SCN_HANDS, 0, 0, 0 },
+    { "left", ADAS_SCN_LEFT, 0, 0, 0 },
+    { "right", ADAS_SCN_RIGHT, 0, 0, 0 },
+    { "obstacle", ADAS_SCN_OBSTACLE, 0, 0, 0 },
+    { "lane", ADAS_SCN_LANE, 0, 0, 0 },
+    { "door", ADAS_SCN_DOOR, 1, 0, 0 },
+    { "lead", ADAS_SCN_LEAD, 1, 0, ADAS_LEAD_SPEED_MAX },
+    { "fcw", ADAS_SCN_FCW_MODE, 1, 0, 0 },
+    { "surface", ADAS_SCN_SURFACE, 1, 0, 0 },
+    { "leak", ADAS_SCN_LEAK, 2, 0, 0 },
+};
+
+static const char* doorNames[4] = { "FL", "FR", "RL", "RR" };
+static const char* surfaceNames[ADAS_SURFACE_COUNT] = { "dry", "wet", "snow", "ice" };
+
+void AdasScenarioInit(AdasScenario* s) {
+    memset(s, 0, sizeof(*s));
+}
+
+void AdasScenarioFree(AdasScenario* s) {
+    free(s->events);
+    AdasScenarioInit(s);
+}
+
+static bool Push(AdasScenario* s, const AdasScenarioEvent* e) {
+    if (s->count == s->capacity) {
+        size_t cap = s->capacity ? s->capacity * 2 : 64;
+        AdasScenarioEvent* grown = (AdasScenarioEvent*)realloc(s->events, cap * sizeof(*grown));
+        if (!grown) return false;
+        s->events = grown;
+        s->capacity = cap;
+    }
+    s->events[s->count++] = *e;
+    return true;
+}
+
+// next whitespace-separated token of the line into tok; returns the position after it
+static const char* Token(const char* p, const char* end, char* tok, size_t cap) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+    size_t n = 0;
+    while (p < end && *p != ' ' && *p != '\t' && *p != '\r') {
+        if (n + 1 < cap) tok[n++] = *p;
+        p++;
+    }
+    tok[n] = '\0';
+    return p;
+}
+
+static bool ParseInt(const char* tok, long* out) {
+    char* stop;
+    if (!*tok) return false;
+    *out = strtol(tok, &stop, 10);
+    return *stop == '\0';
+}
+
+// up to two decimals ("37", "37.5", "37.25") in hundredths, without locale-dependent strtod;
+// metres to centimetres for front, PSI/min for leak
+static bool ParseHundredths(const char* tok, long maxWhole, long* out) {
+    char* stop;
+    if (*tok < '0' || *tok > '9') return false;
+    long m = strtol(tok, &stop, 10);
+    long cm = 0;
+    if (*stop == '.') {
+        int scale = 10;
+        for (stop++; *stop >= '0' && *stop <= '9' && scale; stop++, scale /= 10) cm += (*stop - '0') * scale;
+    }
+    if (*stop != '\0' || m > maxWhole) return false;
+    *out = m * 100 + cm;
+    return true;
+}
+
+static bool Fail(char* err, size_t errCap, int line, const char* why) {
+    if (err && errCap) snprintf(err, errCap, "line %d: %s", line, why);
+    return false;
+}
+
+static bool FailRange(char* err, size_t errCap, int line, const char* what, const OpName* op) {
+    if (err && errCap) snprintf(err, errCap, "line %d: %s must be %d..%d", line, what, op->min, op->max);
+    return false;
+}
+
+bool AdasScenarioParse(AdasScenario* s, const char* text, char* err, size_t errCap) {
+    AdasScenarioInit(s);
+    int line = 0;
+    uint64_t lastTick = 0;
+    bool ended = false;
+
+    for (const char* p = text; *p; ) {
+        const char* end = strchr(p, '\n');
+        if (!end) end = p + strlen(p);
+        const char* hash = memchr(p, '#', (size_t)(end - p));
+        const char* stop = hash ? hash : end;
+        const char* next = *end ? end + 1 : end;
+        line++;
+
+        char tok[32];
+        const char* q = Token(p, stop, tok, sizeof(tok));
+        p = next;
+        if (!tok[0]) continue;  // blank or comment-only line
+
+        long ms;
+        if (!ParseInt(tok, &ms) || ms < 0) { AdasScenarioFree(s); return Fail(err, errCap, line, "expected a time in ms"); }
+        uint64_t tick = (uint64_t)ms / ADAS_TICK_MS;
+        if (tick < lastTick || ended) { AdasScenarioFree(s); return Fail(err, errCap, line, "events must be in time order, before 'end'"); }
+        lastTick = tick;
+
+        q = Token(q, stop, tok, sizeof(tok));
+        if (strcmp(tok, "end") == 0) {
+            s->endTick = tick;
+            ended = true;
+            continue;
+        }
+        const OpName* op = NULL;
+        for (size_t i = 0; i < sizeof(opNames) / sizeof(opNames[0]); ++i) {
+            if (strcmp(tok, opNames[i].name) == 0) op = &opNames[i];
+        }
+        if (!op) { AdasScenarioFree(s); return Fail(err, errCap, line, "unknown event"); }
+
+        AdasScenarioEvent e = { tick, op->op, 0, 0 };
+        long a = 0, b = 0;
+        if (op->op == ADAS_SCN_DOOR) {
+            Token(q, stop, tok, sizeof(tok));
+            e.index = -1;
+            for (int d = 0; d < 4; ++d) {
+                if (strcmp(tok, doorNames[d]) == 0) e.index = d;
+            }
+            if (e.index < 0) { AdasScenarioFree(s); return Fail(err, errCap, line, "door must be FL, FR, RL or RR"); }
+        } else if (op->op == ADAS_SCN_FCW_MODE) {
+            Token(q, stop, tok, sizeof(tok));
+            if (strcmp(tok, "ttc") == 0) e.value = ADAS_FCW_TTC;
+            else if (strcmp(tok, "threshold") == 0) e.value = ADAS_FCW_THRESHOLD;
+            else { AdasScenarioFree(s); return Fail(err, errCap, line, "fcw must be ttc or threshold"); }
+        } else if (op->op == ADAS_SCN_SURFACE) {
+            Token(q, stop, tok, sizeof(tok));
+            e.value = -1;
+            for (int k = 0; k < ADAS_SURFACE_COUNT; ++k) {
+                if (strcmp(tok, surfaceNames[k]) == 0) e.value = k;
+            }
+            if (e.value < 0) { AdasScenarioFree(s); return Fail(err, errCap, line, "surface must be dry, wet, snow or ice"); }
+        } else if (op->op == ADAS_SCN_FRONT) {
+            Token(q, stop, tok, sizeof(tok));
+            if (!ParseHundredths(tok, ADAS_DIST_MAX_M, &a) || a > ADAS_DIST_MAX_CM) { AdasScenarioFree(s); return Fail(err, errCap, line, "front must be 0..300 m, to the cm"); }
+            e.value = (int)a;
+        } else if (op->args == 1) {
+            Token(q, stop, tok, sizeof(tok));
+            if (!ParseInt(tok, &a)) { AdasScenarioFree(s); return Fail(err, errCap, line, "expected a value"); }
+            if (a < op->min || a > op->max) { AdasScenarioFree(s); return FailRange(err, errCap, line, op->name, op); }
+            e.value = (int)a;
+        } else if (op->args == 2) {
+            q = Token(q, stop, tok, sizeof(tok));
+            if (!ParseInt(tok, &a) || a < 1 || a > 4) { AdasScenarioFree(s); return Fail(err, errCap, line, "tyre must be 1..4"); }
+            Token(q, stop, tok, sizeof(tok));
+            bool ok = op->op == ADAS_SCN_LEAK ? ParseHundredths(tok, 60, &b) && b <= 6000 : ParseInt(tok, &b);
+            if (!ok) { AdasScenarioFree(s); return Fail(err, errCap, line, op->op == ADAS_SCN_LEAK ? "leak must be 0..60 PSI/min" : "expected a pressure"); }
+            if (op->op == ADAS_SCN_TYRE && (b < op->min || b > op->max)) { AdasScenarioFree(s); return FailRange(err, errCap, line, "psi", op); }
+            e.index = (int)a - 1;
+            e.value = (int)b;
+        }
+        if (!Push(s, &e)) { AdasScenarioFree(s); return Fail(err, errCap, line, "out of memory"); }
+    }
+    if (!ended) s->endTick = lastTick;
+    return true;
+}
+
+// ---------------- RUNNER ----------------
+// same calls WndProc makes for the matching control
+void AdasScenarioApply(AdasVehicle* v, const AdasScenarioEvent* e) {
+    switch (e->op) {
+    case ADAS_SCN_SPEED: AdasVehicleSetSpeed(v, e->value); break;
+    case ADAS_SCN_FRONT: AdasVehicleSetFrontDistCm(v, e->value); break;
+    case ADAS_SCN_BASE: AdasVehicleSetBasePressure(v, e->value); break;
+    case ADAS_SCN_TYRE: AdasVehicleSetTyrePressure(v, e->index, e->value); break;
+    case ADAS_SCN_HEADLIGHTS: AdasVehicleToggleHeadlights(v); break;
+    case ADAS_SCN_NIGHT: AdasVehicleToggleNightMode(v); break;
+    case ADAS_SCN_HANDS: AdasVehicleToggleHandsOn(v); break;
+    case ADAS_SCN_LEFT: AdasVehicleToggleIndicator(v, ADAS_SIDE_LEFT); break;
+    case ADAS_SCN_RIGHT: AdasVehicleToggleIndicator(v, ADAS_SIDE_RIGHT); break;
+    case ADAS_SCN_OBSTACLE: AdasVehicleToggleDoorObstacle(v); break;
+    case ADAS_SCN_LANE: AdasVehicleRequestLaneChange(v); break;
+    case ADAS_SCN_DOOR: AdasVehicleToggleDoor(v, e->index); break;
+    case ADAS_SCN_LEAD: AdasVehicleSetLeadSpeed(v, e->value); break;
+    case ADAS_SCN_FCW_MODE: AdasVehicleSetFcwMode(v, (AdasFcwMode)e->value); break;
+    case ADAS_SCN_SURFACE: AdasVehicleSetSurface(v, (AdasSurface)e->value); break;
+    case ADAS_SCN_LEAK: AdasVehicleSetTyreLeak(v, e->index, e->value / 100.0f); break;
+    }
+}
+
+static uint64_t HashWord(uint64_t h, uint64_t word) {
+    for (int i = 0; i < 8; ++i) {
+        h ^= (word >> (i * 8)) & 0xFF;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+// state of one run between ticks
+typedef struct ScenarioPlay {
+    const AdasScenario* s;
+    AdasVehicle* v;
+    AdasScenarioTraceFn trace;
+    void* user;
+    AdasScenarioStats* stats;
+    AdasWarningSet shown;
+    bool first;
+    size_t next;
+} ScenarioPlay;
+
+static void PlayTick(ScenarioPlay* p, uint64_t tick) {
+    AdasVehicle* v = p->v;
+    AdasScenarioStats* stats = p->stats;
+    // timers first, then the input events of this tick; either one invalidates the MID
+    bool input = p->first;
+    bool repaint = AdasVehicleStep(v) || input;
+    while (p->next < p->s->count && p->s->events[p->next].tick == tick) {
+        AdasScenarioApply(v, &p->s->events[p->next++]);
+        stats->events++;
+        repaint = input = true;
+    }
+    if (!repaint) return;
+
+    // one MID paint: evaluate, report a changed set, gate the beep like TriggerBeepForPriority
+    AdasResult res;
+    AdasVehicleEvaluateIncremental(v, &res);
+    stats->frames++;
+    AdasWarningSet set;
+    AdasWarningSetFromResult(&set, &res);
+    bool changed = p->first || !AdasWarningSetEqual(&set, &p->shown);
+    // a repaint from the clock alone (tyre pressure, TTC readout) beeps only for a new set
+    bool beep = (input || changed) && AdasVehicleBeepDue(v, res.priority);
+    p->first = false;
+    if (!changed && !beep) return;
+
+    p->shown = set;
+    AdasScenarioTrace t = { tick, set.mask, set.fcwThresholdCm, set.fcwTtc, set.leakTyres, res.priority, beep };
+    // a TTC verdict hashes as threshold -1, so threshold-only scripts keep their hashes
+    uint32_t fcwParam = set.fcwTtc ? UINT32_MAX : (uint32_t)set.fcwThresholdCm;
+    stats->warningChanges += changed;
+    stats->beeps += beep;
+    stats->traceHash = HashWord(stats->traceHash, tick);
+    stats->traceHash = HashWord(stats->traceHash, ((uint64_t)set.mask << 32) | fcwParam);
+    // leaking tyres hash above the priority, so scripts without a puncture keep their words
+    stats->traceHash = HashWord(stats->traceHash, (uint64_t)set.leakTyres << 8 | (uint64_t)res.priority << 1 | beep);
+    if (p->trace) p->trace(p->user, &t);
+}
+
+void AdasScenarioRun(const AdasScenario* s, AdasVehicle* v, bool realtime,
+    AdasScenarioTraceFn trace, void* user, AdasScenarioStats* stats) {
+    memset(stats, 0, sizeof(*stats));
+    stats->traceHash = 14695981039346656037ull;
+
+    ScenarioPlay play = { s, v, trace, user, stats, { 0, 0, false, 0 }, true, 0 };
+    AdasClock clock;
+    AdasClockInit(&clock);
+    uint64_t start = AdasNowNs();
+    uint64_t tick = 0;
+
+    while (tick <= s->endTick) {
+        // real time: the window's tick source, whole ticks of wall time since the last wake-up,
+        // so sleeps that overshoot hand out several ticks at once
+        uint32_t due = 1;
+        if (realtime) {
+            AdasSleepMs(ADAS_TICK_MS);
+            due = AdasClockDue(&clock, AdasNowNs());
+            stats->wakeups++;
+            if (due > 1) stats->bursts++;
+        }
+        for (uint32_t i = 0; i < due && tick <= s->endTick; ++i) PlayTick(&play, tick++);
+    }
+    stats->ticks = s->endTick + 1;
+    stats->wallSeconds = (double)(AdasNowNs() - start) * 1e-9;
+}
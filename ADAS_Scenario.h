@@ -0,0 +1,99 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Scripted scenarios: timestamped slider/button events replayed through AdasVehicle.
+   - Runs on the simulation clock, so an hour of driving takes as long as the CPU needs, and the
+     warnings and beeps come out in the same order as a real-time run of the same script.
+   - Frames follow the window: the MID repaints after an input event or a timer change, and
+     beeps are only triggered from a repaint.
+   Script format, one event per line ('#' starts a comment):
+       <time ms> speed|lead <km/h>          (0..180)
+       <time ms> base <psi>                 (20..40)
+       <time ms> front <m>                  (up to two decimals, e.g. 37.25; 0..300)
+       <time ms> tyre <1..4> <psi>          (20..40)
+       <time ms> leak <1..4> <psi/min>       (puncture, up to two decimals; 0 seals it)
+       <time ms> headlights|night|hands|left|right|obstacle|lane
+       <time ms> door FL|FR|RL|RR
+       <time ms> fcw ttc|threshold
+       <time ms> surface dry|wet|snow|ice
+       <time ms> end
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Scenario.h
+*/
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ADAS_Vehicle.h"
+
+typedef enum AdasScenarioOp {
+    ADAS_SCN_SPEED = 0,
+    ADAS_SCN_FRONT,
+    ADAS_SCN_BASE,
+    ADAS_SCN_TYRE,
+    ADAS_SCN_HEADLIGHTS,
+    ADAS_SCN_NIGHT,
+    ADAS_SCN_HANDS,
+    ADAS_SCN_LEFT,
+    ADAS_SCN_RIGHT,
+    ADAS_SCN_OBSTACLE,
+    ADAS_SCN_LANE,
+    ADAS_SCN_DOOR,
+    ADAS_SCN_LEAD,
+    ADAS_SCN_FCW_MODE,
+    ADAS_SCN_SURFACE,
+    ADAS_SCN_LEAK
+} AdasScenarioOp;
+
+typedef struct AdasScenarioEvent {
+    uint64_t tick;          // simulation tick the event lands on
+    AdasScenarioOp op;
+    int index;              // tyre / door index
+    int value;              // slider value
+} AdasScenarioEvent;
+
+typedef struct AdasScenario {
+    AdasScenarioEvent* events;  // sorted by tick
+    size_t count;
+    size_t capacity;
+    uint64_t endTick;           // last tick simulated
+} AdasScenario;
+
+// one MID frame where the warning set changed or a beep burst started
+typedef struct AdasScenarioTrace {
+    uint64_t tick;
+    uint32_t mask;
+    int32_t fcwThresholdCm;
+    bool fcwTtc;            // FCW from the TTC model
+    uint8_t leakTyres;      // tyres named by TYRE_LEAK (bit i = tyre i)
+    int priority;
+    bool beep;
+} AdasScenarioTrace;
+
+typedef void (*AdasScenarioTraceFn)(void* user, const AdasScenarioTrace* trace);
+
+typedef struct AdasScenarioStats {
+    uint64_t ticks;
+    uint64_t events;
+    uint64_t frames;            // MID repaints
+    uint64_t warningChanges;
+    uint64_t beeps;
+    uint64_t traceHash;         // FNV-1a over the trace; equal hashes = same warnings and beeps
+    uint64_t wakeups;           // real time: clock reads (AdasClockDue)
+    uint64_t bursts;            // real time: reads that handed out more than one tick
+    double wallSeconds;
+} AdasScenarioStats;
+
+// ---------------- FUNCTION DECLARATIONS ----------------
+void AdasScenarioInit(AdasScenario* s);
+void AdasScenarioFree(AdasScenario* s);
+// parses a whole script; on failure returns false with "line N: reason" in err
+bool AdasScenarioParse(AdasScenario* s, const char* text, char* err, size_t errCap);
+
+void AdasScenarioApply(AdasVehicle* v, const AdasScenarioEvent* e);
+// plays the script on v from tick 0 to endTick; realtime takes ticks from the wall clock through
+// AdasClockDue as the window does (several at once after a late wake-up), otherwise it runs as
+// fast as possible. Every tick is played either way. trace may be NULL.
+void AdasScenarioRun(const AdasScenario* s, AdasVehicle* v, bool realtime,
+    AdasScenarioTraceFn trace, void* user, AdasScenarioStats* stats);
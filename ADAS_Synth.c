@@ -0,0 +1,235 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: PCM alert patterns, mixer, timeline rendering and WAV encoding (see ADAS_Synth.h).
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Synth.c
+*/
+#include "ADAS_Synth.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ADAS_Audio.h"
+
+#define SYNTH_PI 3.14159265358979323846
+
+// ---------------- PATTERNS ----------------
+// tone of n samples; no sample of a tone is 0 (a rounded 0 becomes 1, inaudible), so tone
+// edges can be found in the PCM to the sample
+static void SynthTone(int16_t* out, size_t n, int freq) {
+    double step = 2.0 * SYNTH_PI * freq / ADAS_SYNTH_RATE;
+    for (size_t i = 0; i < n; ++i) {
+        double env = 1.0;
+        if (i + 1 < ADAS_SYNTH_FADE) env = (double)(i + 1) / ADAS_SYNTH_FADE;
+        if (n - i < ADAS_SYNTH_FADE && (double)(n - i) / ADAS_SYNTH_FADE < env) env = (double)(n - i) / ADAS_SYNTH_FADE;
+        int16_t v = (int16_t)floor(ADAS_SYNTH_AMPLITUDE * env * sin(step * ((double)i + 0.5)) + 0.5);
+        out[i] = v ? v : 1;
+    }
+}
+
+bool AdasSynthInit(AdasSynth* s) {
+    memset(s, 0, sizeof(*s));
+    for (int prio = ADAS_PRIO_LOW; prio <= ADAS_PRIO_HIGH; ++prio) {
+        const AdasBeepPattern* p = AdasBeepPatternFor(prio);
+        AdasPcm* pcm = &s->patterns[prio - 1];
+        for (int i = 0; i < p->count; ++i) pcm->count += ADAS_SYNTH_SAMPLES(p->steps[i].ms);
+        pcm->samples = (int16_t*)calloc(pcm->count, sizeof(int16_t));
+        if (!pcm->samples) {
+            AdasSynthFree(s);
+            return false;
+        }
+        size_t at = 0;
+        for (int i = 0; i < p->count; ++i) {
+            size_t n = ADAS_SYNTH_SAMPLES(p->steps[i].ms);
+            if (p->steps[i].freq) SynthTone(pcm->samples + at, n, p->steps[i].freq);
+            at += n;
+        }
+    }
+    return true;
+}
+
+void AdasSynthFree(AdasSynth* s) {
+    for (int i = 0; i < ADAS_PRIO_HIGH; ++i) {
+        free(s->patterns[i].samples);
+        s->patterns[i].samples = NULL;
+        s->patterns[i].count = 0;
+    }
+}
+
+const AdasPcm* AdasSynthPattern(const AdasSynth* s, int priority) {
+    if (priority < ADAS_PRIO_LOW) return NULL;
+    if (priority > ADAS_PRIO_HIGH) priority = ADAS_PRIO_HIGH;
+    return &s->patterns[priority - 1];
+}
+
+// ---------------- MIXER ----------------
+void AdasMixerInit(AdasMixer* m, const AdasSynth* s) {
+    memset(m, 0, sizeof(*m));
+    m->synth = s;
+    m->current = -1;
+}
+
+static void StartVoice(AdasMixer* m, int priority) {
+    // a free voice, else the fading voice closest to silence
+    int slot = 0;
+    for (int i = 0; i < ADAS_MIX_VOICES; ++i) {
+        if (!m->voices[i].pcm) {
+            slot = i;
+            break;
+        }
+        if (m->voices[i].fadeLeft < m->voices[slot].fadeLeft) slot = i;
+    }
+    AdasMixVoice* v = &m->voices[slot];
+    v->pcm = AdasSynthPattern(m->synth, priority);
+    v->pos = 0;
+    v->priority = priority;
+    v->fadeLeft = 0;
+    m->current = slot;
+    AdasMixStart* log = &m->starts[m->started % ADAS_MIX_STARTS];
+    log->sample = m->position;
+    log->priority = priority;
+    m->started++;
+}
+
+bool AdasMixerAlert(AdasMixer* m, int priority) {
+    if (priority < ADAS_PRIO_LOW) return false;
+    if (priority > ADAS_PRIO_HIGH) priority = ADAS_PRIO_HIGH;
+    int playing = m->current >= 0 ? m->voices[m->current].priority : ADAS_PRIO_NONE;
+    if (priority > playing) {
+        if (m->current >= 0) {
+            m->voices[m->current].fadeLeft = ADAS_SYNTH_FADE;
+            m->preempted++;
+        }
+        StartVoice(m, priority);
+        return true;
+    }
+    if (m->queued[priority - 1] >= ADAS_MIX_QUEUE) {
+        m->dropped++;
+        return false;
+    }
+    m->queued[priority - 1]++;
+    return true;
+}
+
+void AdasMixerRender(AdasMixer* m, int16_t* out, size_t frames) {
+    for (size_t f = 0; f < frames; ++f) {
+        int32_t sum = 0;
+        for (int i = 0; i < ADAS_MIX_VOICES; ++i) {
+            AdasMixVoice* v = &m->voices[i];
+            if (!v->pcm) continue;
+            int32_t s = v->pcm->samples[v->pos++];
+            if (v->fadeLeft) s = s * (int32_t)v->fadeLeft-- / ADAS_SYNTH_FADE;
+            sum += s;
+            if (v->pos >= v->pcm->count || (v->fadeLeft == 0 && i != m->current)) {
+                v->pcm = NULL;
+                if (i == m->current) m->current = -1;
+            }
+        }
+        out[f] = (int16_t)(sum > INT16_MAX ? INT16_MAX : sum < INT16_MIN ? INT16_MIN : sum);
+        m->position++;
+        // the next queued alert, highest priority first, on the following sample
+        if (m->current < 0) {
+            for (int p = ADAS_PRIO_HIGH; p >= ADAS_PRIO_LOW; --p) {
+                if (m->queued[p - 1]) {
+                    m->queued[p - 1]--;
+                    StartVoice(m, p);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+bool AdasMixerIdle(const AdasMixer* m) {
+    for (int i = 0; i < ADAS_MIX_VOICES; ++i)
+        if (m->voices[i].pcm) return false;
+    for (int p = 0; p < ADAS_PRIO_HIGH; ++p)
+        if (m->queued[p]) return false;
+    return true;
+}
+
+size_t AdasMixerStarts(const AdasMixer* m, AdasMixStart* out, size_t max) {
+    uint64_t first = m->started > ADAS_MIX_STARTS ? m->started - ADAS_MIX_STARTS : 0;
+    size_t n = 0;
+    for (uint64_t i = first; i < m->started && n < max; ++i) out[n++] = m->starts[i % ADAS_MIX_STARTS];
+    return n;
+}
+
+// ---------------- TIMELINE ----------------
+static bool Reserve(int16_t** buf, size_t* cap, size_t need) {
+    if (need <= *cap) return true;
+    size_t n = *cap ? *cap : ADAS_SYNTH_RATE;
+    while (n < need) n *= 2;
+    int16_t* p = (int16_t*)realloc(*buf, n * sizeof(int16_t));
+    if (!p) return false;
+    *buf = p;
+    *cap = n;
+    return true;
+}
+
+size_t AdasSynthRenderTimeline(const AdasSynth* s, const AdasAlertEvent* events, size_t count, int16_t** out,
+    AdasMixer* mixer) {
+    AdasMixer m;
+    int16_t* buf = NULL;
+    size_t cap = 0, len = 0;
+    AdasMixerInit(&m, s);
+    for (size_t e = 0; e <= count; ++e) {
+        if (e < count) {
+            size_t at = ADAS_SYNTH_SAMPLES(events[e].ms);
+            if (at > len) {
+                if (!Reserve(&buf, &cap, at)) goto fail;
+                AdasMixerRender(&m, buf + len, at - len);
+                len = at;
+            }
+            AdasMixerAlert(&m, events[e].priority);
+            continue;
+        }
+        // after the last event: up to the sample where the mixer falls silent
+        while (!AdasMixerIdle(&m)) {
+            if (!Reserve(&buf, &cap, len + 1)) goto fail;
+            AdasMixerRender(&m, buf + len, 1);
+            len++;
+        }
+    }
+    *out = buf;
+    if (mixer) *mixer = m;
+    return len;
+fail:
+    free(buf);
+    *out = NULL;
+    return 0;
+}
+
+// ---------------- WAV ----------------
+static uint8_t* Put16(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    return p + 2;
+}
+
+static uint8_t* Put32(uint8_t* p, uint32_t v) {
+    return Put16(Put16(p, v & 0xFFFFu), v >> 16);
+}
+
+uint8_t* AdasWavEncode(const int16_t* samples, size_t count, size_t* size) {
+    uint32_t dataBytes = (uint32_t)(count * 2);
+    uint8_t* out = (uint8_t*)malloc(44 + (size_t)dataBytes);
+    if (!out) return NULL;
+    uint8_t* p = out;
+    memcpy(p, "RIFF", 4);
+    p = Put32(p + 4, 36 + dataBytes);
+    memcpy(p, "WAVEfmt ", 8);
+    p = Put32(p + 8, 16);
+    p = Put16(p, 1);                        // PCM
+    p = Put16(p, 1);                        // mono
+    p = Put32(p, ADAS_SYNTH_RATE);
+    p = Put32(p, ADAS_SYNTH_RATE * 2);      // bytes per second
+    p = Put16(p, 2);                        // block align
+    p = Put16(p, 16);                       // bits per sample
+    memcpy(p, "data", 4);
+    p = Put32(p + 4, dataBytes);
+    for (size_t i = 0; i < count; ++i) p = Put16(p, (uint16_t)samples[i]);
+    *size = (size_t)(p - out);
+    return out;
+}
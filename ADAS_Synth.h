@@ -0,0 +1,92 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: PCM alert engine: the beep patterns as precomputed 16-bit mono buffers and a small
+   mixer that plays alerts with the same priority rules as the audio worker (ADAS_Audio.h).
+   - No Win32 dependency: renders any alert timeline to memory or to a WAV file, so pattern
+     timing can be checked to the sample without a sound device.
+   - Tones are sines with a 2 ms linear fade in and out and never contain a 0 sample; gaps are
+     exact zeros.
+   - A higher-priority alert pre-empts the playing one at its start sample (the old voice fades
+     out over 2 ms underneath, mixed with saturation); other alerts queue per priority and start
+     on the sample after the current pattern ends.
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Synth.h
+*/
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ADAS_Rules.h"
+
+#define ADAS_SYNTH_RATE 44100       // samples per second
+#define ADAS_SYNTH_AMPLITUDE 12000  // peak of one tone (int16)
+#define ADAS_SYNTH_FADE 88          // samples, 2 ms
+#define ADAS_MIX_VOICES 4
+#define ADAS_MIX_QUEUE 8            // alerts waiting per priority, as in the audio worker
+#define ADAS_MIX_STARTS 64          // alert starts the mixer remembers
+
+// ms on the sample grid
+#define ADAS_SYNTH_SAMPLES(ms) ((size_t)(ms) * ADAS_SYNTH_RATE / 1000)
+
+typedef struct AdasPcm {
+    int16_t* samples;
+    size_t count;
+} AdasPcm;
+
+// one buffer per priority (index = priority - 1), built from AdasBeepPatternFor
+typedef struct AdasSynth {
+    AdasPcm patterns[ADAS_PRIO_HIGH];
+} AdasSynth;
+
+typedef struct AdasMixVoice {
+    const AdasPcm* pcm;             // NULL = free
+    size_t pos;
+    int priority;
+    uint32_t fadeLeft;              // > 0: pre-empted, fading out
+} AdasMixVoice;
+
+// an alert's first sample: back-to-back alerts leave no silence between them to split on
+typedef struct AdasMixStart {
+    uint64_t sample;
+    int priority;
+} AdasMixStart;
+
+typedef struct AdasMixer {
+    const AdasSynth* synth;
+    AdasMixVoice voices[ADAS_MIX_VOICES];
+    int current;                    // voice of the alert being played, -1 when none
+    uint32_t queued[ADAS_PRIO_HIGH];
+    uint64_t position;              // samples rendered
+    uint64_t started, preempted, dropped;
+    AdasMixStart starts[ADAS_MIX_STARTS];   // start n at [n % ADAS_MIX_STARTS], the last ones kept
+} AdasMixer;
+
+// an alert at a time on the timeline
+typedef struct AdasAlertEvent {
+    uint32_t ms;
+    int priority;
+} AdasAlertEvent;
+
+// ---------------- FUNCTION DECLARATIONS ----------------
+bool AdasSynthInit(AdasSynth* s);
+void AdasSynthFree(AdasSynth* s);
+const AdasPcm* AdasSynthPattern(const AdasSynth* s, int priority);
+
+void AdasMixerInit(AdasMixer* m, const AdasSynth* s);
+// an alert at the next sample to be rendered; false when its queue is full
+bool AdasMixerAlert(AdasMixer* m, int priority);
+void AdasMixerRender(AdasMixer* m, int16_t* out, size_t frames);
+// nothing playing, fading or queued
+bool AdasMixerIdle(const AdasMixer* m);
+
+// the start log in order, oldest first; returns how many entries were copied
+size_t AdasMixerStarts(const AdasMixer* m, AdasMixStart* out, size_t max);
+
+// renders events (sorted by ms) until the last alert has finished; returns the sample count,
+// *out is malloc'd (NULL and 0 on failure). mixer, if not NULL, receives the final mixer state
+size_t AdasSynthRenderTimeline(const AdasSynth* s, const AdasAlertEvent* events, size_t count, int16_t** out,
+    AdasMixer* mixer);
+// RIFF/WAVE image: 16-bit mono PCM at ADAS_SYNTH_RATE; malloc'd
+uint8_t* AdasWavEncode(const int16_t* samples, size_t count, size_t* size);
@@ -0,0 +1,92 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Streaming tyre pressure statistics and leak detection (see ADAS_Tpms.h).
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Tpms.c
+*/
+#include "ADAS_Tpms.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ---------------- KERNEL ----------------
+// Holt's linear filter in error-correction form: predict, then pull level and trend towards the
+// sample. Leak test without a square root: loss - min > gain * sd  <=>  (loss - min)^2 > gain^2 * var
+static void TpmsScalar(size_t n, const float* psi, float dt, float* level, float* trend, float* var,
+    uint32_t* samples, uint8_t* leak) {
+    const float trendGain = ADAS_TPMS_ALPHA * ADAS_TPMS_BETA / dt;
+    const float noise2 = ADAS_TPMS_NOISE_GAIN * ADAS_TPMS_NOISE_GAIN;
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t count = samples[i] + (samples[i] < UINT32_MAX);
+        // the level starts as the running mean, so the first sample's noise is not taken for a trend
+        float mean = 1.0f / ((float)count + 1.0f);
+        float alpha = mean > ADAS_TPMS_ALPHA ? mean : ADAS_TPMS_ALPHA;
+        float pred = level[i] + trend[i] * dt;
+        float r = psi[i] - pred;
+        float tr = trend[i] + trendGain * r;
+        float v = (1.0f - ADAS_TPMS_ALPHA) * (var[i] + ADAS_TPMS_ALPHA * r * r);
+        level[i] = pred + alpha * r;
+        trend[i] = tr;
+        var[i] = v;
+        samples[i] = count;
+
+        float loss = -tr * 60.0f;
+        float over = loss - ADAS_TPMS_LEAK_PSI_MIN;
+        float half = 2.0f * loss - ADAS_TPMS_LEAK_PSI_MIN;
+        int on = (over > 0.0f) & (over * over > noise2 * v);
+        int hold = (half > 0.0f) & (half * half >= noise2 * v);
+        leak[i] = (uint8_t)((count >= ADAS_TPMS_WARMUP) & (on | (leak[i] & hold)));
+    }
+}
+
+// ---------------- SOA ----------------
+bool AdasTpmsAlloc(AdasTpmsSoa* t, size_t count) {
+    memset(t, 0, sizeof(*t));
+    t->level = (float*)calloc(count ? count : 1, sizeof(float));
+    t->trend = (float*)calloc(count ? count : 1, sizeof(float));
+    t->var = (float*)calloc(count ? count : 1, sizeof(float));
+    t->samples = (uint32_t*)calloc(count ? count : 1, sizeof(uint32_t));
+    t->leak = (uint8_t*)calloc(count ? count : 1, 1);
+    if (!t->level || !t->trend || !t->var || !t->samples || !t->leak) {
+        AdasTpmsFree(t);
+        return false;
+    }
+    t->count = count;
+    return true;
+}
+
+void AdasTpmsFree(AdasTpmsSoa* t) {
+    free(t->level); free(t->trend); free(t->var); free(t->samples); free(t->leak);
+    memset(t, 0, sizeof(*t));
+}
+
+void AdasTpmsResetAll(AdasTpmsSoa* t, const float* psi) {
+    for (size_t i = 0; i < t->count; ++i) t->level[i] = psi[i];
+    memset(t->trend, 0, t->count * sizeof(float));
+    memset(t->var, 0, t->count * sizeof(float));
+    memset(t->samples, 0, t->count * sizeof(uint32_t));
+    memset(t->leak, 0, t->count);
+}
+
+void AdasTpmsStep(AdasTpmsSoa* t, const float* psi, float dt) {
+    TpmsScalar(t->count, psi, dt, t->level, t->trend, t->var, t->samples, t->leak);
+}
+
+// ---------------- ONE SENSOR ----------------
+void AdasTpmsReset(AdasTpms* s, float psi) {
+    memset(s, 0, sizeof(*s));
+    s->level = psi;
+}
+
+void AdasTpmsStepOne(AdasTpms* s, float psi, float dt) {
+    TpmsScalar(1, &psi, dt, &s->level, &s->trend, &s->var, &s->samples, &s->leak);
+}
+
+float AdasTpmsLossPerMin(const AdasTpms* s) {
+    return -s->trend * 60.0f;
+}
+
+float AdasTpmsNoise(const AdasTpms* s) {
+    return sqrtf(s->var);
+}
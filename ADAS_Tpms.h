@@ -0,0 +1,58 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Streaming tyre pressure monitoring: one sensor sample stream per tyre.
+   - Each sensor keeps O(1) state: a smoothed pressure (EWMA level), its slope (Holt trend) and
+     the variance of the samples around the prediction. Nothing is buffered.
+   - A tyre is flagged as leaking when it loses pressure faster than ADAS_TPMS_LEAK_PSI_MIN, plus
+     a margin that grows with the sensor noise, so a slow puncture is reported minutes before
+     the absolute low-pressure rule (basePressure - 4) fires; the flag clears at half that rate.
+   - Structure-of-arrays in float, branch-free, so 4 sensors x 10k vehicles at 10 Hz take a small
+     share of one core. A single sensor (AdasTpms) runs through the same kernel.
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Tpms.h
+*/
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ADAS_TPMS_SAMPLE_MS 100         // sensor rate (10 Hz)
+#define ADAS_TPMS_ALPHA 0.02f           // level smoothing per sample (~5 s)
+#define ADAS_TPMS_BETA 0.01f            // trend smoothing, relative to the level's
+#define ADAS_TPMS_WARMUP 100            // samples before a verdict (10 s)
+#define ADAS_TPMS_LEAK_PSI_MIN 0.5f     // loss rate that flags a leak on a quiet sensor (PSI/min)
+#define ADAS_TPMS_NOISE_GAIN 2.0f       // extra PSI/min needed per PSI of sample noise (std dev)
+
+// one sensor; PSI, PSI/s
+typedef struct AdasTpms {
+    float level;                    // smoothed pressure
+    float trend;                    // PSI/s, negative while losing pressure
+    float var;                      // PSI^2, samples around the prediction
+    uint32_t samples;               // since the last reset
+    uint8_t leak;
+} AdasTpms;
+
+// many sensors, one array per field
+typedef struct AdasTpmsSoa {
+    size_t count;
+    float* level;
+    float* trend;
+    float* var;
+    uint32_t* samples;
+    uint8_t* leak;
+} AdasTpmsSoa;
+
+// ---------------- FUNCTION DECLARATIONS ----------------
+bool AdasTpmsAlloc(AdasTpmsSoa* t, size_t count);
+void AdasTpmsFree(AdasTpmsSoa* t);
+// restarts every sensor at psi[i]: a pressure set by hand is not a trend
+void AdasTpmsResetAll(AdasTpmsSoa* t, const float* psi);
+
+// one sample per sensor, dt seconds after the previous one; updates level, trend, var and leak
+void AdasTpmsStep(AdasTpmsSoa* t, const float* psi, float dt);
+void AdasTpmsReset(AdasTpms* s, float psi);
+void AdasTpmsStepOne(AdasTpms* s, float psi, float dt);
+// loss rate (PSI/min, positive while losing) and noise (std dev, PSI) for displays
+float AdasTpmsLossPerMin(const AdasTpms* s);
+float AdasTpmsNoise(const AdasTpms* s);
@@ -0,0 +1,164 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Time-to-collision model kernel (see ADAS_Ttc.h).
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Ttc.c
+*/
+// the scalar kernel must match the SSE2 one: no FMA contraction (GCC: -ffp-contract=off)
+#if defined(_MSC_VER) && !defined(__clang__)
+#pragma fp_contract(off)
+#elif defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#endif
+
+#include "ADAS_Ttc.h"
+#include "ADAS_Fcw.h"
+#include "ADAS_Platform.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define ADAS_X86 1
+#include <emmintrin.h>
+#endif
+
+#if defined(ADAS_X86) && (defined(__GNUC__) || defined(__clang__))
+#define ADAS_TARGET_SSE2 __attribute__((target("sse2")))
+#else
+#define ADAS_TARGET_SSE2
+#endif
+
+// ---------------- SCALAR ----------------
+// straight-line float math with selects only; the SSE2 kernel does the same operations in the
+// same order, so both give identical results
+static void FollowScalar(size_t n, float dt, float* egoV, const float* egoA, float* leadV, const float* leadA,
+    float* gap, float* ttc, float* reqDecel, uint8_t* warn) {
+    for (size_t i = 0; i < n; ++i) {
+        float ve0 = egoV[i], vl0 = leadV[i];
+        float ve = ve0 + egoA[i] * dt;
+        float vl = vl0 + leadA[i] * dt;
+        ve = ve > 0.0f ? ve : 0.0f;
+        vl = vl > 0.0f ? vl : 0.0f;
+        // gap follows the mean relative speed over the step
+        float g = gap[i] + 0.5f * ((vl0 + vl) - (ve0 + ve)) * dt;
+        g = g > 0.0f ? g : 0.0f;
+        egoV[i] = ve;
+        leadV[i] = vl;
+        gap[i] = g;
+
+        float closing = ve - vl;
+        int closingIn = closing > 0.0f;
+        float t = g / (closingIn ? closing : 1.0f);
+        t = closingIn && t < ADAS_TTC_NONE ? t : ADAS_TTC_NONE;
+        // constant ego deceleration that stops the closing before the standstill gap:
+        // closing^2 / (2 * room) relative, less whatever the lead's own acceleration covers
+        float room = g - ADAS_TTC_STANDSTILL_M;
+        room = room > 0.01f ? room : 0.01f;
+        float need = closing * closing / (2.0f * room) - leadA[i];
+        need = closingIn && need > 0.0f ? need : 0.0f;
+        ttc[i] = t;
+        reqDecel[i] = need;
+        warn[i] = (uint8_t)(closingIn & ((t < ADAS_TTC_WARN_S) | (need > ADAS_TTC_DECEL_WARN)));
+    }
+}
+
+#ifdef ADAS_X86
+// ---------------- SSE2 ----------------
+ADAS_TARGET_SSE2
+static void FollowSse2(size_t n, float dt, float* egoV, const float* egoA, float* leadV, const float* leadA,
+    float* gap, float* ttc, float* reqDecel, uint8_t* warn) {
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    const __m128 none = _mm_set1_ps(ADAS_TTC_NONE);
+    const __m128 dtv = _mm_set1_ps(dt);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 ve0 = _mm_loadu_ps(egoV + i), vl0 = _mm_loadu_ps(leadV + i);
+        __m128 la = _mm_loadu_ps(leadA + i);
+        // max(x, 0) picks 0 for -0 and NaN, like the scalar select
+        __m128 ve = _mm_max_ps(_mm_add_ps(ve0, _mm_mul_ps(_mm_loadu_ps(egoA + i), dtv)), zero);
+        __m128 vl = _mm_max_ps(_mm_add_ps(vl0, _mm_mul_ps(la, dtv)), zero);
+        __m128 rel = _mm_sub_ps(_mm_add_ps(vl0, vl), _mm_add_ps(ve0, ve));
+        __m128 g = _mm_add_ps(_mm_loadu_ps(gap + i), _mm_mul_ps(_mm_mul_ps(half, rel), dtv));
+        g = _mm_max_ps(g, zero);
+        _mm_storeu_ps(egoV + i, ve);
+        _mm_storeu_ps(leadV + i, vl);
+        _mm_storeu_ps(gap + i, g);
+
+        __m128 closing = _mm_sub_ps(ve, vl);
+        __m128 closingIn = _mm_cmpgt_ps(closing, zero);
+        __m128 t = _mm_div_ps(g, _mm_or_ps(_mm_and_ps(closingIn, closing), _mm_andnot_ps(closingIn, one)));
+        __m128 keep = _mm_and_ps(closingIn, _mm_cmplt_ps(t, none));
+        t = _mm_or_ps(_mm_and_ps(keep, t), _mm_andnot_ps(keep, none));
+        __m128 room = _mm_max_ps(_mm_sub_ps(g, _mm_set1_ps(ADAS_TTC_STANDSTILL_M)), _mm_set1_ps(0.01f));
+        __m128 need = _mm_sub_ps(_mm_div_ps(_mm_mul_ps(closing, closing), _mm_mul_ps(two, room)), la);
+        need = _mm_and_ps(_mm_and_ps(closingIn, _mm_cmpgt_ps(need, zero)), need);
+        _mm_storeu_ps(ttc + i, t);
+        _mm_storeu_ps(reqDecel + i, need);
+        __m128 hit = _mm_and_ps(closingIn,
+            _mm_or_ps(_mm_cmplt_ps(t, _mm_set1_ps(ADAS_TTC_WARN_S)), _mm_cmpgt_ps(need, _mm_set1_ps(ADAS_TTC_DECEL_WARN))));
+        int bits = _mm_movemask_ps(hit);
+        warn[i + 0] = (uint8_t)(bits & 1);
+        warn[i + 1] = (uint8_t)((bits >> 1) & 1);
+        warn[i + 2] = (uint8_t)((bits >> 2) & 1);
+        warn[i + 3] = (uint8_t)((bits >> 3) & 1);
+    }
+    FollowScalar(n - i, dt, egoV + i, egoA + i, leadV + i, leadA + i, gap + i, ttc + i, reqDecel + i, warn + i);
+}
+#endif
+
+// ---------------- SOA ----------------
+bool AdasFollowAlloc(AdasFollowSoa* f, size_t count) {
+    memset(f, 0, sizeof(*f));
+    f->egoV = (float*)calloc(count ? count : 1, sizeof(float));
+    f->egoA = (float*)calloc(count ? count : 1, sizeof(float));
+    f->leadV = (float*)calloc(count ? count : 1, sizeof(float));
+    f->leadA = (float*)calloc(count ? count : 1, sizeof(float));
+    f->gap = (float*)calloc(count ? count : 1, sizeof(float));
+    f->ttc = (float*)calloc(count ? count : 1, sizeof(float));
+    f->reqDecel = (float*)calloc(count ? count : 1, sizeof(float));
+    f->warn = (uint8_t*)calloc(count ? count : 1, 1);
+    if (!f->egoV || !f->egoA || !f->leadV || !f->leadA || !f->gap || !f->ttc || !f->reqDecel || !f->warn) {
+        AdasFollowFree(f);
+        return false;
+    }
+    f->count = count;
+    return true;
+}
+
+void AdasFollowFree(AdasFollowSoa* f) {
+    free(f->egoV); free(f->egoA); free(f->leadV); free(f->leadA);
+    free(f->gap); free(f->ttc); free(f->reqDecel); free(f->warn);
+    memset(f, 0, sizeof(*f));
+}
+
+void AdasFollowStep(AdasFollowSoa* f, float dt) {
+#ifdef ADAS_X86
+    if (AdasFcwGetSimd() >= ADAS_SIMD_SSE2) {
+        FollowSse2(f->count, dt, f->egoV, f->egoA, f->leadV, f->leadA, f->gap, f->ttc, f->reqDecel, f->warn);
+        return;
+    }
+#endif
+    FollowScalar(f->count, dt, f->egoV, f->egoA, f->leadV, f->leadA, f->gap, f->ttc, f->reqDecel, f->warn);
+}
+
+// ---------------- ONE VEHICLE ----------------
+void AdasFollowStepOne(AdasFollow* f, float dt) {
+    FollowScalar(1, dt, &f->egoV, &f->egoA, &f->leadV, &f->leadA, &f->gap, &f->ttc, &f->reqDecel, &f->warn);
+}
+
+void AdasFollowMeasureOne(AdasFollow* f) {
+    AdasFollowStepOne(f, 0.0f);
+}
+
+static uint32_t Tenths(float x) {
+    return x < 429496729.0f ? (uint32_t)(x * 10.0f) : UINT32_MAX;
+}
+
+uint64_t AdasFollowTenths(const AdasFollow* f) {
+    uint32_t ttc = f->ttc < ADAS_TTC_NONE ? Tenths(f->ttc) : UINT32_MAX;
+    return ttc | (uint64_t)Tenths(f->reqDecel) << 32;
+}
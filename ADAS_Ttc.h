@@ -0,0 +1,70 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Longitudinal time-to-collision model for the FCW.
+   - Tracks ego and lead speed and acceleration and the gap between them; every step it
+     integrates them and computes TTC and the deceleration the ego needs to stop closing.
+   - FCW warns when the ego is closing in and TTC is under ADAS_TTC_WARN_S or the required
+     deceleration is over ADAS_TTC_DECEL_WARN, so following at a constant gap never warns.
+   - Structure-of-arrays in float, branch-free: an SSE2 kernel steps four vehicles at a time
+     (when AdasFcwGetSimd allows it), so thousands of vehicles step at 1 kHz in a fraction of a
+     millisecond. A single vehicle (AdasFollow) runs through the scalar kernel, which gives
+     bit-identical results. That needs the scalar kernel compiled without FMA contraction
+     (ADAS_Platform.h turns it off), since SSE2 rounds every product before the add.
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Ttc.h
+*/
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ADAS_TTC_STEP_S 0.001f      // model step (1 kHz)
+#define ADAS_TTC_WARN_S 2.5f        // warn below this time to collision (s)
+#define ADAS_TTC_DECEL_WARN 4.0f    // warn above this required deceleration (m/s^2, ~0.4 g)
+#define ADAS_TTC_STANDSTILL_M 2.0f  // gap left when stopped behind the lead (m)
+#define ADAS_TTC_NONE 999.0f        // TTC when not closing in
+#define ADAS_TTC_MAX_ACCEL 8.0f     // fastest speed change of either car towards a new target (m/s^2)
+
+// FCW rule in use: the TTC model, or the static stopping-distance threshold as a fallback
+typedef enum AdasFcwMode {
+    ADAS_FCW_THRESHOLD = 0,
+    ADAS_FCW_TTC
+} AdasFcwMode;
+
+// one vehicle: m/s, m/s^2, m
+typedef struct AdasFollow {
+    float egoV, egoA;
+    float leadV, leadA;
+    float gap;
+    float ttc;                      // s, ADAS_TTC_NONE when not closing
+    float reqDecel;                 // m/s^2, 0 when not closing
+    uint8_t warn;
+} AdasFollow;
+
+// many vehicles, one array per field
+typedef struct AdasFollowSoa {
+    size_t count;
+    float* egoV;
+    float* egoA;
+    float* leadV;
+    float* leadA;
+    float* gap;
+    float* ttc;
+    float* reqDecel;
+    uint8_t* warn;
+} AdasFollowSoa;
+
+// ---------------- FUNCTION DECLARATIONS ----------------
+bool AdasFollowAlloc(AdasFollowSoa* f, size_t count);
+void AdasFollowFree(AdasFollowSoa* f);
+
+// advances every vehicle by dt seconds (speeds never go below 0, nor the gap), then updates
+// ttc, reqDecel and warn
+void AdasFollowStep(AdasFollowSoa* f, float dt);
+void AdasFollowStepOne(AdasFollow* f, float dt);
+// ttc, reqDecel and warn for the current state, without moving
+void AdasFollowMeasureOne(AdasFollow* f);
+// TTC (low half) and required deceleration (high half) in truncated tenths, as displays show
+// them; a change means the readout changed
+uint64_t AdasFollowTenths(const AdasFollow* f);
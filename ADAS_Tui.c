@@ -0,0 +1,192 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Terminal MID frontend (see ADAS_Tui.h).
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Tui.c
+*/
+#include "ADAS_Tui.h"
+#include "ADAS_Probe.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <wchar.h>
+
+#define SGR_HEADER "\x1b[1;32m"
+#define SGR_WARNING "\x1b[1;38;5;202m"
+#define SGR_REVERSE "\x1b[7m"
+#define SGR_NO_REVERSE "\x1b[27m"
+#define SGR_RESET "\x1b[0m"
+#define ERASE_LINE "\x1b[K"
+
+// line keys: MID rows by version, the footer by its own version, in separate ranges
+#define KEY_ROW(version, lit) (((uint64_t)(version) << 2) | ((lit) ? 1u : 0u) | 2u)
+#define KEY_FOOTER(version) (((uint64_t)(version) << 2) | 3u)
+#define KEY_BLANK 0
+
+void AdasTuiInit(AdasTui* t, bool color) {
+    memset(t, 0, sizeof(*t));
+    t->color = color;
+    AdasMidLayoutInit(&t->mid, ADAS_TUI_MID_W, ADAS_TUI_MID_H, ADAS_TUI_CELL_H, ADAS_TUI_CELL_W);
+}
+
+void AdasTuiInvalidate(AdasTui* t) {
+    t->valid = false;
+}
+
+void AdasTuiSetFooter(AdasTui* t, const char* text) {
+    if (strcmp(t->footer, text) == 0) return;
+    snprintf(t->footer, sizeof(t->footer), "%s", text);
+    t->footerVersion++;
+}
+
+// ---------------- ENCODING ----------------
+typedef struct Out {
+    char* p;
+    size_t len, cap;
+    bool full;
+} Out;
+
+static void Put(Out* o, const char* s, size_t n) {
+    if (o->full || o->len + n > o->cap) {
+        o->full = true;
+        return;
+    }
+    memcpy(o->p + o->len, s, n);
+    o->len += n;
+}
+
+static void PutStr(Out* o, const char* s) {
+    Put(o, s, strlen(s));
+}
+
+// MID text is BMP only (ASCII and the warning sign)
+static void PutWide(Out* o, const wchar_t* s, int len) {
+    for (int i = 0; i < len; ++i) {
+        unsigned c = (unsigned)s[i];
+        char b[3];
+        if (c < 0x80) {
+            b[0] = (char)c;
+            Put(o, b, 1);
+        } else if (c < 0x800) {
+            b[0] = (char)(0xC0 | (c >> 6));
+            b[1] = (char)(0x80 | (c & 0x3F));
+            Put(o, b, 2);
+        } else {
+            b[0] = (char)(0xE0 | ((c >> 12) & 0x0F));
+            b[1] = (char)(0x80 | ((c >> 6) & 0x3F));
+            b[2] = (char)(0x80 | (c & 0x3F));
+            Put(o, b, 3);
+        }
+    }
+}
+
+static void PutMove(Out* o, int line) {
+    char b[16];
+    int n = snprintf(b, sizeof(b), "\x1b[%d;1H", line + 1);
+    Put(o, b, (size_t)n);
+}
+
+// length of the indicator word (LEFT/RIGHT) starting at text[i] of the indicators row, or 0
+static int IndicatorWordAt(const AdasMidRow* row, int i) {
+    static const wchar_t* const words[] = { L"LEFT", L"RIGHT" };
+    for (int w = 0; w < 2; ++w) {
+        int n = (int)wcslen(words[w]);
+        if (i + n <= row->len && wcsncmp(row->text + i, words[w], (size_t)n) == 0) return n;
+    }
+    return 0;
+}
+
+static void PutRow(Out* o, const AdasTui* t, const AdasMidRow* row, bool lit) {
+    // the window places warnings a few pixels in; whole cells only here
+    int indent = row->x / t->mid.charWidth;
+    for (int i = 0; i < indent; ++i) Put(o, " ", 1);
+    if (t->color) PutStr(o, row->color == ADAS_MID_COLOR_HEADER ? SGR_HEADER : SGR_WARNING);
+    // every lit word is reversed: hazard lights show both LEFT and RIGHT
+    int start = 0;
+    for (int i = 0; lit && i < row->len; ) {
+        int n = IndicatorWordAt(row, i);
+        if (!n) {
+            ++i;
+            continue;
+        }
+        PutWide(o, row->text + start, i - start);
+        PutStr(o, SGR_REVERSE);
+        PutWide(o, row->text + i, n);
+        PutStr(o, SGR_NO_REVERSE);
+        i += n;
+        start = i;
+    }
+    PutWide(o, row->text + start, row->len - start);
+    if (t->color) PutStr(o, SGR_RESET);
+}
+
+// ---------------- FRAME ----------------
+size_t AdasTuiFrame(AdasTui* t, const AdasVehicle* v, const AdasResult* res, char* out, size_t cap) {
+    AdasMidRect dirty[8];
+    AdasMidLayoutUpdate(&t->mid, v, res, dirty, 8);
+
+    uint64_t probe = AdasProbeStart();
+    Out o = { out, 0, cap, false };
+    if (!t->valid) {
+        // hide the cursor, clear, forget what is on screen
+        PutStr(&o, "\x1b[?25l\x1b[H\x1b[2J");
+        for (int i = 0; i < ADAS_TUI_MAX_LINES; ++i) t->lineKey[i] = KEY_BLANK;
+        t->lineCount = 0;
+    }
+
+    // the indicators row is lit in the on phase of the blink
+    int indicatorRow = AdasMidSegmentRow(ADAS_MID_SEG_INDICATORS);
+    int rows = t->mid.rowCount;
+    int lines = t->footer[0] ? rows + 2 : rows;
+    int drawn = lines > t->lineCount ? lines : t->lineCount;
+    uint64_t fullBytes = 0;
+
+    for (int i = 0; i < drawn && i < ADAS_TUI_MAX_LINES; ++i) {
+        uint64_t key = KEY_BLANK;
+        const AdasMidRow* row = NULL;
+        bool lit = false;
+        if (i < rows) {
+            row = &t->mid.rows[i];
+            lit = i == indicatorRow && v->blinkOn;
+            key = row->len ? KEY_ROW(row->version, lit) : KEY_BLANK;
+        } else if (i == rows + 1 && t->footer[0]) {
+            key = KEY_FOOTER(t->footerVersion);
+        }
+
+        if (key == t->lineKey[i]) {
+            fullBytes += (uint64_t)t->lineBytes[i];
+            continue;
+        }
+        size_t start = o.len;
+        PutMove(&o, i);
+        if (row && key != KEY_BLANK) PutRow(&o, t, row, lit);
+        else if (key != KEY_BLANK) PutStr(&o, t->footer);
+        PutStr(&o, ERASE_LINE);
+        t->lineKey[i] = key;
+        t->lineBytes[i] = (int)(o.len - start);
+        fullBytes += (uint64_t)t->lineBytes[i];
+        t->stats.linesWritten++;
+    }
+    t->lineCount = lines;
+    AdasProbeStop(ADAS_PROBE_TEXT, probe);
+
+    if (o.full) {
+        // did not fit: nothing partial goes out, redraw everything next frame
+        t->valid = false;
+        return 0;
+    }
+    t->valid = true;
+    t->stats.frames++;
+    t->stats.bytes += o.len;
+    t->stats.fullBytes += fullBytes;
+    return o.len;
+}
+
+size_t AdasTuiRestore(const AdasTui* t, char* out, size_t cap) {
+    Out o = { out, 0, cap, false };
+    char b[32];
+    // cursor below the last line, attributes reset, cursor shown
+    int n = snprintf(b, sizeof(b), "\x1b[%d;1H" SGR_RESET "\x1b[?25h", t->lineCount + 1);
+    Put(&o, b, (size_t)n);
+    return o.full ? 0 : o.len;
+}
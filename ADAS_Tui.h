@@ -0,0 +1,63 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Terminal MID frontend: the MID line model as ANSI/VT text.
+   - Row i of the MID line model is terminal line i + 1, wrapped exactly like the window (the
+     layout uses the window's 96 dpi MID size and cell metrics), header in green, warnings in
+     orange, the active indicator in reverse video while the blink phase is on.
+   - Each frame writes only the lines whose row version or blink phase changed: cursor move,
+     text, erase to end of line. An unchanged frame writes nothing.
+   - Builds escape sequences into a caller buffer and does no I/O, so it is Win32- and
+     termios-free; adas_headless tui owns the terminal.
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Tui.h
+*/
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ADAS_Mid.h"
+
+// the window's MID at 96 dpi: 580x620 px, Consolas 20 bold cells
+#define ADAS_TUI_MID_W 580
+#define ADAS_TUI_MID_H 620
+#define ADAS_TUI_CELL_W 11
+#define ADAS_TUI_CELL_H 20
+
+#define ADAS_TUI_FOOTER_CHARS 224
+// MID rows, a blank line and the footer
+#define ADAS_TUI_MAX_LINES (ADAS_MID_MAX_ROWS + 2)
+#define ADAS_TUI_LINE_MAX 512                // escapes + UTF-8 text of one line
+#define ADAS_TUI_FRAME_MAX (ADAS_TUI_MAX_LINES * ADAS_TUI_LINE_MAX + 64)
+
+typedef struct AdasTuiStats {
+    uint64_t frames;
+    uint64_t linesWritten;
+    uint64_t bytes;             // escape sequences + text written
+    uint64_t fullBytes;         // what redrawing every line every frame would have written
+} AdasTuiStats;
+
+typedef struct AdasTui {
+    AdasMidLayout mid;
+    bool color;                 // SGR colours; off still uses cursor moves and reverse video
+    bool valid;                 // false: the next frame clears the screen and draws every line
+    uint64_t lineKey[ADAS_TUI_MAX_LINES];    // what each screen line shows (0 = blank)
+    int lineBytes[ADAS_TUI_MAX_LINES];
+    int lineCount;              // screen lines in use
+    char footer[ADAS_TUI_FOOTER_CHARS];
+    uint32_t footerVersion;
+    AdasTuiStats stats;
+} AdasTui;
+
+// ---------------- FUNCTION DECLARATIONS ----------------
+void AdasTuiInit(AdasTui* t, bool color);
+// the next frame redraws the whole screen (start, terminal resize, screen garbled)
+void AdasTuiInvalidate(AdasTui* t);
+// plain ASCII line under the MID (key help, status)
+void AdasTuiSetFooter(AdasTui* t, const char* text);
+// brings the screen from the previous frame to this state; writes at most cap bytes
+// (ADAS_TUI_FRAME_MAX always fits a whole frame) and returns how many
+size_t AdasTuiFrame(AdasTui* t, const AdasVehicle* v, const AdasResult* res, char* out, size_t cap);
+// escape sequences that leave the terminal as it was before the first frame
+size_t AdasTuiRestore(const AdasTui* t, char* out, size_t cap);
@@ -0,0 +1,297 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Vehicle state operations (sliders, toggles, doors, lane change, beep gate).
+   The behaviour is what WndProc used to do directly on the globals; the timers that used to
+   compare GetTickCount expiries are tick countdowns advanced by AdasVehicleStep.
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Vehicle.c
+*/
+
+#include "ADAS_Vehicle.h"
+
+#include <math.h>
+#include <string.h>
+
+#define DOOR_BLOCK_TICKS ADAS_MS_TO_TICKS(ADAS_DOOR_BLOCK_WARN_MS)
+#define LANE_MSG_TICKS   ADAS_MS_TO_TICKS(ADAS_LANE_MSG_MS)
+#define BEEP_TICKS       ADAS_MS_TO_TICKS(ADAS_BEEP_SPACING_MS)
+#define BLINK_TICKS      ADAS_MS_TO_TICKS(ADAS_BLINK_MS)
+#define TPMS_TICKS       ADAS_MS_TO_TICKS(ADAS_TPMS_SAMPLE_MS)
+#define FOLLOW_SUBSTEPS  ((int)(ADAS_TICK_MS * 0.001f / ADAS_TTC_STEP_S + 0.5f))
+
+// ---------------- INIT ----------------
+void AdasVehicleInit(AdasVehicle* v) {
+    memset(v, 0, sizeof(*v));
+    v->frontDistCm = ADAS_FRONT_START_CM;
+    v->follow.gap = (float)v->frontDistCm / ADAS_CM_PER_M;
+    v->follow.ttc = ADAS_TTC_NONE;
+    v->basePressure = 32;
+    for (int i = 0; i < 4; ++i) {
+        v->tp[i] = 32;
+        v->tyrePsi[i] = 32.0f;
+        AdasTpmsReset(&v->tpms[i], v->tyrePsi[i]);
+    }
+    v->tpmsTicks = TPMS_TICKS;
+    v->handsOn = true;
+    v->fcwTable = AdasFcwProfileTable(ADAS_SURFACE_DRY, false);
+    AdasLimiterInit(&v->beeps, BEEP_TICKS, 1);
+}
+
+// ---------------- SLIDERS ----------------
+// setters only mark inputs dirty when the value really changes (trackbars repeat positions)
+void AdasVehicleSetSpeed(AdasVehicle* v, int speed) {
+    if (v->speed == speed) return;
+    v->speed = speed;
+    v->dirty |= ADAS_IN_SPEED;
+}
+
+void AdasVehicleSetFrontDistCm(AdasVehicle* v, int32_t frontDistCm) {
+    // in TTC mode the gap may be past the capped frontDistCm, so a repeat still places the lead
+    v->follow.gap = (float)frontDistCm / ADAS_CM_PER_M;
+    if (v->frontDistCm == frontDistCm) return;
+    v->frontDistCm = frontDistCm;
+    v->dirty |= ADAS_IN_FRONT;
+}
+
+void AdasVehicleSetLeadSpeed(AdasVehicle* v, int leadSpeed) {
+    // takes effect on the next tick; the verdict only changes through the model
+    v->leadSpeed = leadSpeed;
+}
+
+void AdasVehicleSetFcwMode(AdasVehicle* v, AdasFcwMode mode) {
+    if (v->fcwMode == mode) return;
+    v->fcwMode = mode;
+    v->follow.gap = (float)v->frontDistCm / ADAS_CM_PER_M;
+    v->follow.egoV = v->speed / 3.6f;
+    v->follow.leadV = v->leadSpeed / 3.6f;
+    AdasFollowMeasureOne(&v->follow);
+    v->dirty |= ADAS_IN_FRONT;
+}
+
+void AdasVehicleSetBasePressure(AdasVehicle* v, int psi) {
+    v->basePressure = psi;
+    for (int i = 0; i < 4; ++i) {
+        v->tp[i] = psi;
+        v->tyrePsi[i] = (float)psi;
+        AdasTpmsReset(&v->tpms[i], v->tyrePsi[i]);
+    }
+    v->tyreLeak = 0;
+    v->dirty |= ADAS_IN_TPMS;
+}
+
+void AdasVehicleSetTyrePressure(AdasVehicle* v, int tyre, int psi) {
+    // against the sensor's pressure, not the rounded readout: setting the shown value by hand
+    // while the tyre is leaking still restarts the sensor
+    if (tyre < 0 || tyre >= 4 || v->tyrePsi[tyre] == (float)psi) return;
+    v->tp[tyre] = psi;
+    v->tyrePsi[tyre] = (float)psi;
+    AdasTpmsReset(&v->tpms[tyre], v->tyrePsi[tyre]);
+    v->tyreLeak &= (uint8_t)~(1u << tyre);
+    v->dirty |= ADAS_IN_TPMS;
+}
+
+void AdasVehicleSetTyreLeak(AdasVehicle* v, int tyre, float psiPerMin) {
+    if (tyre < 0 || tyre >= 4) return;
+    // the sensors find it; no rule input changes here
+    v->leakRate[tyre] = psiPerMin > 0.0f ? psiPerMin : 0.0f;
+}
+
+int AdasVehicleNextPuncture(AdasVehicle* v) {
+    int next = 0;
+    for (int i = 0; i < 4; ++i) {
+        if (v->leakRate[i] > 0.0f) next = i + 1;
+        v->leakRate[i] = 0.0f;
+    }
+    if (next == 4) return -1;
+    v->leakRate[next] = ADAS_PUNCTURE_PSI_MIN;
+    return next;
+}
+
+// ---------------- TOGGLES ----------------
+void AdasVehicleToggleHeadlights(AdasVehicle* v) { v->headlights = !v->headlights; v->dirty |= ADAS_IN_HEADLIGHTS; }
+void AdasVehicleToggleHandsOn(AdasVehicle* v) { v->handsOn = !v->handsOn; v->dirty |= ADAS_IN_HANDS; }
+void AdasVehicleToggleDoorObstacle(AdasVehicle* v) { v->doorObstacle = !v->doorObstacle; v->dirty |= ADAS_IN_OBSTACLE; }
+
+// surface and night select the FCW threshold table: a pointer swap, the table is built once
+void AdasVehicleToggleNightMode(AdasVehicle* v) {
+    v->nightMode = !v->nightMode;
+    v->fcwTable = AdasFcwProfileTable(v->surface, v->nightMode);
+    v->dirty |= ADAS_IN_NIGHT | ADAS_IN_FRONT;
+}
+
+void AdasVehicleSetSurface(AdasVehicle* v, AdasSurface surface) {
+    if ((unsigned)surface >= ADAS_SURFACE_COUNT || v->surface == surface) return;
+    v->surface = surface;
+    v->fcwTable = AdasFcwProfileTable(surface, v->nightMode);
+    v->dirty |= ADAS_IN_FRONT;
+}
+
+void AdasVehicleToggleIndicator(AdasVehicle* v, AdasSide side) {
+    if (side == ADAS_SIDE_LEFT) {
+        v->leftInd = !v->leftInd;
+        if (v->leftInd) v->rightInd = false;
+    } else {
+        v->rightInd = !v->rightInd;
+        if (v->rightInd) v->leftInd = false;
+    }
+    // an indicator starts lit and then blinks with the clock
+    v->blinkOn = v->leftInd || v->rightInd;
+    v->blinkTicks = v->blinkOn ? BLINK_TICKS : 0;
+    v->dirty |= ADAS_IN_INDICATORS;
+}
+
+// ---------------- LANE CHANGE & DOORS ----------------
+void AdasVehicleRequestLaneChange(AdasVehicle* v) {
+    // ensure message stays visible at least 1 second
+    v->laneMsgTicks = LANE_MSG_TICKS;
+    v->laneChangeReq = true;
+    v->dirty |= ADAS_IN_LANE;
+}
+
+bool AdasVehicleToggleDoor(AdasVehicle* v, int door) {
+    if (door < 0 || door >= 4) return false;
+    // block opening if obstacle present or vehicle moving
+    bool tryingToOpen = !v->doorOpen[door];
+    if (tryingToOpen && (v->doorObstacle || v->speed > 0)) {
+        if (v->doorBlockTicks == 0) v->dirty |= ADAS_IN_DOOR_BLOCK;
+        v->doorBlockTicks = DOOR_BLOCK_TICKS;
+        return false;
+    }
+    v->doorOpen[door] = !v->doorOpen[door];
+    v->dirty |= ADAS_IN_DOORS;
+    return true;
+}
+
+// ---------------- CLOCK ----------------
+// the acceleration that closes dv (m/s) within one tick, capped at what a car can do
+static float FollowAccel(float dv) {
+    float a = dv / (FOLLOW_SUBSTEPS * ADAS_TTC_STEP_S);
+    return a > ADAS_TTC_MAX_ACCEL ? ADAS_TTC_MAX_ACCEL : a < -ADAS_TTC_MAX_ACCEL ? -ADAS_TTC_MAX_ACCEL : a;
+}
+
+static bool StepFollow(AdasVehicle* v) {
+    AdasFollow* f = &v->follow;
+    uint64_t shown = AdasFollowTenths(f);
+    uint8_t warn = f->warn;
+    // the sliders and scripts set target speeds: each car accelerates towards its own, so a
+    // change reaches the model as an acceleration (a braking lead raises reqDecel)
+    f->egoA = FollowAccel(v->speed / 3.6f - f->egoV);
+    f->leadA = FollowAccel(v->leadSpeed / 3.6f - f->leadV);
+    for (int i = 0; i < FOLLOW_SUBSTEPS; ++i) AdasFollowStepOne(f, ADAS_TTC_STEP_S);
+
+    // the gap may run past the cap when the lead pulls away; clamp before converting
+    float gapCm = f->gap * ADAS_CM_PER_M;
+    int32_t dist = gapCm < ADAS_DIST_MAX_CM ? (int32_t)lrintf(gapCm) : ADAS_DIST_MAX_CM;
+    bool changed = AdasFollowTenths(f) != shown;
+    if (dist != v->frontDistCm || f->warn != warn) {
+        v->frontDistCm = dist;
+        v->dirty |= ADAS_IN_FRONT;
+        changed = true;
+    }
+    return changed;
+}
+
+// one sensor sample per tyre every TPMS_TICKS: bleed punctures, round for the rules, feed the detector
+static bool StepTpms(AdasVehicle* v) {
+    if (--v->tpmsTicks) return false;
+    v->tpmsTicks = TPMS_TICKS;
+    bool changed = false;
+    uint8_t leak = 0;
+    for (int i = 0; i < 4; ++i) {
+        float psi = v->tyrePsi[i] - v->leakRate[i] * (ADAS_TPMS_SAMPLE_MS / 60000.0f);
+        v->tyrePsi[i] = psi > 0.0f ? psi : 0.0f;
+        int shown = (int)lrintf(v->tyrePsi[i]);
+        if (shown != v->tp[i]) {
+            v->tp[i] = shown;
+            changed = true;
+        }
+        AdasTpmsStepOne(&v->tpms[i], v->tyrePsi[i], ADAS_TPMS_SAMPLE_MS * 0.001f);
+        leak |= (uint8_t)(v->tpms[i].leak << i);
+    }
+    if (leak != v->tyreLeak) {
+        v->tyreLeak = leak;
+        changed = true;
+    }
+    if (changed) v->dirty |= ADAS_IN_TPMS;
+    return changed;
+}
+
+bool AdasVehicleStep(AdasVehicle* v) {
+    bool changed = v->fcwMode == ADAS_FCW_TTC && StepFollow(v);
+    if (StepTpms(v)) changed = true;
+    if (v->doorBlockTicks && --v->doorBlockTicks == 0) {
+        v->dirty |= ADAS_IN_DOOR_BLOCK;
+        changed = true;
+    }
+    // expire lane message
+    if (v->laneMsgTicks && --v->laneMsgTicks == 0) {
+        v->laneChangeReq = false;
+        v->dirty |= ADAS_IN_LANE;
+        changed = true;
+    }
+    v->ticks++;
+    if (v->blinkTicks && --v->blinkTicks == 0) {
+        v->blinkOn = !v->blinkOn;
+        v->blinkTicks = BLINK_TICKS;
+        changed = true;
+    }
+    return changed;
+}
+
+// ---------------- EVALUATION ----------------
+void AdasVehicleInputs(const AdasVehicle* v, AdasInputs* out) {
+    out->speed = v->speed;
+    out->frontDistCm = v->frontDistCm;
+    out->basePressure = v->basePressure;
+    for (int i = 0; i < 4; ++i) {
+        out->tp[i] = v->tp[i];
+        out->doorOpen[i] = v->doorOpen[i];
+    }
+    out->tyreLeak = v->tyreLeak;
+    out->headlights = v->headlights;
+    out->nightMode = v->nightMode;
+    out->handsOn = v->handsOn;
+    out->leftInd = v->leftInd;
+    out->rightInd = v->rightInd;
+    out->doorObstacle = v->doorObstacle;
+    out->laneChangeReq = v->laneChangeReq;
+    // door open attempts blocked -> temporary warning
+    out->doorBlockActive = v->doorBlockTicks > 0;
+    out->fcwTtc = v->fcwMode == ADAS_FCW_TTC;
+    out->ttcWarning = v->follow.warn != 0;
+    out->fcwTable = v->fcwTable;
+}
+
+void AdasVehicleEvaluate(const AdasVehicle* v, AdasResult* out) {
+    AdasInputs in;
+    AdasVehicleInputs(v, &in);
+    AdasEvaluate(&in, out);
+}
+
+void AdasVehicleEvaluateIncremental(AdasVehicle* v, AdasResult* out) {
+    AdasInputs in;
+    AdasVehicleInputs(v, &in);
+    AdasEvaluateIncremental(&v->eval, &in, v->dirty, out);
+    v->dirty = 0;
+}
+
+bool AdasVehicleBeepDue(AdasVehicle* v, int priority) {
+    // avoid continuous repetition: at least 800ms between beep bursts of one priority
+    if (priority <= ADAS_PRIO_NONE) return false;
+    return AdasLimiterAllow(&v->beeps, priority, v->ticks);
+}
+
+// ---------------- FLEET ----------------
+void AdasFleetStep(AdasVehicle* vehicles, size_t count) {
+    for (size_t i = 0; i < count; ++i) AdasVehicleStep(&vehicles[i]);
+}
+
+void AdasFleetEvaluate(const AdasVehicle* vehicles, size_t count,
+    uint32_t* masks, uint8_t* priorities) {
+    for (size_t i = 0; i < count; ++i) {
+        AdasResult r;
+        AdasVehicleEvaluate(&vehicles[i], &r);
+        masks[i] = r.mask;
+        if (priorities) priorities[i] = (uint8_t)r.priority;
+    }
+}
@@ -0,0 +1,147 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Self-contained vehicle state and the operations the UI performs on it.
+   - Replaces the old process-wide globals, so one process can host many independent vehicles.
+   - No Win32 dependency and no wall clock: timed behaviour advances only through AdasVehicleStep,
+     one fixed simulation tick (ADAS_Clock.h) per call.
+   - A vehicle is not shared between threads; different vehicles can be driven in parallel.
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Vehicle.h
+*/
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ADAS_Rules.h"
+#include "ADAS_Clock.h"
+#include "ADAS_Limiter.h"
+#include "ADAS_Ttc.h"
+#include "ADAS_Fcw.h"
+#include "ADAS_Tpms.h"
+
+// door index: 0=FL,1=FR,2=RL,3=RR
+#define ADAS_DOOR_FL 0
+#define ADAS_DOOR_FR 1
+#define ADAS_DOOR_RL 2
+#define ADAS_DOOR_RR 3
+
+typedef enum AdasSide {
+    ADAS_SIDE_LEFT = 0,
+    ADAS_SIDE_RIGHT
+} AdasSide;
+
+// timed behaviour (ms), counted in simulation ticks
+#define ADAS_DOOR_BLOCK_WARN_MS 2000 // blocked door-open warning stays visible
+#define ADAS_LANE_MSG_MS        1000 // lane change message stays visible at least this long
+#define ADAS_BEEP_SPACING_MS    800  // minimum gap between beep bursts of one priority
+#define ADAS_BLINK_MS           500  // indicator blink half-period
+
+#define ADAS_FRONT_START_CM 5000    // front distance at start (cm)
+#define ADAS_LEAD_SPEED_MAX 180     // km/h
+#define ADAS_PSI_MIN 20             // base and tyre pressure slider range (PSI)
+#define ADAS_PSI_MAX 40
+#define ADAS_PUNCTURE_PSI_MIN 1.0f  // slow puncture of the UI button / key
+
+typedef struct AdasVehicle {
+    int speed;          // km/h
+    int32_t frontDistCm; // cm; in TTC mode the model's gap, rounded and capped at ADAS_DIST_MAX_CM
+    int leadSpeed;      // km/h, vehicle ahead (TTC mode)
+    int basePressure;   // PSI
+    int tp[4];          // PSI per tyre
+
+    bool headlights;
+    bool nightMode;
+    bool handsOn;
+    bool leftInd, rightInd;
+    bool doorObstacle;
+    bool laneChangeReq;
+    bool doorOpen[4];
+
+    // blinking state for indicators
+    bool blinkOn;
+
+    // countdowns in simulation ticks; 0 = not running
+    uint32_t doorBlockTicks;    // blocked door-open warning
+    uint32_t laneMsgTicks;      // lane change message
+    uint32_t blinkTicks;        // until the next blink flip
+    uint64_t ticks;             // simulation time since init
+
+    // threshold table of the road surface and day/night; swapped when either changes
+    AdasSurface surface;
+    const AdasFcwTable* fcwTable;
+
+    // FCW rule; in TTC mode the gap follows ego and lead speed at 1 kHz inside each tick, and
+    // speed and leadSpeed are targets both cars reach at up to ADAS_TTC_MAX_ACCEL
+    AdasFcwMode fcwMode;
+    AdasFollow follow;
+
+    // what the tyre sensors read (tp[] is this rounded), the puncture bleeding each tyre, and
+    // the streaming leak detector sampled every ADAS_TPMS_SAMPLE_MS
+    float tyrePsi[4];
+    float leakRate[4];          // PSI/min, 0 = no puncture
+    AdasTpms tpms[4];
+    uint8_t tyreLeak;           // bit i: tpms[i].leak
+    uint32_t tpmsTicks;         // until the next sensor sample
+
+    // beep spacing per priority, in ticks
+    AdasAlertLimiter beeps;
+
+    // ADAS_IN_* groups changed since the last incremental evaluation
+    uint32_t dirty;
+    AdasEvalCache eval;
+} AdasVehicle;
+
+// ---------------- FUNCTION DECLARATIONS ----------------
+void AdasVehicleInit(AdasVehicle* v);
+
+void AdasVehicleSetSpeed(AdasVehicle* v, int speed);
+// in TTC mode this also puts the lead back at frontDistCm
+void AdasVehicleSetFrontDistCm(AdasVehicle* v, int32_t frontDistCm);
+void AdasVehicleSetLeadSpeed(AdasVehicle* v, int leadSpeed);
+// switching rule restarts the model from the current frontDistCm
+void AdasVehicleSetFcwMode(AdasVehicle* v, AdasFcwMode mode);
+// base pressure change re-syncs all four tyres to the new base
+// a pressure set by hand restarts that tyre's leak detector (inflating is not a trend); it does
+// not seal a puncture: AdasVehicleSetTyreLeak(v, tyre, 0) does
+void AdasVehicleSetBasePressure(AdasVehicle* v, int psi);
+void AdasVehicleSetTyrePressure(AdasVehicle* v, int tyre, int psi);
+// a puncture: the tyre loses psiPerMin from the next sensor sample on; 0 seals it
+void AdasVehicleSetTyreLeak(AdasVehicle* v, int tyre, float psiPerMin);
+// moves a single ADAS_PUNCTURE_PSI_MIN puncture to the next tyre (none, T1..T4, none);
+// returns the punctured tyre, -1 for none
+int AdasVehicleNextPuncture(AdasVehicle* v);
+
+void AdasVehicleToggleHeadlights(AdasVehicle* v);
+// night also lengthens the reaction time of the FCW threshold
+void AdasVehicleToggleNightMode(AdasVehicle* v);
+void AdasVehicleSetSurface(AdasVehicle* v, AdasSurface surface);
+void AdasVehicleToggleHandsOn(AdasVehicle* v);
+void AdasVehicleToggleDoorObstacle(AdasVehicle* v);
+// indicators are mutually exclusive
+void AdasVehicleToggleIndicator(AdasVehicle* v, AdasSide side);
+
+void AdasVehicleRequestLaneChange(AdasVehicle* v);
+// returns false when opening was blocked (obstacle or moving); the door stays closed
+bool AdasVehicleToggleDoor(AdasVehicle* v, int door);
+
+// advances every timer, the tyre sensors and, in TTC mode, the gap by one simulation tick; returns
+// true if a timer changed a rule input (warning expired), the blink phase, a shown gap/TTC value
+// or a tyre pressure or leak flag, i.e. the MID needs a repaint
+bool AdasVehicleStep(AdasVehicle* v);
+
+void AdasVehicleInputs(const AdasVehicle* v, AdasInputs* out);
+void AdasVehicleEvaluate(const AdasVehicle* v, AdasResult* out);
+// re-runs only rules whose inputs changed since the previous call (paint path)
+void AdasVehicleEvaluateIncremental(AdasVehicle* v, AdasResult* out);
+// applies the per-priority beep spacing (a higher priority is never held back by a lower one's);
+// returns true if a burst for this priority should play now
+bool AdasVehicleBeepDue(AdasVehicle* v, int priority);
+
+// ---------------- FLEET ----------------
+// one tick for vehicles[0..count)
+void AdasFleetStep(AdasVehicle* vehicles, size_t count);
+// evaluates vehicles[0..count) into parallel arrays; safe to call on disjoint slices from many threads
+void AdasFleetEvaluate(const AdasVehicle* vehicles, size_t count,
+    uint32_t* masks, uint8_t* priorities);
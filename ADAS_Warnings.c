@@ -0,0 +1,141 @@
+﻿/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Warning set helpers and the MID string table.
+   Text is assembled by copying precomputed strings; no wcscat scans, no fixed 512-wchar limit.
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Warnings.c
+*/
+
+#include "ADAS_Warnings.h"
+
+// ---------------- STRING TABLE ----------------
+typedef struct WarningString {
+    const wchar_t* text;
+    size_t len;
+} WarningString;
+
+#define WSTR(s) { s, sizeof(s) / sizeof(wchar_t) - 1 }
+
+// MID text per warning id, in display order
+static const WarningString warningStrings[ADAS_WARN_COUNT] = {
+    WSTR(L"⚠ Headlights OFF (night)"),
+    WSTR(L"⚠ Headlights ON (day)"),
+    WSTR(L"⚠ Forward Collision Warning (threshold "),
+    WSTR(L"⚠ Low Tyre Pressure (T1)"),
+    WSTR(L"⚠ Low Tyre Pressure (T2)"),
+    WSTR(L"⚠ Low Tyre Pressure (T3)"),
+    WSTR(L"⚠ Low Tyre Pressure (T4)"),
+    WSTR(L"⚠ Tyre Losing Pressure:"),
+    WSTR(L"⚠ Hands Off Steering"),
+    WSTR(L"⚠ Door Open While Moving"),
+    WSTR(L"⚠ Exit Warning: Obstacle Detected - Close Door"),
+    WSTR(L"⚠ Door opening blocked: obstacle or vehicle moving"),
+    WSTR(L"⚠ Lane Change! Please Use indicator"),
+};
+
+static const WarningString fcwSuffix = WSTR(L" m)");
+static const WarningString tyreNames[4] = { WSTR(L" T1"), WSTR(L" T2"), WSTR(L" T3"), WSTR(L" T4") };
+static const WarningString fcwTtcText = WSTR(L"⚠ Forward Collision Warning (closing too fast)");
+
+static const char* warningNames[ADAS_WARN_COUNT] = {
+    "HEADLIGHTS_OFF_NIGHT", "HEADLIGHTS_ON_DAY", "FCW",
+    "LOW_TYRE_1", "LOW_TYRE_2", "LOW_TYRE_3", "LOW_TYRE_4", "TYRE_LEAK",
+    "HANDS_OFF", "DOOR_MOVING", "DOOR_OBSTACLE", "DOOR_BLOCKED", "LANE_NO_INDICATOR",
+};
+
+// ---------------- WARNING SET ----------------
+void AdasWarningSetFromResult(AdasWarningSet* set, const AdasResult* res) {
+    set->mask = res->mask;
+    // keep the parameter only while FCW is active so equal sets compare equal
+    bool fcw = (res->mask & ADAS_WARN_BIT(ADAS_WARN_FCW)) != 0;
+    set->fcwTtc = fcw && res->fcwTtc;
+    set->fcwThresholdCm = fcw && !res->fcwTtc ? res->fcwThresholdCm : 0;
+    set->leakTyres = (res->mask & ADAS_WARN_BIT(ADAS_WARN_TYRE_LEAK)) ? res->leakTyres : 0;
+}
+
+bool AdasWarningSetEqual(const AdasWarningSet* a, const AdasWarningSet* b) {
+    return a->mask == b->mask && a->fcwThresholdCm == b->fcwThresholdCm && a->fcwTtc == b->fcwTtc
+        && a->leakTyres == b->leakTyres;
+}
+
+int AdasWarningSetCount(const AdasWarningSet* set) {
+    int n = 0;
+    for (uint32_t m = set->mask; m; m &= m - 1) n++;
+    return n;
+}
+
+// ---------------- TEXT ----------------
+const char* AdasWarningName(AdasWarningId id) {
+    if ((unsigned)id >= ADAS_WARN_COUNT) return "";
+    return warningNames[id];
+}
+
+const wchar_t* AdasWarningText(AdasWarningId id) {
+    if ((unsigned)id >= ADAS_WARN_COUNT) return L"";
+    return warningStrings[id].text;
+}
+
+// copies as much of src as fits, keeping room for the terminator
+static size_t Append(wchar_t* buf, size_t cap, size_t pos, const wchar_t* src, size_t len) {
+    if (pos + 1 >= cap) return pos;
+    if (len > cap - 1 - pos) len = cap - 1 - pos;
+    for (size_t i = 0; i < len; i++) buf[pos + i] = src[i];
+    return pos + len;
+}
+
+static size_t AppendInt(wchar_t* buf, size_t cap, size_t pos, int value) {
+    wchar_t digits[12];
+    size_t n = 0;
+    unsigned u = value < 0 ? 0u - (unsigned)value : (unsigned)value;
+    do {
+        digits[sizeof(digits) / sizeof(digits[0]) - 1 - n++] = (wchar_t)(L'0' + u % 10);
+        u /= 10;
+    } while (u);
+    if (value < 0) digits[sizeof(digits) / sizeof(digits[0]) - 1 - n++] = L'-';
+    return Append(buf, cap, pos, digits + sizeof(digits) / sizeof(digits[0]) - n, n);
+}
+
+// centimetres as metres with two decimals ("37.25")
+static size_t AppendCm(wchar_t* buf, size_t cap, size_t pos, int32_t cm) {
+    wchar_t frac[3];
+    if (cm < 0) cm = 0;
+    pos = AppendInt(buf, cap, pos, cm / ADAS_CM_PER_M);
+    frac[0] = L'.';
+    frac[1] = (wchar_t)(L'0' + cm % ADAS_CM_PER_M / 10);
+    frac[2] = (wchar_t)(L'0' + cm % 10);
+    return Append(buf, cap, pos, frac, 3);
+}
+
+static size_t AppendLine(const AdasWarningSet* set, AdasWarningId id, wchar_t* buf, size_t cap, size_t pos) {
+    if (id == ADAS_WARN_FCW && set->fcwTtc) return Append(buf, cap, pos, fcwTtcText.text, fcwTtcText.len);
+    pos = Append(buf, cap, pos, warningStrings[id].text, warningStrings[id].len);
+    if (id == ADAS_WARN_FCW) {
+        pos = AppendCm(buf, cap, pos, set->fcwThresholdCm);
+        pos = Append(buf, cap, pos, fcwSuffix.text, fcwSuffix.len);
+    }
+    if (id == ADAS_WARN_TYRE_LEAK) {
+        for (int t = 0; t < 4; ++t)
+            if (set->leakTyres & (1u << t)) pos = Append(buf, cap, pos, tyreNames[t].text, tyreNames[t].len);
+    }
+    return pos;
+}
+
+size_t AdasWarningLine(const AdasWarningSet* set, AdasWarningId id, wchar_t* buf, size_t cap) {
+    if (cap == 0) return 0;
+    size_t pos = 0;
+    if ((unsigned)id < ADAS_WARN_COUNT) pos = AppendLine(set, id, buf, cap, 0);
+    buf[pos] = L'\0';
+    return pos;
+}
+
+size_t AdasWarningsFormat(const AdasWarningSet* set, wchar_t* buf, size_t cap) {
+    if (cap == 0) return 0;
+    size_t pos = 0;
+    for (int id = 0; id < ADAS_WARN_COUNT; id++) {
+        if (!(set->mask & ADAS_WARN_BIT(id))) continue;
+        pos = AppendLine(set, (AdasWarningId)id, buf, cap, pos);
+        pos = Append(buf, cap, pos, L"\n", 1);
+    }
+    buf[pos] = L'\0';
+    return pos;
+}
@@ -0,0 +1,40 @@
+/* Title: FOP Mini Project - ADAS Level-1 Simulator
+   Description: Compact warning set (bitmask + per-warning parameters) and its MID text.
+   - Rules produce a set; text is only generated at draw time from a precomputed string table.
+   - Sets compare with a couple of integer tests, so logging/audio/tests can diff them cheaply.
+   File Owner: Rahul Krishna
+   Created: 2026-10-16
+   File: ADAS_Warnings.h
+*/
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <wchar.h>
+
+#include "ADAS_Rules.h"
+
+// longest text AdasWarningsFormat can produce (every warning active) fits in this many wchar_t
+#define ADAS_WARNINGS_TEXT_MAX 1024
+
+typedef struct AdasWarningSet {
+    uint32_t mask;          // ADAS_WARN_BIT(...) of every active warning
+    int32_t fcwThresholdCm; // ADAS_WARN_FCW parameter (cm); 0 when FCW is not active or came from TTC
+    bool fcwTtc;            // FCW raised by the TTC model (no threshold to show)
+    uint8_t leakTyres;      // ADAS_WARN_TYRE_LEAK parameter (bit i = tyre i); 0 when not active
+} AdasWarningSet;
+
+// ---------------- FUNCTION DECLARATIONS ----------------
+void AdasWarningSetFromResult(AdasWarningSet* set, const AdasResult* res);
+bool AdasWarningSetEqual(const AdasWarningSet* a, const AdasWarningSet* b);
+int AdasWarningSetCount(const AdasWarningSet* set);
+
+// short ASCII identifier for logs and traces (e.g. "FCW")
+const char* AdasWarningName(AdasWarningId id);
+// fixed MID text of a warning (no newline); FCW text is the part before its parameter
+const wchar_t* AdasWarningText(AdasWarningId id);
+// one warning line (no newline) into buf; returns its length
+size_t AdasWarningLine(const AdasWarningSet* set, AdasWarningId id, wchar_t* buf, size_t cap);
+// every active warning, one per line in display order; always NUL-terminated, returns length
+size_t AdasWarningsFormat(const AdasWarningSet* set, wchar_t* buf, size_t cap);
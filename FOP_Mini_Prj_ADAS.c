@@ -18,40 +18,94 @@
 
 #include <windows.h>
 #include <commctrl.h>
+#include <mmsystem.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
+#include "ADAS_Platform.h"
+#include "ADAS_Rules.h"
+#include "ADAS_Clock.h"
+#include "ADAS_Vehicle.h"
+#include "ADAS_Warnings.h"
+#include "ADAS_Mid.h"
+#include "ADAS_Render.h"
+#include "ADAS_Frame.h"
+#include "ADAS_GdiCache.h"
+#include "ADAS_GlyphAtlas.h"
+#include "ADAS_Probe.h"
+#include "ADAS_Audio.h"
+#include "ADAS_Synth.h"
+
 #pragma comment(lib, "comctl32.lib")
+#pragma comment(lib, "winmm.lib")
 
 // ---------------- GLOBAL STATE & Variables ----------------
-int speed = 0;
-int frontDist = 50;
-int basePressure = 32;
-int tp[4] = { 32,32,32,32 };
-
-BOOL headlights = FALSE;
-BOOL nightMode = FALSE;
-BOOL handsOn = TRUE;
-BOOL leftInd = FALSE, rightInd = FALSE;
-BOOL doorObstacle = FALSE;
-BOOL laneChangeReq = FALSE;
-
-wchar_t midWarnings[512];
-
-// door state: 0=FL,1=FR,2=RL,3=RR
-BOOL doorOpen[4] = { FALSE, FALSE, FALSE, FALSE };
-
-// blinking state for indicators
-BOOL blinkOn = FALSE;
-
-// door open attempt blocked temporary warning (ms tick)
-DWORD doorBlockWarnUntil = 0;
-
-// lane message expiry tick
-DWORD laneMsgUntil = 0;
-
-// last beep time to avoid continuous beeps
-DWORD lastBeepTime = 0;
+// vehicle state lives in AdasVehicle (ADAS_Vehicle.h); the window keeps a pointer to it
+
+// MID placement in the client area; state changes invalidate only the rows inside it that changed.
+// Layout is in 96 dpi pixels: midRect is midRect96 at the MID font's dpi (ScaleLayout)
+const RECT midRect96 = { 560, 60, 1140, 680 };
+RECT midRect = { 560, 60, 1140, 680 };
+
+// every control's client rect at 96 dpi, captured once they exist; scaling from these (not from
+// the current rects) keeps repeated DPI changes from drifting
+typedef struct ChildRect96 {
+    HWND hwnd;
+    RECT rc;
+} ChildRect96;
+#define MAX_CHILD_RECTS 64
+ChildRect96 childRects96[MAX_CHILD_RECTS];
+int childRectCount = 0;
+
+// MID line model (ADAS_Mid.h): rows of text at known rects, rebuilt for the current font
+AdasMidLayout midLayout;
+BOOL midLayoutValid = FALSE;
+uint32_t midLayoutGeneration = 0;   // midGdi.generation the metrics were taken from
+
+// the MID is composed off-screen and blitted in one operation; the buffer is created once and
+// only rebuilt when its size or the display format changes
+#define ADAS_MID_DOUBLE_BUFFER 1   // 0 draws straight to the window DC (for paint-time comparison)
+// the buffer is a top-down 32-bit DIB so atlas glyphs can be copied straight into its pixels
+HDC midDC = NULL;
+HBITMAP midBitmap = NULL;
+HGDIOBJ midOldBitmap = NULL;
+uint32_t* midBits = NULL;
+int midBufW = 0, midBufH = 0;
+
+// fonts and brushes for the MID, created once (see ADAS_GdiCache.h)
+AdasGdiCache midGdi;
+
+// measured glyphs per header row, reused until the row's text (version) or the font changes
+typedef struct MidGlyphRow {
+    uint32_t version;
+    uint32_t generation;    // midGdi.generation of the font they were measured with
+    UINT count;
+    WCHAR glyphs[ADAS_MID_ROW_CHARS];
+    int dx[ADAS_MID_ROW_CHARS];
+} MidGlyphRow;
+MidGlyphRow midGlyphs[ADAS_MID_HEADER_ROWS];
+uint64_t midGlyphMeasures = 0, midGlyphReuses = 0;
+
+// MID text from pre-drawn glyph cells (ADAS_GlyphAtlas.h); GDI text is the fallback when drawing
+// without the buffer or when a row has a character outside the atlas
+#define ADAS_MID_GLYPH_ATLAS 1
+AdasGlyphAtlas midAtlas;
+BOOL midAtlasEnabled = ADAS_MID_GLYPH_ATLAS;
+
+// MID frames: inputs mark the MID dirty, at most one frame per refresh interval ("--hz 30|60|120")
+AdasFrameScheduler midFrames;
+uint32_t midFrameHz = ADAS_FRAME_HZ_DEFAULT;
+// one-shot deadline of the trailing frame, waited on by the message loop: a high-resolution
+// waitable timer where Windows has one (10 1803+), so 120 Hz needs no raised timer resolution
+HANDLE midFrameTimer = NULL;
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+// WM_PAINT cost (QueryPerformanceCounter through AdasNowNs) and MID area painted
+uint64_t midPaints = 0, midPaintTotalNs = 0, midPaintMaxNs = 0, midPaintPixels = 0;
 
 // ---------------- CONTROL IDs ----------------
 #define ID_SPEED      101
@@ -61,6 +115,7 @@ DWORD lastBeepTime = 0;
 #define ID_TP2        106
 #define ID_TP3        107
 #define ID_TP4        108
+#define ID_LEAD       109
 
 #define ID_HEADLIGHT  201
 #define ID_DAYNIGHT   202
@@ -69,6 +124,9 @@ DWORD lastBeepTime = 0;
 #define ID_RIGHT      205
 #define ID_OBST       206
 #define ID_LANE       207
+#define ID_FCW_MODE   208
+#define ID_SURFACE    209
+#define ID_PUNCTURE   210
 
 // door buttons
 #define ID_DOOR_FL    301
@@ -76,27 +134,42 @@ DWORD lastBeepTime = 0;
 #define ID_DOOR_RL    303
 #define ID_DOOR_RR    304
 
-// timers
-#define IDT_BLINK     1001
-#define IDT_LANE      1002
+// timers: one simulation clock drives every timed behaviour (blink, lane message, door block, beep spacing)
+#define IDT_SIM       1001
+#define IDT_PROBE     1002          // folds the probe rings into the histograms, outside any frame
+#define PROBE_COLLECT_MS 250
+
+// road surface button text, by AdasSurface
+static const wchar_t* const surfaceLabels[ADAS_SURFACE_COUNT] = { L"Road: Dry", L"Road: Wet", L"Road: Snow", L"Road: Ice" };
+// puncture button text: none, then the tyre losing pressure
+static const wchar_t* const punctureLabels[5] = { L"Puncture: None", L"Puncture: T1", L"Puncture: T2", L"Puncture: T3", L"Puncture: T4" };
 
 // button sizing (consistent)
 #define BUTTON_W 140
 #define BUTTON_H 40
 
-// FCW cap (meters)
-#define MAX_COLLISION_THRESHOLD 50
-
-// vehicle physical length (m)
-#define VEHICLE_LENGTH_M 5.0
-
 // ---------------- FUNCTION DECLARATIONS ----------------
 LRESULT CALLBACK WndProc(HWND, UINT, WPARAM, LPARAM);
-void DrawMID(HDC, RECT);
-void AddWarning(const wchar_t*);
-double StoppingDistance_m(int speed_kmh);
-DWORD WINAPI BeepThreadProc(LPVOID lpParam);
-void TriggerBeepForPriority(int priority);
+void DrawMID(HDC hdc, RECT r, RECT clip);
+void UpdateMID(HWND hwnd, AdasVehicle* v);
+void RequestMIDFrame(HWND hwnd, AdasVehicle* v, BOOL input);
+void RunMIDFrame(HWND hwnd, AdasVehicle* v);
+void FlushMIDFrame(HWND hwnd, AdasVehicle* v);
+void InvalidateMID(HWND hwnd);
+BOOL CALLBACK CaptureChildRect(HWND child, LPARAM parent);
+void ScaleLayout(HWND hwnd, int dpi);
+BOOL EnsureMidLayout(HWND hwnd);
+BOOL EnsureMidBuffer(HWND hwnd);
+void ReleaseMidBuffer(void);
+BOOL EnsureMidAtlas(HDC hdc);
+void DumpMidProbes(void);
+#ifdef _DEBUG
+void CheckMidWrap(HWND hwnd);
+#endif
+void BenchMidText(HWND hwnd);
+BOOL StartBeepAudio(void);
+void StopBeepAudio(void);
+void TriggerBeepForPriority(AdasVehicle* v, int priority);
 
 // ---------------- ENTRY POINT ----------------
 int WINAPI WinMain(
@@ -108,6 +181,19 @@ int WINAPI WinMain(
     INITCOMMONCONTROLSEX ic = { sizeof(ic), ICC_BAR_CLASSES };
     InitCommonControlsEx(&ic);
 
+    // MID refresh rate: --hz 30, 60 or 120
+    const char* hzArg = lpCmd ? strstr(lpCmd, "--hz") : NULL;
+    if (hzArg) {
+        int hz = atoi(hzArg + 4);
+        if (hz == 30 || hz == 60 || hz == 120) midFrameHz = (uint32_t)hz;
+    }
+    // auto-reset; without the high-resolution flag it fires on the next system tick
+    midFrameTimer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    if (!midFrameTimer) midFrameTimer = CreateWaitableTimer(NULL, FALSE, NULL);
+
+    // --bench-text: time MID text drawing (DrawText vs GDI text vs glyph atlas) after startup
+    BOOL benchText = lpCmd && strstr(lpCmd, "--bench-text") != NULL;
+
     WNDCLASS wc = { 0 };
     wc.lpfnWndProc = WndProc;
     wc.hInstance = hInst;
@@ -116,67 +202,229 @@ int WINAPI WinMain(
 
     RegisterClass(&wc);
 
+    AdasRulesInit();
+    StartBeepAudio();
+
+    // the simulated vehicle; WndProc reaches it through GWLP_USERDATA
+    static AdasVehicle vehicle;
+    AdasVehicleInit(&vehicle);
+    // the window follows a moving lead; the static threshold stays one click away
+    AdasVehicleSetFcwMode(&vehicle, ADAS_FCW_TTC);
+
     HWND hwnd = CreateWindow(
         L"ADAS", L"ADAS Level-1 Simulator",
         WS_OVERLAPPEDWINDOW,
         100, 100, 1150, 760,
-        NULL, NULL, hInst, NULL
+        NULL, NULL, hInst, &vehicle
     );
 
     ShowWindow(hwnd, nShow);
+    if (benchText) BenchMidText(hwnd);
 
+    // messages, or the trailing MID frame's deadline
     MSG msg;
-    while (GetMessage(&msg, NULL, 0, 0)) {
-        TranslateMessage(&msg);
-        DispatchMessage(&msg);
+    BOOL running = TRUE;
+    DWORD timers = midFrameTimer ? 1 : 0;
+    while (running) {
+        DWORD woke = MsgWaitForMultipleObjects(timers, &midFrameTimer, FALSE, INFINITE, QS_ALLINPUT);
+        if (timers && woke == WAIT_OBJECT_0) {
+            FlushMIDFrame(hwnd, &vehicle);
+            continue;
+        }
+        while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE)) {
+            if (msg.message == WM_QUIT) {
+                running = FALSE;
+                break;
+            }
+            // F12 anywhere in the window (the sliders usually have focus): MID phase timings to the debugger
+            if (msg.message == WM_KEYDOWN && msg.wParam == VK_F12) DumpMidProbes();
+            TranslateMessage(&msg);
+            DispatchMessage(&msg);
+        }
     }
+    StopBeepAudio();
+    if (midFrameTimer) CloseHandle(midFrameTimer);
     return 0;
 }
 
-// ---------------- STOPPING DISTANCE ----------------
-double StoppingDistance_m(int speed_kmh) {
-    // Reaction time = 1.8s, braking distance estimate (mu ~0.7)
-    double v = speed_kmh * 1000.0 / 3600.0; // m/s
-    double reaction = 1.8; // seconds
-    double mu = 0.7;
-    double g = 9.81;
-    double reaction_distance = v * reaction;
-    double braking_distance = (v * v) / (2.0 * mu * g);
-    return reaction_distance + braking_distance;
-}
-
-// ---------------- BEEP THREAD ----------------
-DWORD WINAPI BeepThreadProc(LPVOID lpParam) {
-    int priority = (int)(intptr_t)lpParam;
-    // Patterns (non-blocking main thread). Use Beep + MessageBeep fallback for laptops.
-    if (priority >= 3) {
-        // High priority: three short high beeps; fallback to MessageBeep(MB_ICONHAND)
-        Beep(1200, 150); Sleep(100);
-        Beep(1200, 150); Sleep(100);
-        Beep(1200, 150);
-        MessageBeep(MB_ICONHAND);
-    } else if (priority == 2) {
-        // Medium: two medium beeps; fallback to MessageBeep(MB_ICONEXCLAMATION)
-        Beep(900, 200); Sleep(150);
-        Beep(900, 200);
-        MessageBeep(MB_ICONEXCLAMATION);
-    } else if (priority == 1) {
-        // Low: single low beep; fallback to MessageBeep(MB_ICONASTERISK)
-        Beep(700, 200);
-        MessageBeep(MB_ICONASTERISK);
+// ---------------- BEEP AUDIO ----------------
+// alerts are mixed from the synthesized patterns (ADAS_Synth.h) and streamed to the sound card
+// through waveOut: the mixer applies the priority rules, so a higher alert pre-empts at its first
+// sample. The UI thread only posts alerts to lock-free queues (ADAS_Audio.h); the feeder thread
+// owns the mixer and stops writing blocks while it is silent. Without a sound device, one worker
+// thread (ADAS_Audio.h) plays the same patterns with Beep and MessageBeep instead.
+#define BEEP_BLOCK_SAMPLES ADAS_SYNTH_SAMPLES(10)   // one waveOut block, 10 ms
+#define BEEP_BLOCKS 4                               // blocks in flight: at most 40 ms from alert to sound
+#define BEEP_PENDING 16                             // > ADAS_MIX_QUEUE + 1 (power of two)
+
+AdasSynth beepSynth;
+AdasMixer beepMixer;                // feeder thread only
+AdasAudioQueue beepAlerts[ADAS_PRIO_HIGH];  // UI thread to feeder, index = priority - 1
+AdasAudioStats beepStats;           // enqueued/dropped by the UI thread, latency by the feeder
+HWAVEOUT beepOut;
+HANDLE beepOutDone;                 // signalled by waveOut when a block has played, and by a new alert
+WAVEHDR beepHdr[BEEP_BLOCKS];
+int16_t beepPcm[BEEP_BLOCKS][BEEP_BLOCK_SAMPLES];
+AdasThread beepFeeder;
+volatile uint32_t beepFeederStop = 0;
+BOOL beepStreamRunning = FALSE;
+
+// enqueue times of alerts the mixer accepted but has not started yet; the mixer starts the alerts
+// of one priority in order, so its start log pairs with these
+uint64_t beepPendingNs[ADAS_PRIO_HIGH][BEEP_PENDING];
+uint32_t beepPendingHead[ADAS_PRIO_HIGH], beepPendingTail[ADAS_PRIO_HIGH];
+uint64_t beepStartsSeen = 0;
+
+AdasAudio beepAudio;
+BOOL beepAudioRunning = FALSE;
+
+// posted alerts into the mixer, highest priority first
+static void BeepTakeAlerts(void) {
+    for (int p = ADAS_PRIO_HIGH; p >= ADAS_PRIO_LOW; --p) {
+        uint64_t enqueuedNs;
+        while (AdasAudioQueuePop(&beepAlerts[p - 1], &enqueuedNs)) {
+            if (!AdasMixerAlert(&beepMixer, p)) continue;
+            beepPendingNs[p - 1][beepPendingTail[p - 1]++ & (BEEP_PENDING - 1)] = enqueuedNs;
+        }
     }
-    return 0;
 }
 
-void TriggerBeepForPriority(int priority) {
-    // avoid continuous repetition: at least 800ms between beep bursts
-    DWORD now = GetTickCount();
-    if (priority <= 0) return;
-    if (now - lastBeepTime < 800) return;
-    lastBeepTime = now;
-    // spawn thread to play beeps
-    HANDLE h = CreateThread(NULL, 0, BeepThreadProc, (LPVOID)(intptr_t)priority, 0, NULL);
-    if (h) CloseHandle(h);
+// enqueue-to-render latency of every alert that started in the block just rendered
+static void BeepStartLatency(uint64_t renderedNs) {
+    for (; beepStartsSeen < beepMixer.started; ++beepStartsSeen) {
+        int q = beepMixer.starts[beepStartsSeen % ADAS_MIX_STARTS].priority - 1;
+        if (beepPendingHead[q] == beepPendingTail[q]) continue;
+        uint64_t latency = renderedNs - beepPendingNs[q][beepPendingHead[q]++ & (BEEP_PENDING - 1)];
+        beepStats.latencyCount++;
+        beepStats.latencyTotalNs += latency;
+        if (latency > beepStats.latencyMaxNs) beepStats.latencyMaxNs = latency;
+    }
+}
+
+// refills every block the device has finished with while an alert is playing; once the mixer is
+// silent, sleeps until the next alert
+static void BeepFeed(void* arg) {
+    (void)arg;
+    while (!AdasAtomicLoad32(&beepFeederStop)) {
+        BeepTakeAlerts();
+        BOOL idle = AdasMixerIdle(&beepMixer);
+        for (int b = 0; b < BEEP_BLOCKS && !idle; ++b) {
+            if (!(beepHdr[b].dwFlags & WHDR_DONE)) continue;
+            AdasMixerRender(&beepMixer, beepPcm[b], BEEP_BLOCK_SAMPLES);
+            BeepStartLatency(AdasNowNs());
+            beepHdr[b].dwFlags &= ~WHDR_DONE;
+            waveOutWrite(beepOut, &beepHdr[b], sizeof(WAVEHDR));
+            idle = AdasMixerIdle(&beepMixer);
+        }
+        WaitForSingleObject(beepOutDone, idle ? INFINITE : 100);
+    }
+}
+
+static BOOL StartBeepStream(void) {
+    if (!AdasSynthInit(&beepSynth)) return FALSE;
+    AdasMixerInit(&beepMixer, &beepSynth);
+    for (int p = 0; p < ADAS_PRIO_HIGH; ++p) AdasAudioQueueInit(&beepAlerts[p]);
+    memset(&beepStats, 0, sizeof(beepStats));
+    memset(beepPendingHead, 0, sizeof(beepPendingHead));
+    memset(beepPendingTail, 0, sizeof(beepPendingTail));
+    beepStartsSeen = 0;
+    beepOutDone = CreateEvent(NULL, FALSE, FALSE, NULL);
+
+    WAVEFORMATEX fmt = { WAVE_FORMAT_PCM, 1, ADAS_SYNTH_RATE, ADAS_SYNTH_RATE * 2, 2, 16, 0 };
+    if (!beepOutDone || waveOutOpen(&beepOut, WAVE_MAPPER, &fmt, (DWORD_PTR)beepOutDone, 0, CALLBACK_EVENT) != MMSYSERR_NOERROR) {
+        if (beepOutDone) CloseHandle(beepOutDone);
+        AdasSynthFree(&beepSynth);
+        return FALSE;
+    }
+    for (int b = 0; b < BEEP_BLOCKS; ++b) {
+        memset(&beepHdr[b], 0, sizeof(WAVEHDR));
+        beepHdr[b].lpData = (LPSTR)beepPcm[b];
+        beepHdr[b].dwBufferLength = sizeof(beepPcm[b]);
+        waveOutPrepareHeader(beepOut, &beepHdr[b], sizeof(WAVEHDR));
+        beepHdr[b].dwFlags |= WHDR_DONE;    // free for the feeder's first pass
+    }
+    beepFeederStop = 0;
+    beepStreamRunning = AdasThreadStart(&beepFeeder, BeepFeed, NULL) == 0;
+    if (!beepStreamRunning) {
+        for (int b = 0; b < BEEP_BLOCKS; ++b) waveOutUnprepareHeader(beepOut, &beepHdr[b], sizeof(WAVEHDR));
+        waveOutClose(beepOut);
+        CloseHandle(beepOutDone);
+        AdasSynthFree(&beepSynth);
+    }
+    return beepStreamRunning;
+}
+
+static void StopBeepStream(void) {
+    AdasAtomicStore32(&beepFeederStop, 1);
+    SetEvent(beepOutDone);
+    AdasThreadJoin(&beepFeeder);
+    waveOutReset(beepOut);
+    for (int b = 0; b < BEEP_BLOCKS; ++b) waveOutUnprepareHeader(beepOut, &beepHdr[b], sizeof(WAVEHDR));
+    waveOutClose(beepOut);
+    CloseHandle(beepOutDone);
+    beepStreamRunning = FALSE;
+
+    const AdasAudioStats* st = &beepStats;
+    wchar_t stats[192];
+    wsprintf(stats, L"Beeps (mixer): %u queued, %u started, %u pre-empted, %u dropped, latency avg %u us max %u us\n",
+        (unsigned)st->enqueued, (unsigned)beepMixer.started, (unsigned)beepMixer.preempted,
+        (unsigned)(st->dropped + beepMixer.dropped),
+        (unsigned)(st->latencyCount ? st->latencyTotalNs / st->latencyCount / 1000 : 0),
+        (unsigned)(st->latencyMaxNs / 1000));
+    OutputDebugString(stats);
+    AdasSynthFree(&beepSynth);
+}
+
+static void BeepTone(void* ctx, int freq, int ms) {
+    (void)ctx;
+    Beep((DWORD)freq, (DWORD)ms);
+}
+
+// MessageBeep fallback for laptops without a beeper
+static void BeepDone(void* ctx, int priority) {
+    (void)ctx;
+    MessageBeep(priority >= ADAS_PRIO_HIGH ? MB_ICONHAND
+        : priority == ADAS_PRIO_MEDIUM ? MB_ICONEXCLAMATION : MB_ICONASTERISK);
+}
+
+BOOL StartBeepAudio(void) {
+    if (StartBeepStream()) return TRUE;
+    AdasAudioSink sink = { BeepTone, BeepDone, NULL, 1 };
+    beepAudioRunning = AdasAudioStart(&beepAudio, &sink) == 0;
+    return beepAudioRunning;
+}
+
+void StopBeepAudio(void) {
+    if (beepStreamRunning) StopBeepStream();
+    if (!beepAudioRunning) return;
+    AdasAudioStop(&beepAudio);
+    beepAudioRunning = FALSE;
+    const AdasAudioStats* st = &beepAudio.stats;
+    wchar_t stats[192];
+    wsprintf(stats, L"Beeps: %u queued, %u dropped, %u pre-empted, latency avg %u us max %u us, %u thread(s)\n",
+        (unsigned)st->enqueued, (unsigned)st->dropped, (unsigned)st->preempted,
+        (unsigned)(st->latencyCount ? st->latencyTotalNs / st->latencyCount / 1000 : 0),
+        (unsigned)(st->latencyMaxNs / 1000), st->threadsStarted);
+    OutputDebugString(stats);
+}
+
+void TriggerBeepForPriority(AdasVehicle* v, int priority) {
+    // avoid continuous repetition: 800 ms between bursts of one priority (AdasVehicleBeepDue). The
+    // cooldowns are per priority, so a lower alert's never holds back a higher one; this is the only gate
+    if (!AdasVehicleBeepDue(v, priority)) return;
+    // a higher priority pre-empts a lower burst still playing: at its first sample in the mixer, at
+    // the next step on the worker; nothing to do here if neither started
+    if (beepStreamRunning) {
+        if (priority > ADAS_PRIO_HIGH) priority = ADAS_PRIO_HIGH;
+        if (!AdasAudioQueuePush(&beepAlerts[priority - 1], AdasNowNs())) {
+            AdasAtomicAdd64(&beepStats.dropped, 1);
+            return;
+        }
+        AdasAtomicAdd64(&beepStats.enqueued, 1);
+        SetEvent(beepOutDone);
+    } else if (beepAudioRunning) {
+        AdasAudioEnqueue(&beepAudio, priority);
+    }
 }
 
 // ---------------- WINDOW PROCEDURE ----------------
@@ -186,13 +434,18 @@ LRESULT CALLBACK WndProc(
     WPARAM wParam,
     LPARAM lParam
 ) {
-    static HWND hSpeed, hFront, hBase, hTP[4];
+    static HWND hSpeed, hFront, hBase, hTP[4], hLead;
     static HWND hLeftBtn, hRightBtn;
     static HWND hDoorBtn[4];
-    static HWND hHeadlightBtn, hDayNightBtn, hHandsBtn, hLaneBtn, hObstBtn;
+    static HWND hHeadlightBtn, hDayNightBtn, hHandsBtn, hLaneBtn, hObstBtn, hFcwModeBtn, hSurfaceBtn, hPunctureBtn;
+    static AdasClock simClock;
+
+    AdasVehicle* v = (AdasVehicle*)GetWindowLongPtr(hwnd, GWLP_USERDATA);
 
     switch (msg) {
     case WM_CREATE:
+        v = (AdasVehicle*)((CREATESTRUCT*)lParam)->lpCreateParams;
+        SetWindowLongPtr(hwnd, GWLP_USERDATA, (LONG_PTR)v);
 
         // SPEED
         CreateWindow(L"STATIC", L"Speed (km/h)",
@@ -203,7 +456,7 @@ LRESULT CALLBACK WndProc(
             WS_CHILD | WS_VISIBLE | TBS_AUTOTICKS,
             20, 40, 260, 30,
             hwnd, (HMENU)ID_SPEED, NULL, NULL);
-        SendMessage(hSpeed, TBM_SETRANGE, TRUE, MAKELONG(0, 180));
+        SendMessage(hSpeed, TBM_SETRANGE, TRUE, MAKELONG(0, ADAS_SPEED_MAX));
         SendMessage(hSpeed, TBM_SETTICFREQ, 5, 0);
         SendMessage(hSpeed, TBM_SETPOS, TRUE, 0);
 
@@ -215,9 +468,12 @@ LRESULT CALLBACK WndProc(
             WS_CHILD | WS_VISIBLE | TBS_AUTOTICKS,
             20, 100, 260, 30,
             hwnd, (HMENU)ID_FRONT, NULL, NULL);
-        SendMessage(hFront, TBM_SETRANGE, TRUE, MAKELONG(0, 50));
-        SendMessage(hFront, TBM_SETTICFREQ, 5, 0);
-        SendMessage(hFront, TBM_SETPOS, TRUE, frontDist);
+        // positions are centimetres: arrow keys move 10 cm, page keys 5 m, a tick every 10 m
+        SendMessage(hFront, TBM_SETRANGE, TRUE, MAKELONG(0, ADAS_DIST_MAX_CM));
+        SendMessage(hFront, TBM_SETLINESIZE, 0, 10);
+        SendMessage(hFront, TBM_SETPAGESIZE, 0, 500);
+        SendMessage(hFront, TBM_SETTICFREQ, 1000, 0);
+        SendMessage(hFront, TBM_SETPOS, TRUE, v->frontDistCm);
 
         // TPMS
         CreateWindow(L"STATIC", L"Base Tyre Pressure (PSI)",
@@ -227,9 +483,9 @@ LRESULT CALLBACK WndProc(
             WS_CHILD | WS_VISIBLE | TBS_AUTOTICKS,
             20, 180, 260, 30,
             hwnd, (HMENU)ID_BASETP, NULL, NULL);
-        SendMessage(hBase, TBM_SETRANGE, TRUE, MAKELONG(20, 40));
+        SendMessage(hBase, TBM_SETRANGE, TRUE, MAKELONG(ADAS_PSI_MIN, ADAS_PSI_MAX));
         SendMessage(hBase, TBM_SETTICFREQ, 1, 0);
-        SendMessage(hBase, TBM_SETPOS, TRUE, basePressure);
+        SendMessage(hBase, TBM_SETPOS, TRUE, v->basePressure);
 
         for (int i = 0;i < 4;i++) {
             wchar_t lbl[20];
@@ -243,9 +499,9 @@ LRESULT CALLBACK WndProc(
                 WS_CHILD | WS_VISIBLE | TBS_AUTOTICKS,
                 20, 240 + i * 60, 260, 30,
                 hwnd, (HMENU)(ID_TP1 + i), NULL, NULL);
-            SendMessage(hTP[i], TBM_SETRANGE, TRUE, MAKELONG(20, 40));
+            SendMessage(hTP[i], TBM_SETRANGE, TRUE, MAKELONG(ADAS_PSI_MIN, ADAS_PSI_MAX));
             SendMessage(hTP[i], TBM_SETTICFREQ, 1, 0);
-            SendMessage(hTP[i], TBM_SETPOS, TRUE, tp[i]);
+            SendMessage(hTP[i], TBM_SETPOS, TRUE, v->tp[i]);
         }
 
         // BUTTONS (consistent size + border)
@@ -277,6 +533,32 @@ LRESULT CALLBACK WndProc(
             WS_CHILD | WS_VISIBLE | WS_BORDER, 320, 340, BUTTON_W, BUTTON_H,
             hwnd, (HMENU)ID_OBST, NULL, NULL);
 
+        // FCW rule and the vehicle ahead (TTC mode)
+        hFcwModeBtn = CreateWindow(L"BUTTON", v->fcwMode == ADAS_FCW_TTC ? L"FCW: TTC" : L"FCW: Threshold",
+            WS_CHILD | WS_VISIBLE | WS_BORDER, 320, 390, BUTTON_W, BUTTON_H,
+            hwnd, (HMENU)ID_FCW_MODE, NULL, NULL);
+
+        CreateWindow(L"STATIC", L"Lead Speed (km/h)",
+            WS_CHILD | WS_VISIBLE, 320, 440, 160, 20,
+            hwnd, NULL, NULL, NULL);
+        hLead = CreateWindow(TRACKBAR_CLASS, NULL,
+            WS_CHILD | WS_VISIBLE | TBS_AUTOTICKS,
+            320, 460, 220, 30,
+            hwnd, (HMENU)ID_LEAD, NULL, NULL);
+        SendMessage(hLead, TBM_SETRANGE, TRUE, MAKELONG(0, ADAS_LEAD_SPEED_MAX));
+        SendMessage(hLead, TBM_SETTICFREQ, 10, 0);
+        SendMessage(hLead, TBM_SETPOS, TRUE, v->leadSpeed);
+
+        // road surface for the FCW threshold; cycles dry -> wet -> snow -> ice
+        hSurfaceBtn = CreateWindow(L"BUTTON", surfaceLabels[v->surface],
+            WS_CHILD | WS_VISIBLE | WS_BORDER, 320, 500, BUTTON_W, BUTTON_H,
+            hwnd, (HMENU)ID_SURFACE, NULL, NULL);
+
+        // slow puncture (ADAS_PUNCTURE_PSI_MIN) for the TPMS leak detector; cycles none -> T1..T4
+        hPunctureBtn = CreateWindow(L"BUTTON", punctureLabels[0],
+            WS_CHILD | WS_VISIBLE | WS_BORDER, 320, 550, BUTTON_W, BUTTON_H,
+            hwnd, (HMENU)ID_PUNCTURE, NULL, NULL);
+
 		// Door buttons (4) — placed under tyre sliders as 2x2 grid for better UI organization
         int doorBaseX = 20;
         int doorBaseY = 240 + 4 * 60 + 10; // adjusted for TPMS layout
@@ -296,284 +578,598 @@ LRESULT CALLBACK WndProc(
             WS_CHILD | WS_VISIBLE | WS_BORDER, doorBaseX + doorGapX, doorBaseY + doorGapY, BUTTON_W, BUTTON_H,
             hwnd, (HMENU)ID_DOOR_RR, NULL, NULL);
 
-        // start blink timer for indicators
-        //SetTimer(hwnd, IDT_BLINK, 500, NULL);
+        // MID fonts/brushes are created on the first paint and kept
+        {
+            HDC screen = GetDC(hwnd);
+            AdasGdiCacheInit(&midGdi, GetDeviceCaps(screen, LOGPIXELSY));
+            ReleaseDC(hwnd, screen);
+        }
+        // controls were placed in 96 dpi pixels: scale them, the MID and the window to the font's dpi
+        EnumChildWindows(hwnd, CaptureChildRect, (LPARAM)hwnd);
+        if (midGdi.dpi != 96) {
+            const CREATESTRUCT* cs = (const CREATESTRUCT*)lParam;
+            ScaleLayout(hwnd, midGdi.dpi);
+            SetWindowPos(hwnd, NULL, 0, 0, MulDiv(cs->cx, midGdi.dpi, 96), MulDiv(cs->cy, midGdi.dpi, 96),
+                SWP_NOMOVE | SWP_NOZORDER | SWP_NOACTIVATE);
+        }
+
+        // simulation clock: the timer only paces it, the clock turns elapsed time into whole ticks
+        AdasClockInit(&simClock);
+        AdasClockDue(&simClock, AdasNowNs());
+        SetTimer(hwnd, IDT_SIM, ADAS_TICK_MS, NULL);
+        SetTimer(hwnd, IDT_PROBE, PROBE_COLLECT_MS, NULL);
+        AdasFrameInit(&midFrames, midFrameHz);
+
+        UpdateMID(hwnd, v);
 
         break;
 
     case WM_COMMAND:
         switch (LOWORD(wParam)) {
-        case ID_HEADLIGHT: headlights = !headlights; InvalidateRect(hwnd, NULL, TRUE); break;
-        case ID_DAYNIGHT: nightMode = !nightMode; InvalidateRect(hwnd, NULL, TRUE); break;
-        case ID_HANDS: handsOn = !handsOn; InvalidateRect(hwnd, NULL, TRUE); break;
+        case ID_HEADLIGHT: AdasVehicleToggleHeadlights(v); RequestMIDFrame(hwnd, v, TRUE); break;
+        case ID_DAYNIGHT: AdasVehicleToggleNightMode(v); RequestMIDFrame(hwnd, v, TRUE); break;
+        case ID_HANDS: AdasVehicleToggleHandsOn(v); RequestMIDFrame(hwnd, v, TRUE); break;
 
         case ID_LEFT:
-            leftInd = !leftInd;
-            if (leftInd) rightInd = FALSE;
-            InvalidateRect(hwnd, NULL, TRUE);
+            AdasVehicleToggleIndicator(v, ADAS_SIDE_LEFT);
+            RequestMIDFrame(hwnd, v, TRUE);
             break;
         case ID_RIGHT:
-            rightInd = !rightInd;
-            if (rightInd) leftInd = FALSE;
-            InvalidateRect(hwnd, NULL, TRUE);
+            AdasVehicleToggleIndicator(v, ADAS_SIDE_RIGHT);
+            RequestMIDFrame(hwnd, v, TRUE);
+            break;
+
+        case ID_OBST: AdasVehicleToggleDoorObstacle(v); RequestMIDFrame(hwnd, v, TRUE); break;
+
+        case ID_FCW_MODE:
+            AdasVehicleSetFcwMode(v, v->fcwMode == ADAS_FCW_TTC ? ADAS_FCW_THRESHOLD : ADAS_FCW_TTC);
+            SetWindowText(hFcwModeBtn, v->fcwMode == ADAS_FCW_TTC ? L"FCW: TTC" : L"FCW: Threshold");
+            RequestMIDFrame(hwnd, v, TRUE);
             break;
 
-        case ID_OBST: doorObstacle = !doorObstacle; InvalidateRect(hwnd, NULL, TRUE); break;
+        case ID_SURFACE:
+            AdasVehicleSetSurface(v, (AdasSurface)((v->surface + 1) % ADAS_SURFACE_COUNT));
+            SetWindowText(hSurfaceBtn, surfaceLabels[v->surface]);
+            RequestMIDFrame(hwnd, v, TRUE);
+            break;
+
+        case ID_PUNCTURE:
+            // the pressure falls on the sim clock; the leak warning follows once the sensor sees the trend
+            SetWindowText(hPunctureBtn, punctureLabels[AdasVehicleNextPuncture(v) + 1]);
+            break;
 
         case ID_LANE:
-            // ensure message stays visible at least 1 second
-            laneMsgUntil = GetTickCount() + 1000;
-            laneChangeReq = TRUE;
-            // start a short timer to drive updates while message is active
-            SetTimer(hwnd, IDT_LANE, 200, NULL);
-            InvalidateRect(hwnd, NULL, TRUE);
+            // message stays visible at least 1 second
+            AdasVehicleRequestLaneChange(v);
+            RequestMIDFrame(hwnd, v, TRUE);
             break;
 
-        // Door button clicks — block opening if obstacle present or vehicle moving
+        // Door button clicks — opening is blocked if obstacle present or vehicle moving
         case ID_DOOR_FL:
         case ID_DOOR_FR:
         case ID_DOOR_RL:
-        case ID_DOOR_RR: {
-            int doorIndex = -1;
-            if (LOWORD(wParam) == ID_DOOR_FL) doorIndex = 0;
-            if (LOWORD(wParam) == ID_DOOR_FR) doorIndex = 1;
-            if (LOWORD(wParam) == ID_DOOR_RL) doorIndex = 2;
-            if (LOWORD(wParam) == ID_DOOR_RR) doorIndex = 3;
-
-            if (doorIndex >= 0) {
-                // trying to open?
-                BOOL tryingToOpen = !doorOpen[doorIndex];
-                if (tryingToOpen && (doorObstacle || speed > 0)) {
-                    // block the open and show temporary warning
-                    doorBlockWarnUntil = GetTickCount() + 2000; // show for 2s
-                    // do NOT change doorOpen[doorIndex]
-                } else {
-                    // allowed to toggle
-                    doorOpen[doorIndex] = !doorOpen[doorIndex];
-                }
-            }
-            InvalidateRect(hwnd, NULL, TRUE);
-        } break;
+        case ID_DOOR_RR:
+            AdasVehicleToggleDoor(v, LOWORD(wParam) - ID_DOOR_FL);
+            RequestMIDFrame(hwnd, v, TRUE);
+            break;
 
         }
         break;
 
     case WM_HSCROLL: {
         HWND src = (HWND)lParam;
-        // update basic values
-        speed = SendMessage(hSpeed, TBM_GETPOS, 0, 0);
-        frontDist = SendMessage(hFront, TBM_GETPOS, 0, 0);
-
-        // if base TPMS changed -> sync all tyre sliders
-        if (src == hBase) {
-            basePressure = SendMessage(hBase, TBM_GETPOS, 0, 0);
-            // sync other tyre sliders immediately
+        // only the trackbar that moved is read
+        int pos = (int)SendMessage(src, TBM_GETPOS, 0, 0);
+        if (src == hSpeed) {
+            AdasVehicleSetSpeed(v, pos);
+        } else if (src == hFront) {
+            AdasVehicleSetFrontDistCm(v, pos);
+        } else if (src == hLead) {
+            AdasVehicleSetLeadSpeed(v, pos);
+        } else if (src == hBase) {
+            // base TPMS changed -> sync all tyre sliders immediately
+            AdasVehicleSetBasePressure(v, pos);
             for (int i = 0; i < 4; ++i) {
-                SendMessage(hTP[i], TBM_SETPOS, TRUE, basePressure);
-                tp[i] = basePressure;
+                SendMessage(hTP[i], TBM_SETPOS, TRUE, v->basePressure);
             }
         } else {
-            // otherwise read base and individual tyres
-            basePressure = SendMessage(hBase, TBM_GETPOS, 0, 0);
             for (int i = 0; i < 4; ++i) {
-                tp[i] = SendMessage(hTP[i], TBM_GETPOS, 0, 0);
+                if (src == hTP[i]) AdasVehicleSetTyrePressure(v, i, pos);
             }
         }
-        InvalidateRect(hwnd, NULL, TRUE);
+        RequestMIDFrame(hwnd, v, TRUE);
         break;
     }
 
     case WM_TIMER:
-        if (wParam == IDT_BLINK) {
-            blinkOn = !blinkOn;
-            InvalidateRect(hwnd, NULL, TRUE);
-        } else if (wParam == IDT_LANE) {
-            // expire lane message after laneMsgUntil
-            if (GetTickCount() >= laneMsgUntil) {
-                laneChangeReq = FALSE;
-                KillTimer(hwnd, IDT_LANE);
+        if (wParam == IDT_SIM) {
+            // step every tick that elapsed; update the MID once if a timer expired a warning or flipped the blink
+            uint32_t due = AdasClockDue(&simClock, AdasNowNs());
+            BOOL changed = FALSE;
+            for (uint32_t i = 0; i < due; ++i) {
+                if (AdasVehicleStep(v)) changed = TRUE;
+            }
+            if (changed) {
+                // in TTC mode the gap moves on its own; keep the slider on it
+                if (SendMessage(hFront, TBM_GETPOS, 0, 0) != v->frontDistCm)
+                    SendMessage(hFront, TBM_SETPOS, TRUE, v->frontDistCm);
+                // a punctured tyre deflates on its own; its slider follows
+                for (int t = 0; t < 4; ++t) {
+                    if (SendMessage(hTP[t], TBM_GETPOS, 0, 0) != v->tp[t])
+                        SendMessage(hTP[t], TBM_SETPOS, TRUE, v->tp[t]);
+                }
+                RequestMIDFrame(hwnd, v, FALSE);
             }
-            InvalidateRect(hwnd, NULL, TRUE);
+            // the frame timer flushes a pending frame; this covers modal loops (window drag, menus),
+            // where the message loop in WinMain does not run
+            FlushMIDFrame(hwnd, v);
+        } else if (wParam == IDT_PROBE) {
+            AdasProbeCollect();
         }
         break;
+    case WM_SIZE:
+        // the buffer follows the MID size; a minimized window keeps what it has
+        if (wParam != SIZE_MINIMIZED) EnsureMidBuffer(hwnd);
+        break;
+
+    case WM_DISPLAYCHANGE:
+        // colour depth or font smoothing may have changed: rebuild the buffer and atlas on the next paint
+        ReleaseMidBuffer();
+        AdasGlyphAtlasRelease(&midAtlas);
+        InvalidateMID(hwnd);
+        break;
+
+    case WM_DPICHANGED: {
+        // new monitor DPI in HIWORD(wParam); fonts, controls, the MID rect and its rows all follow,
+        // and the window takes the size Windows suggests for the new DPI
+        const RECT* suggested = (const RECT*)lParam;
+        AdasGdiCacheInvalidate(&midGdi, HIWORD(wParam));
+        ScaleLayout(hwnd, midGdi.dpi);
+        SetWindowPos(hwnd, NULL, suggested->left, suggested->top, suggested->right - suggested->left,
+            suggested->bottom - suggested->top, SWP_NOZORDER | SWP_NOACTIVATE);
+        UpdateMID(hwnd, v);
+        break;
+    }
+
+    case WM_SETTINGCHANGE:
+        // sent for every system setting (wallpaper, locale, work area...); only font smoothing changes
+        // how the cached MID font renders
+        if (wParam != SPI_SETFONTSMOOTHING && wParam != SPI_SETFONTSMOOTHINGTYPE
+            && wParam != SPI_SETFONTSMOOTHINGCONTRAST && wParam != SPI_SETFONTSMOOTHINGORIENTATION)
+            break;
+        // fall through
+    case WM_THEMECHANGED:
+    case WM_SYSCOLORCHANGE:
+        AdasGdiCacheInvalidate(&midGdi, 0);
+        UpdateMID(hwnd, v);
+        break;
+
+    case WM_ERASEBKGND: {
+        // erase everything except the MID, which the paint covers completely; the clip goes back
+        // afterwards, since BeginPaint hands WM_PAINT this same DC and the MID blit must not be clipped out
+        HDC hdc = (HDC)wParam;
+        RECT client;
+        GetClientRect(hwnd, &client);
+        int saved = SaveDC(hdc);
+        ExcludeClipRect(hdc, midRect.left, midRect.top, midRect.right, midRect.bottom);
+        FillRect(hdc, &client, GetSysColorBrush(COLOR_BTNFACE));
+        RestoreDC(hdc, saved);
+        return 1;
+    }
+
     case WM_PAINT: {
         PAINTSTRUCT ps;
         HDC hdc = BeginPaint(hwnd, &ps);
-
-        // increase MID size
-        RECT mid = { 560,60,1140,680 };
-        DrawMID(hdc, mid);
-
+        RECT dirty;
+        if (IntersectRect(&dirty, &ps.rcPaint, &midRect)) {
+            uint64_t t0 = AdasNowNs();
+            // draw only the invalid part of the MID, then blit just that part
+            if (ADAS_MID_DOUBLE_BUFFER && EnsureMidBuffer(hwnd)) {
+                RECT local = { 0, 0, midBufW, midBufH };
+                RECT clip = dirty;
+                OffsetRect(&clip, -midRect.left, -midRect.top);
+                DrawMID(midDC, local, clip);
+                uint64_t blit = AdasProbeStart();
+                BitBlt(hdc, dirty.left, dirty.top, dirty.right - dirty.left, dirty.bottom - dirty.top,
+                    midDC, clip.left, clip.top, SRCCOPY);
+                AdasProbeStop(ADAS_PROBE_BLIT, blit);
+            } else {
+                DrawMID(hdc, midRect, dirty);
+            }
+            uint64_t dt = AdasNowNs() - t0;
+            midPaints++;
+            midPaintPixels += (uint64_t)(dirty.right - dirty.left) * (uint64_t)(dirty.bottom - dirty.top);
+            midPaintTotalNs += dt;
+            if (dt > midPaintMaxNs) midPaintMaxNs = dt;
+#ifdef _DEBUG
+            if (midPaints % 64 == 0) {
+                wchar_t stats[256];
+                wsprintf(stats, L"MID paint: %u us avg, %u us max over %u paints; GDI objects created: %u last frame, %u frames with any\n"
+                    L"MID area: %u px painted per paint, %u rows changed and %u%% of the MID invalidated per update; header rows measured %u, reused %u\n",
+                    (unsigned)(midPaintTotalNs / midPaints / 1000), (unsigned)(midPaintMaxNs / 1000),
+                    (unsigned)midPaints, midGdi.frameCreations, (unsigned)midGdi.framesWithCreations,
+                    (unsigned)(midPaintPixels / midPaints),
+                    (unsigned)(midLayout.stats.updates ? midLayout.stats.rowsChanged / midLayout.stats.updates : 0),
+                    (unsigned)(midLayout.stats.fullPixels ? midLayout.stats.dirtyPixels * 100 / midLayout.stats.fullPixels : 0),
+                    (unsigned)midGlyphMeasures, (unsigned)midGlyphReuses);
+                OutputDebugString(stats);
+            }
+#endif
+        }
         EndPaint(hwnd, &ps);
         break;
     }
 
     case WM_DESTROY:
-        KillTimer(hwnd, IDT_BLINK);
-        KillTimer(hwnd, IDT_LANE);
+        KillTimer(hwnd, IDT_SIM);
+        KillTimer(hwnd, IDT_PROBE);
+        ReleaseMidBuffer();
+        AdasGlyphAtlasRelease(&midAtlas);
+        AdasGdiCacheRelease(&midGdi);
+        DumpMidProbes();
         PostQuitMessage(0);
         break;
     }
     return DefWindowProc(hwnd, msg, wParam, lParam);
 }
 
-// ---------------- WARNING HANDLER ----------------
-void AddWarning(const wchar_t* w) {
-    wcscat_s(midWarnings, 512, w);
+// ---------------- DPI LAYOUT ----------------
+BOOL CALLBACK CaptureChildRect(HWND child, LPARAM parent) {
+    if (childRectCount >= MAX_CHILD_RECTS) return FALSE;
+    RECT rc;
+    GetWindowRect(child, &rc);
+    MapWindowPoints(NULL, (HWND)parent, (POINT*)&rc, 2);
+    childRects96[childRectCount].hwnd = child;
+    childRects96[childRectCount].rc = rc;
+    childRectCount++;
+    return TRUE;
 }
 
-// ---------------- MID DRAW ----------------
-void DrawMID(HDC hdc, RECT r) {
-    midWarnings[0] = L'\0';
-
-    int highestPriority = 0; // 0 none, 1 low, 2 medium, 3 high
-
-    // HEADLIGHT warnings: use the day/night switch (nightMode) rather than local time
-    if (nightMode && !headlights) {
-        AddWarning(L"⚠ Headlights OFF (night)\n");
-        if (highestPriority < 2) highestPriority = 2;
-    } else if (!nightMode && headlights) {
-        AddWarning(L"⚠ Headlights ON (day)\n");
-        if (highestPriority < 1) highestPriority = 1;
+// places the MID and every control for dpi, so the MID font (scaled the same way) fits its rows
+void ScaleLayout(HWND hwnd, int dpi) {
+    SetRect(&midRect, MulDiv(midRect96.left, dpi, 96), MulDiv(midRect96.top, dpi, 96),
+        MulDiv(midRect96.right, dpi, 96), MulDiv(midRect96.bottom, dpi, 96));
+    HDWP batch = BeginDeferWindowPos(childRectCount);
+    for (int i = 0; i < childRectCount && batch; ++i) {
+        const RECT* rc = &childRects96[i].rc;
+        int x = MulDiv(rc->left, dpi, 96), y = MulDiv(rc->top, dpi, 96);
+        batch = DeferWindowPos(batch, childRects96[i].hwnd, NULL, x, y,
+            MulDiv(rc->right, dpi, 96) - x, MulDiv(rc->bottom, dpi, 96) - y, SWP_NOZORDER | SWP_NOACTIVATE);
     }
+    if (batch) EndDeferWindowPos(batch);
+    midLayoutValid = FALSE;
+    InvalidateRect(hwnd, NULL, TRUE);
+}
 
-    // FCW adaptive threshold based on current speed (reaction 2.5s) + vehicle length
-    double stopping = StoppingDistance_m(speed);
-    double threshold_d = stopping + VEHICLE_LENGTH_M; // include vehicle length
-    int adaptiveThreshold = (int)ceil(threshold_d + 0.5); // round up with small margin
-    if (adaptiveThreshold > MAX_COLLISION_THRESHOLD)
-        adaptiveThreshold = MAX_COLLISION_THRESHOLD;
-
-    // Forward Collision Warning (adaptive) — high priority
-    if (frontDist < adaptiveThreshold) {
-        wchar_t tmp[128];
-        wsprintf(tmp, L"⚠ Forward Collision Warning (threshold %d m)\n", adaptiveThreshold);
-        AddWarning(tmp);
-        highestPriority = 3;
-    }
+// ---------------- MID UPDATE ----------------
+void InvalidateMID(HWND hwnd) {
+    // MID only, no erase: the paint fills every MID pixel, and child controls repaint themselves
+    InvalidateRect(hwnd, &midRect, FALSE);
+}
+
+// takes the row metrics from the cached font; returns TRUE when the layout was (re)built
+BOOL EnsureMidLayout(HWND hwnd) {
+    if (midLayoutValid && midLayoutGeneration == midGdi.generation) return FALSE;
+    HDC hdc = GetDC(hwnd);
+    HGDIOBJ oldFont = SelectObject(hdc, AdasGdiFont(&midGdi, ADAS_FONT_MID));
+    TEXTMETRIC tm;
+    GetTextMetrics(hdc, &tm);
+    SelectObject(hdc, oldFont);
+    ReleaseDC(hwnd, hdc);
+
+    AdasMidLayoutInit(&midLayout, midRect.right - midRect.left, midRect.bottom - midRect.top,
+        tm.tmHeight, tm.tmAveCharWidth);
+    midLayoutValid = TRUE;
+    midLayoutGeneration = midGdi.generation;
+#ifdef _DEBUG
+    CheckMidWrap(hwnd);
+#endif
+    return TRUE;
+}
 
-    // Tyre and other medium/low warnings
-    for (int i = 0;i < 4;i++) {
-        if (tp[i] < basePressure - 4) {
-            AddWarning(L"⚠ Low Tyre Pressure\n");
-            if (highestPriority < 2) highestPriority = 2;
+#ifdef _DEBUG
+// the MID wraps warnings by arithmetic; DrawText(DT_WORDBREAK) at the warnings width must agree
+void CheckMidWrap(HWND hwnd) {
+    HDC hdc = GetDC(hwnd);
+    HGDIOBJ oldFont = SelectObject(hdc, AdasGdiFont(&midGdi, ADAS_FONT_MID));
+    AdasWarningSet set = { ADAS_WARN_BIT(ADAS_WARN_COUNT) - 1, MAX_COLLISION_THRESHOLD_CM, false, 0xF };
+    for (int id = 0; id < ADAS_WARN_COUNT; ++id) {
+        wchar_t line[128];
+        int len = (int)AdasWarningLine(&set, (AdasWarningId)id, line, 128);
+        int starts[ADAS_MID_MAX_ROWS], lens[ADAS_MID_MAX_ROWS];
+        int lines = AdasMidWrapLines(&midLayout, line, len, starts, lens, ADAS_MID_MAX_ROWS);
+        RECT rc = { 0, 0, AdasMidWrapColumns(&midLayout) * midLayout.charWidth, 0 };
+        DrawText(hdc, line, len, &rc, DT_LEFT | DT_TOP | DT_WORDBREAK | DT_CALCRECT);
+        if (rc.bottom != lines * midLayout.lineHeight) {
+            wchar_t msg[192];
+            wsprintf(msg, L"MID wrap: warning %d takes %d rows, DrawText %d\n",
+                id, lines, (int)(rc.bottom / midLayout.lineHeight));
+            OutputDebugString(msg);
         }
     }
+    SelectObject(hdc, oldFont);
+    ReleaseDC(hwnd, hdc);
+}
+#endif
+
+// runs the rules for the current state, beeps, and invalidates only the MID rows that changed
+void UpdateMID(HWND hwnd, AdasVehicle* v) {
+    // new font metrics move every row: repaint the whole MID once
+    if (EnsureMidLayout(hwnd)) InvalidateMID(hwnd);
+
+    // shared rule engine; only rules whose inputs changed since the last update re-run
+    AdasResult res;
+    uint64_t probe = AdasProbeStart();
+    AdasVehicleEvaluateIncremental(v, &res);
+    AdasProbeStop(ADAS_PROBE_RULES, probe);
+#ifdef _DEBUG
+    {
+        wchar_t stats[96];
+        wsprintf(stats, L"MID rules: %u evaluated, %u reused\n",
+            v->eval.frameEvaluated, v->eval.frameSkipped);
+        OutputDebugString(stats);
+    }
+#endif
 
-    if (!handsOn) {
-        AddWarning(L"⚠ Hands Off Steering\n");
-        if (highestPriority < 2) highestPriority = 2;
+    // If there is a warning, trigger an audible beep pattern based on the highest priority; the
+    // clock's own repaints (tyre pressure, TTC readout, blink) beep only for a new warning set
+    if (res.priority > 0 && (midFrames.frameInputs || AdasMidWarningsChanged(&midLayout, &res))) {
+        TriggerBeepForPriority(v, res.priority);
     }
 
-    // door-related warnings
-    BOOL anyDoorOpen = FALSE;
-    for (int i = 0; i < 4; ++i) if (doorOpen[i]) anyDoorOpen = TRUE;
+    AdasMidRect dirty[8];
+    int count = AdasMidLayoutUpdate(&midLayout, v, &res, dirty, 8);
+    for (int i = 0; i < count; ++i) {
+        RECT rc = { dirty[i].left, dirty[i].top, dirty[i].right, dirty[i].bottom };
+        OffsetRect(&rc, midRect.left, midRect.top);
+        InvalidateRect(hwnd, &rc, FALSE);
+    }
+}
 
-    if (anyDoorOpen) {
-        if (speed > 0) {
-            AddWarning(L"⚠ Door Open While Moving\n");
-            if (highestPriority < 3) highestPriority = 3;
-        }
-        if (doorObstacle) {
-            AddWarning(L"⚠ Exit Warning: Obstacle Detected - Close Door\n");
-            if (highestPriority < 3) highestPriority = 3;
+// ---------------- MID FRAMES ----------------
+// marks the MID dirty; the frame runs now if the refresh interval allows, else at its deadline
+void RequestMIDFrame(HWND hwnd, AdasVehicle* v, BOOL input) {
+    AdasFrameRequest(&midFrames, input != FALSE);
+    FlushMIDFrame(hwnd, v);
+}
+
+// runs a pending frame whose interval has ended, else arms the one-shot timer for its deadline
+void FlushMIDFrame(HWND hwnd, AdasVehicle* v) {
+    uint64_t waitNs;
+    if (AdasFrameDue(&midFrames, AdasNowNs(), &waitNs)) {
+        RunMIDFrame(hwnd, v);
+    } else if (waitNs != UINT64_MAX && midFrameTimer) {
+        LARGE_INTEGER due;
+        due.QuadPart = -(LONGLONG)((waitNs + 99) / 100);   // relative, in 100 ns units
+        SetWaitableTimer(midFrameTimer, &due, 0, NULL, NULL, FALSE);
+    }
+}
+
+// one MID frame: rules, row diff and the paint itself, timed together
+void RunMIDFrame(HWND hwnd, AdasVehicle* v) {
+    uint64_t t0 = AdasNowNs();
+    UpdateMID(hwnd, v);
+    UpdateWindow(hwnd);
+    uint64_t t1 = AdasNowNs();
+    AdasProbeRecord(ADAS_PROBE_FRAME, t1 - t0);
+    AdasFrameDone(&midFrames, t0, t1);
+#ifdef _DEBUG
+    if (midFrames.frames % 120 == 0) {
+        wchar_t stats[192];
+        wsprintf(stats, L"MID frames @%u Hz: %u frames, %u inputs (max %u per frame); frame time p50 %u us, p95 %u us, p99 %u us, max %u us\n",
+            midFrames.hz, (unsigned)midFrames.frames, (unsigned)midFrames.inputs, midFrames.maxInputsPerFrame,
+            (unsigned)(AdasFramePercentile(&midFrames, 50) / 1000), (unsigned)(AdasFramePercentile(&midFrames, 95) / 1000),
+            (unsigned)(AdasFramePercentile(&midFrames, 99) / 1000), (unsigned)(AdasFramePercentile(&midFrames, 100) / 1000));
+        OutputDebugString(stats);
+    }
+#endif
+}
+
+// ---------------- MID BUFFER ----------------
+
+BOOL EnsureMidBuffer(HWND hwnd) {
+    int w = midRect.right - midRect.left;
+    int h = midRect.bottom - midRect.top;
+    if (midDC && midBufW == w && midBufH == h) return TRUE;
+
+    ReleaseMidBuffer();
+    BITMAPINFO bi = { 0 };
+    bi.bmiHeader.biSize = sizeof(bi.bmiHeader);
+    bi.bmiHeader.biWidth = w;
+    bi.bmiHeader.biHeight = -h;     // top-down
+    bi.bmiHeader.biPlanes = 1;
+    bi.bmiHeader.biBitCount = 32;
+    bi.bmiHeader.biCompression = BI_RGB;
+    void* bits = NULL;
+    HDC wnd = GetDC(hwnd);
+    midDC = CreateCompatibleDC(wnd);
+    midBitmap = CreateDIBSection(wnd, &bi, DIB_RGB_COLORS, &bits, NULL, 0);
+    ReleaseDC(hwnd, wnd);
+    if (!midDC || !midBitmap || !bits) {
+        ReleaseMidBuffer();
+        return FALSE;
+    }
+    midOldBitmap = SelectObject(midDC, midBitmap);
+    midBits = (uint32_t*)bits;
+    midBufW = w;
+    midBufH = h;
+    return TRUE;
+}
+
+void ReleaseMidBuffer(void) {
+    if (midDC && midOldBitmap) SelectObject(midDC, midOldBitmap);
+    if (midBitmap) DeleteObject(midBitmap);
+    if (midDC) DeleteDC(midDC);
+    midDC = NULL;
+    midBitmap = NULL;
+    midOldBitmap = NULL;
+    midBits = NULL;
+    midBufW = midBufH = 0;
+}
+
+// ---------------- MID DRAW ----------------
+// GDI backend of the MID renderer (ADAS_Render.h): MID-local rects are offset by the MID origin in hdc
+typedef struct GdiMidTarget {
+    HDC hdc;
+    int x, y;
+    HGDIOBJ oldFont;
+    uint32_t* bits;     // pixels of hdc's bitmap when it is the MID buffer: clear and atlas text write them directly
+    int pitch;
+} GdiMidTarget;
+
+static RECT GdiMidRect(const GdiMidTarget* t, AdasMidRect r) {
+    RECT rc = { t->x + r.left, t->y + r.top, t->x + r.right, t->y + r.bottom };
+    return rc;
+}
+
+static void GdiMidBegin(void* target, const AdasMidLayout* m, AdasMidRect clip) {
+    GdiMidTarget* t = (GdiMidTarget*)target;
+    (void)m; (void)clip;
+    // header in green, warnings in orange-red (cached GDI objects, nothing created per frame)
+    AdasGdiBeginFrame(&midGdi);
+    // GDI may still be writing the buffer from the last frame
+    if (t->bits) GdiFlush();
+    SetBkMode(t->hdc, TRANSPARENT);
+    // the DC gets its original font back at the end, so the cache can drop ours at any time
+    t->oldFont = SelectObject(t->hdc, AdasGdiFont(&midGdi, ADAS_FONT_MID));
+}
+
+static void GdiMidClear(void* target, AdasMidRect rect) {
+    GdiMidTarget* t = (GdiMidTarget*)target;
+    RECT rc = GdiMidRect(t, rect);
+    if (t->bits) {
+        for (int y = rc.top; y < rc.bottom; ++y) {
+            uint32_t* p = t->bits + (size_t)y * (size_t)t->pitch;
+            for (int x = rc.left; x < rc.right; ++x) p[x] = ADAS_MID_RGB_BG;
         }
+        return;
     }
+    FillRect(t->hdc, &rc, AdasGdiBrush(&midGdi, ADAS_BRUSH_MID_BG));
+}
 
-    // door open attempts blocked -> show temporary warning
-    if (doorBlockWarnUntil > GetTickCount()) {
-        AddWarning(L"⚠ Door opening blocked: obstacle or vehicle moving\n");
-        if (highestPriority < 2) highestPriority = 2;
+static void GdiMidText(void* target, const AdasMidLayout* m, int i, AdasMidRect clipped) {
+    GdiMidTarget* t = (GdiMidTarget*)target;
+    HDC hdc = t->hdc;
+    const AdasMidRow* row = &m->rows[i];
+    RECT part = GdiMidRect(t, clipped);
+
+    // fixed pitch (the warning sign takes its own advance), copied from the atlas
+    if (t->bits && midAtlas.valid) {
+        if (AdasGlyphAtlasCovers(row->text, row->len)) {
+            AdasMidRect dst = { part.left, part.top, part.right, part.bottom };
+            AdasGlyphAtlasDraw(&midAtlas, t->bits, t->pitch, t->x + row->x, t->y + row->y,
+                row->text, row->len, row->color, dst);
+            return;
+        }
+        midAtlas.fallbackRows++;
     }
 
-    // lane change: only show warning when unsafe (do not display safe-to-change)
-    if (laneChangeReq) {
-        if (!(leftInd || rightInd)) {
-            AddWarning(L"⚠ Lane Change! Please Use indicator\n");
-            if (highestPriority < 1) highestPriority = 1;
+    SetTextColor(hdc, row->color == ADAS_MID_COLOR_HEADER ? ADAS_COLOR_HEADER : ADAS_COLOR_WARNING);
+    // clipped so a row cut by the paint rect is not drawn twice over its old pixels
+    if (i < ADAS_MID_HEADER_ROWS) {
+        // header rows are plain ASCII: shape them once per text change, then draw glyph indices
+        MidGlyphRow* g = &midGlyphs[i];
+        if (g->version != row->version || g->generation != midGdi.generation) {
+            GCP_RESULTS gcp = { sizeof(gcp) };
+            gcp.lpGlyphs = g->glyphs;
+            gcp.lpDx = g->dx;
+            gcp.nGlyphs = ADAS_MID_ROW_CHARS;
+            g->count = GetCharacterPlacement(hdc, row->text, row->len, 0, &gcp, 0) ? gcp.nGlyphs : 0;
+            g->version = row->version;
+            g->generation = midGdi.generation;
+            midGlyphMeasures++;
+        } else {
+            midGlyphReuses++;
+        }
+        if (g->count) {
+            ExtTextOut(hdc, t->x + row->x, t->y + row->y, ETO_CLIPPED | ETO_GLYPH_INDEX, &part,
+                g->glyphs, g->count, g->dx);
+            return;
         }
     }
+    // warning rows may need font fallback (the warning sign), so they go through the text path
+    ExtTextOut(hdc, t->x + row->x, t->y + row->y, ETO_CLIPPED, &part, row->text, (UINT)row->len, NULL);
+}
+
+static void GdiMidEnd(void* target) {
+    GdiMidTarget* t = (GdiMidTarget*)target;
+    SelectObject(t->hdc, t->oldFont);
+    AdasGdiEndFrame(&midGdi);
+}
+
+static const AdasRenderOps gdiMidOps = { "gdi", GdiMidBegin, GdiMidClear, GdiMidText, GdiMidEnd };
 
-    // If there is a warning, trigger an audible beep pattern based on highestPriority
-    if (highestPriority > 0) {
-        TriggerBeepForPriority(highestPriority);
+// draws the rows of midLayout that intersect clip; r is the MID rect in hdc coordinates
+void DrawMID(HDC hdc, RECT r, RECT clip) {
+    GdiMidTarget target = { hdc, r.left, r.top, NULL, NULL, 0 };
+    if (hdc == midDC && midBits && midAtlasEnabled && EnsureMidAtlas(hdc)) {
+        target.bits = midBits;
+        target.pitch = midBufW;
     }
+    AdasRenderer renderer = { &gdiMidOps, &target };
+    AdasMidRect local = { clip.left - r.left, clip.top - r.top, clip.right - r.left, clip.bottom - r.top };
+    AdasMidRender(&midLayout, &renderer, local);
+}
 
-    // Draw MID: header in green, warnings in orange-red
-    HBRUSH bg = CreateSolidBrush(RGB(10, 10, 10));
-    FillRect(hdc, &r, bg);
-    DeleteObject(bg);
-
-    SetBkMode(hdc, TRANSPARENT);
-
-    HFONT f = CreateFont(20, 0, 0, 0, FW_BOLD, 0, 0, 0, 0, 0, 0, 0, 0, L"Consolas");
-    SelectObject(hdc, f);
-
-    // header (everything except midWarnings)
-    wchar_t doorState[256];
-    wsprintf(doorState,
-        L"Doors: FL:%s FR:%s RL:%s RR:%s\nIndicators: %s %s\n\n",
-        doorOpen[0] ? L"OPEN" : L"CLOSED",
-        doorOpen[1] ? L"OPEN" : L"CLOSED",
-        doorOpen[2] ? L"OPEN" : L"CLOSED",
-        doorOpen[3] ? L"OPEN" : L"CLOSED",
-        leftInd ? L"LEFT" : L"-",
-        rightInd ? L"RIGHT" : L"-"
-    );
+// ---------------- MID GLYPH ATLAS ----------------
+// (re)draws the atlas when the font or the row metrics changed
+BOOL EnsureMidAtlas(HDC hdc) {
+    if (midAtlas.valid && midAtlas.generation == midGdi.generation
+        && midAtlas.cellW == midLayout.charWidth && midAtlas.cellH == midLayout.lineHeight) {
+        return TRUE;
+    }
+    return AdasGlyphAtlasBuild(&midAtlas, hdc, AdasGdiFont(&midGdi, ADAS_FONT_MID),
+        midLayout.charWidth, midLayout.lineHeight, midGdi.generation);
+}
 
-    wchar_t header[1536];
-    wsprintf(header,
-        L"           RK\n"
-        L"----------------------------------------\n\n"
-        L"Speed: %d km/h\n"
-        L"Front: %d m\n\n"
-        L"TPMS Base: %d PSI\n"
-        L"T1:%d  T2:%d  T3:%d  T4:%d\n\n"
-        L"Headlights: %s | Mode: %s\n"
-        L"Hands On Steering: %s\n\n"
-        L"FCW Threshold: %d m (capped at %d m)\n\n"
-        L"Obstacles near Door: %s\n"
-        L"%s",
-        speed, frontDist,
-        basePressure, tp[0], tp[1], tp[2], tp[3],
-        headlights ? L"ON" : L"OFF",
-        nightMode ? L"NIGHT" : L"DAY",
-        handsOn ? L"YES" : L"NO",
-        adaptiveThreshold, MAX_COLLISION_THRESHOLD,
-        doorObstacle ? L"ON" : L"OFF",
-        doorState
-    );
+// full-MID text cost, three ways, over the current layout: DrawText with word breaks per row
+// (how the MID used to draw), GDI text (glyph-index header rows, ExtTextOut warnings), glyph atlas
+void BenchMidText(HWND hwnd) {
+    const int frames = 500;
+    AdasVehicle* v = (AdasVehicle*)GetWindowLongPtr(hwnd, GWLP_USERDATA);
+    UpdateMID(hwnd, v);
+    if (!EnsureMidBuffer(hwnd)) return;
+    RECT local = { 0, 0, midBufW, midBufH };
+    uint64_t ns[3];
+
+    uint64_t t0 = AdasNowNs();
+    for (int f = 0; f < frames; ++f) {
+        FillRect(midDC, &local, AdasGdiBrush(&midGdi, ADAS_BRUSH_MID_BG));
+        SetBkMode(midDC, TRANSPARENT);
+        HGDIOBJ oldFont = SelectObject(midDC, AdasGdiFont(&midGdi, ADAS_FONT_MID));
+        for (int i = 0; i < midLayout.rowCount; ++i) {
+            const AdasMidRow* row = &midLayout.rows[i];
+            AdasMidRect mr = AdasMidRowRect(&midLayout, i);
+            RECT rc = { row->x, mr.top, mr.right - row->x, mr.bottom };
+            SetTextColor(midDC, row->color == ADAS_MID_COLOR_HEADER ? ADAS_COLOR_HEADER : ADAS_COLOR_WARNING);
+            DrawText(midDC, row->text, row->len, &rc, DT_LEFT | DT_TOP | DT_WORDBREAK);
+        }
+        SelectObject(midDC, oldFont);
+    }
+    GdiFlush();
+    ns[0] = AdasNowNs() - t0;
+
+    for (int pass = 1; pass < 3; ++pass) {
+        midAtlasEnabled = pass == 2;
+        t0 = AdasNowNs();
+        for (int f = 0; f < frames; ++f) DrawMID(midDC, local, local);
+        GdiFlush();
+        ns[pass] = AdasNowNs() - t0;
+    }
+    midAtlasEnabled = ADAS_MID_GLYPH_ATLAS;
+    InvalidateMID(hwnd);
+
+    wchar_t report[256];
+    wsprintf(report, L"Full MID, %d rows, %d frames:\nDrawText: %u us per frame\nGDI text: %u us per frame\nGlyph atlas: %u us per frame (%u%% of DrawText)",
+        midLayout.rowCount, frames, (unsigned)(ns[0] / frames / 1000), (unsigned)(ns[1] / frames / 1000),
+        (unsigned)(ns[2] / frames / 1000), (unsigned)(ns[0] ? ns[2] * 100 / ns[0] : 0));
+    OutputDebugString(report);
+    MessageBox(hwnd, report, L"MID text benchmark", MB_OK);
+}
 
-    // Calculate header size
-    RECT calcHdr = r;
-    DrawText(hdc, header, -1, &calcHdr, DT_LEFT | DT_TOP | DT_WORDBREAK | DT_CALCRECT);
-    int headerHeight = calcHdr.bottom - calcHdr.top;
-    if (headerHeight < 20) headerHeight = 20;
-
-    // Draw header in green using the calculated height
-    SetTextColor(hdc, RGB(0, 255, 0));
-    RECT drawHdr = r;
-    drawHdr.bottom = drawHdr.top + headerHeight;
-    DrawText(hdc, header, -1, &drawHdr, DT_LEFT | DT_TOP | DT_WORDBREAK);
-
-    // now draw warnings below header in orange-red
-    RECT warnRect;
-    warnRect.left = r.left + 4;
-    warnRect.right = r.right - 4;
-    warnRect.top = drawHdr.bottom + 8; // small gap
-    warnRect.bottom = r.bottom - 8;
-
-    SetTextColor(hdc, RGB(255, 80, 0)); // orange-red for warnings
-
-    // Draw WARNINGS header (measure then draw)
-    RECT warnHeaderCalc = warnRect;
-    DrawText(hdc, L"--- WARNINGS ---\n", -1, &warnHeaderCalc, DT_LEFT | DT_TOP | DT_CALCRECT);
-    DrawText(hdc, L"--- WARNINGS ---\n", -1, &warnRect, DT_LEFT | DT_TOP);
-    // advance top by calculated size of the WARNINGS header
-    warnRect.top += (warnHeaderCalc.bottom - warnHeaderCalc.top);
-
-    // draw the collected midWarnings (wordwrap as some warning are execeding the limit of mid)
-    DrawText(hdc, midWarnings, -1, &warnRect, DT_LEFT | DT_TOP | DT_WORDBREAK);
-
-    DeleteObject(f);
-}
\ No newline at end of file
+// ---------------- MID PROBES ----------------
+// per-phase frame timings (ADAS_Probe) to the debugger: F12 and on exit
+void DumpMidProbes(void) {
+    char report[1024];
+    if (AdasProbeReport(report, sizeof report) > 0) OutputDebugStringA(report);
+}